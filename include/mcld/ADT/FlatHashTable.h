@@ -0,0 +1,227 @@
+//===- FlatHashTable.h ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_ADT_FLATHASHTABLE_H_
+#define MCLD_ADT_FLATHASHTABLE_H_
+
+#include "mcld/ADT/HashEntryFactory.h"
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/Support/DataTypes.h>
+#include <llvm/Support/MathExtras.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mcld {
+
+/** \class FlatHashTable
+ *  \brief FlatHashTable is an open addressing hash table with a flat layout.
+ *
+ *  The buckets are split into groups of 16. Every bucket has one control byte
+ *  which is either empty or holds the top 7 bits of the hash value of its
+ *  entry. A lookup loads the 16 control bytes of a group at once (with SSE2 if
+ *  the host has it) and only compares the entries whose control byte matches,
+ *  so most of the mismatches never touch the entries themselves. The full
+ *  hash value is kept next to the entry pointer to filter the rest.
+ *
+ *  Groups are probed quadratically. The number of groups is always a power of
+ *  two, so the probe sequence visits every group.
+ *
+ *  Like mcld::HashTable, entries are created by the EntryFactoryTy and the
+ *  table only keeps the pointers. Entries can not be erased.
+ */
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy = HashEntryFactory<HashEntryTy> >
+class FlatHashTable {
+ public:
+  typedef size_t size_type;
+  typedef HashFunctionTy hasher;
+  typedef HashEntryTy entry_type;
+  typedef typename HashEntryTy::key_type key_type;
+
+  enum { GroupSize = 16 };
+
+  struct Slot {
+    uint32_t FullHashValue;
+    entry_type* Entry;
+  };
+
+  /** \class IteratorBase
+   *  \brief IteratorBase traverses the occupied buckets in bucket order.
+   */
+  template <typename TableTy, typename ValueTy>
+  class IteratorBase {
+   public:
+    IteratorBase() : m_pTable(NULL), m_Index(0) {}
+
+    IteratorBase(TableTy* pTable, size_type pIndex)
+        : m_pTable(pTable), m_Index(pIndex) {
+      skipEmpty();
+    }
+
+    // const_iterator can be built from iterator.
+    template <typename OtherTableTy, typename OtherValueTy>
+    IteratorBase(const IteratorBase<OtherTableTy, OtherValueTy>& pCopy)
+        : m_pTable(pCopy.m_pTable), m_Index(pCopy.m_Index) {}
+
+    ValueTy* getEntry() const {
+      if (m_pTable == NULL || m_Index == m_pTable->m_NumOfBuckets)
+        return NULL;
+      return m_pTable->m_Slots[m_Index].Entry;
+    }
+
+    ValueTy& operator*() const { return *getEntry(); }
+
+    ValueTy* operator->() const { return getEntry(); }
+
+    IteratorBase& operator++() {
+      ++m_Index;
+      skipEmpty();
+      return *this;
+    }
+
+    IteratorBase operator++(int) {
+      IteratorBase tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    template <typename OtherTableTy, typename OtherValueTy>
+    bool operator==(const IteratorBase<OtherTableTy, OtherValueTy>& pX) const {
+      return (getEntry() == pX.getEntry());
+    }
+
+    template <typename OtherTableTy, typename OtherValueTy>
+    bool operator!=(const IteratorBase<OtherTableTy, OtherValueTy>& pX) const {
+      return !(*this == pX);
+    }
+
+   private:
+    void skipEmpty() {
+      if (m_pTable == NULL)
+        return;
+      while (m_Index < m_pTable->m_NumOfBuckets &&
+             m_pTable->m_Control[m_Index] == EmptyControl)
+        ++m_Index;
+    }
+
+   private:
+    template <typename, typename>
+    friend class IteratorBase;
+
+    TableTy* m_pTable;
+    size_type m_Index;
+  };
+
+  typedef IteratorBase<FlatHashTable, entry_type> iterator;
+  typedef IteratorBase<const FlatHashTable, entry_type> const_iterator;
+
+ public:
+  // -----  constructor  ----- //
+  explicit FlatHashTable(size_type pSize = 3);
+  ~FlatHashTable();
+
+  EntryFactoryTy& getEntryFactory() { return m_EntryFactory; }
+
+  hasher& hash() { return m_Hasher; }
+
+  // -----  modifiers  ----- //
+  void clear();
+
+  /// insert - insert a new element to the container. If the element already
+  /// exists, return the element and set pExist true.
+  entry_type* insert(const key_type& pKey, bool& pExist);
+
+  /// insert - the same as above, with pHashValue = hash()(pKey) computed by
+  /// the caller.
+  entry_type* insert(const key_type& pKey, uint32_t pHashValue, bool& pExist);
+
+  // -----  lookups  ----- //
+  /// find - finds an element with key pKey
+  /// If the element does not exist, return end()
+  iterator find(const key_type& pKey);
+  const_iterator find(const key_type& pKey) const;
+
+  /// find - the same as above, with pHashValue = hash()(pKey) computed by the
+  /// caller.
+  iterator find(const key_type& pKey, uint32_t pHashValue);
+  const_iterator find(const key_type& pKey, uint32_t pHashValue) const;
+
+  size_type count(const key_type& pKey) const;
+
+  // -----  observers  ----- //
+  bool empty() const { return (0 == m_NumOfEntries); }
+
+  size_type numOfBuckets() const { return m_NumOfBuckets; }
+
+  size_type numOfEntries() const { return m_NumOfEntries; }
+
+  // -----  hash policy  ----- //
+  float load_factor() const;
+
+  /// rehash - make room for at least pCount entries without growing again.
+  void rehash(size_type pCount);
+
+  // -----  iterators  ----- //
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(NULL, 0); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(NULL, 0); }
+
+ private:
+  static const int8_t EmptyControl = -128;
+
+  /// h2 - the 7 bits of the hash value kept in the control byte
+  static int8_t h2(uint32_t pHashValue) {
+    return static_cast<int8_t>(pHashValue >> 25);
+  }
+
+  /// matchByte - bit i of the result is set if byte i of the group at pCtrl
+  /// equals pByte
+  static uint32_t matchByte(const int8_t* pCtrl, int8_t pByte);
+
+  /// matchEmpty - bit i of the result is set if bucket i of the group at
+  /// pCtrl is empty
+  static uint32_t matchEmpty(const int8_t* pCtrl);
+
+  /// findIndex - return the bucket of pKey, or m_NumOfBuckets if it does not
+  /// exist
+  size_type findIndex(const key_type& pKey, uint32_t pHashValue) const;
+
+  /// findEmpty - return the first empty bucket on the probe sequence
+  size_type findEmpty(uint32_t pHashValue) const;
+
+  void allocate(size_type pNumOfBuckets);
+
+  void grow(size_type pNumOfBuckets);
+
+ private:
+  int8_t* m_Control;
+  Slot* m_Slots;
+  size_type m_NumOfBuckets;
+  size_type m_NumOfEntries;
+  hasher m_Hasher;
+  EntryFactoryTy m_EntryFactory;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(FlatHashTable);
+};
+
+#include "FlatHashTable.tcc"
+
+}  // namespace mcld
+
+#endif  // MCLD_ADT_FLATHASHTABLE_H_
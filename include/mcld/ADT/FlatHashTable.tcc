@@ -0,0 +1,283 @@
+//===- FlatHashTable.tcc --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+//===----------------------------------------------------------------------===//
+// template implementation of FlatHashTable
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::FlatHashTable(
+    size_type pSize)
+    : m_Control(NULL),
+      m_Slots(NULL),
+      m_NumOfBuckets(0),
+      m_NumOfEntries(0),
+      m_Hasher(),
+      m_EntryFactory() {
+  allocate(pSize);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::~FlatHashTable() {
+  clear();
+  std::free(m_Control);
+  std::free(m_Slots);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+void FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::clear() {
+  if (empty())
+    return;
+
+  for (size_type i = 0; i < m_NumOfBuckets; ++i) {
+    if (EmptyControl != m_Control[i]) {
+      m_EntryFactory.destroy(m_Slots[i].Entry);
+      m_Control[i] = EmptyControl;
+    }
+  }
+  m_NumOfEntries = 0;
+}
+
+/// insert - insert a new element to the container. If the element already
+//  exist, return the element.
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::entry_type*
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::insert(
+    const key_type& pKey,
+    bool& pExist) {
+  return insert(pKey, m_Hasher(pKey), pExist);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::entry_type*
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::insert(
+    const key_type& pKey,
+    uint32_t pHashValue,
+    bool& pExist) {
+  size_type index = findIndex(pKey, pHashValue);
+  if (index != m_NumOfBuckets) {
+    // Already exist in the table
+    pExist = true;
+    return m_Slots[index].Entry;
+  }
+
+  // keep the load factor under 7/8 so that every probe sequence ends at an
+  // empty bucket.
+  if ((m_NumOfEntries + 1) * 8 > m_NumOfBuckets * 7)
+    grow(m_NumOfBuckets * 2);
+
+  index = findEmpty(pHashValue);
+  m_Control[index] = h2(pHashValue);
+  m_Slots[index].FullHashValue = pHashValue;
+  m_Slots[index].Entry = m_EntryFactory.produce(pKey);
+  ++m_NumOfEntries;
+  pExist = false;
+  return m_Slots[index].Entry;
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::iterator
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+    const key_type& pKey) {
+  return find(pKey, m_Hasher(pKey));
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::
+    const_iterator
+    FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+        const key_type& pKey) const {
+  return find(pKey, m_Hasher(pKey));
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::iterator
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+    const key_type& pKey,
+    uint32_t pHashValue) {
+  size_type index = findIndex(pKey, pHashValue);
+  if (index == m_NumOfBuckets)
+    return end();
+  return iterator(this, index);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::
+    const_iterator
+    FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::find(
+        const key_type& pKey,
+        uint32_t pHashValue) const {
+  size_type index = findIndex(pKey, pHashValue);
+  if (index == m_NumOfBuckets)
+    return end();
+  return const_iterator(this, index);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::size_type
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::count(
+    const key_type& pKey) const {
+  return (findIndex(pKey, m_Hasher(pKey)) == m_NumOfBuckets) ? 0 : 1;
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+float FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::load_factor()
+    const {
+  return ((float)m_NumOfEntries / (float)m_NumOfBuckets);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+void FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::rehash(
+    size_type pCount) {
+  size_type num_of_buckets = m_NumOfBuckets;
+  while (pCount * 8 > num_of_buckets * 7)
+    num_of_buckets *= 2;
+  if (num_of_buckets != m_NumOfBuckets)
+    grow(num_of_buckets);
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+uint32_t FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::matchByte(
+    const int8_t* pCtrl,
+    int8_t pByte) {
+#if defined(__SSE2__)
+  __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl));
+  return static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(pByte))));
+#else
+  uint32_t result = 0;
+  for (unsigned i = 0; i < GroupSize; ++i) {
+    if (pCtrl[i] == pByte)
+      result |= (1U << i);
+  }
+  return result;
+#endif
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+uint32_t FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::matchEmpty(
+    const int8_t* pCtrl) {
+#if defined(__SSE2__)
+  // only EmptyControl has the sign bit set
+  __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl));
+  return static_cast<uint32_t>(_mm_movemask_epi8(group));
+#else
+  return matchByte(pCtrl, EmptyControl);
+#endif
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::size_type
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::findIndex(
+    const key_type& pKey,
+    uint32_t pHashValue) const {
+  size_type mask = m_NumOfBuckets / GroupSize - 1;
+  size_type group = pHashValue & mask;
+  int8_t control = h2(pHashValue);
+  for (size_type probe = 1; probe <= mask + 1; ++probe) {
+    const int8_t* ctrl = m_Control + group * GroupSize;
+    uint32_t match = matchByte(ctrl, control);
+    while (match != 0) {
+      size_type index = group * GroupSize + llvm::countTrailingZeros(match);
+      const Slot& slot = m_Slots[index];
+      if (slot.FullHashValue == pHashValue && slot.Entry->compare(pKey))
+        return index;
+      match &= (match - 1);
+    }
+    // an empty bucket ends the probe sequence
+    if (matchEmpty(ctrl) != 0)
+      break;
+    group = (group + probe) & mask;
+  }
+  return m_NumOfBuckets;
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+typename FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::size_type
+FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::findEmpty(
+    uint32_t pHashValue) const {
+  size_type mask = m_NumOfBuckets / GroupSize - 1;
+  size_type group = pHashValue & mask;
+  for (size_type probe = 1;; ++probe) {
+    uint32_t match = matchEmpty(m_Control + group * GroupSize);
+    if (match != 0)
+      return group * GroupSize + llvm::countTrailingZeros(match);
+    group = (group + probe) & mask;
+  }
+}
+
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+void FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::allocate(
+    size_type pNumOfBuckets) {
+  // the number of groups is a power of two
+  size_type num_of_buckets = GroupSize;
+  while (num_of_buckets < pNumOfBuckets)
+    num_of_buckets *= 2;
+
+  m_NumOfBuckets = num_of_buckets;
+  m_Control = static_cast<int8_t*>(std::malloc(num_of_buckets));
+  std::memset(m_Control, EmptyControl, num_of_buckets);
+  m_Slots = static_cast<Slot*>(std::malloc(num_of_buckets * sizeof(Slot)));
+}
+
+/// grow - move every entry to a table of pNumOfBuckets buckets. The hash
+/// values are kept in the slots, so the keys are not hashed again.
+template <typename HashEntryTy,
+          typename HashFunctionTy,
+          typename EntryFactoryTy>
+void FlatHashTable<HashEntryTy, HashFunctionTy, EntryFactoryTy>::grow(
+    size_type pNumOfBuckets) {
+  int8_t* old_control = m_Control;
+  Slot* old_slots = m_Slots;
+  size_type old_num_of_buckets = m_NumOfBuckets;
+
+  allocate(pNumOfBuckets);
+  for (size_type i = 0; i < old_num_of_buckets; ++i) {
+    if (EmptyControl == old_control[i])
+      continue;
+    size_type index = findEmpty(old_slots[i].FullHashValue);
+    m_Control[index] = old_control[i];
+    m_Slots[index] = old_slots[i];
+  }
+
+  std::free(old_control);
+  std::free(old_slots);
+}
@@ -14,12 +14,13 @@
 
 #include <cassert>
 #include <cctype>
+#include <cstring>
 #include <functional>
 
 namespace mcld {
 namespace hash {
 
-enum Type { RS, JS, PJW, ELF, BKDR, SDBM, DJB, DEK, BP, FNV, AP, ES };
+enum Type { RS, JS, PJW, ELF, BKDR, SDBM, DJB, DEK, BP, FNV, AP, ES, WY };
 
 /** \class template<uint32_t TYPE> StringHash
  *  \brief the template StringHash class, for specification
@@ -237,6 +238,57 @@ struct StringHash<AP>
   }
 };
 
+/** \class StringHash<WY>
+ *  \brief A wyhash-style hash function. It consumes 8 bytes per step and
+ *  mixes with 64x64->128 bit multiplications, so every bit of the result
+ *  depends on every input byte. Tables that take both the low and the high
+ *  bits of the hash value, like FlatHashTable, should use this one.
+ */
+template <>
+struct StringHash<WY>
+    : public std::unary_function<const llvm::StringRef, uint32_t> {
+  static uint64_t mix(uint64_t pA, uint64_t pB) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(pA) * pB;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+    uint64_t ha = pA >> 32, hb = pB >> 32;
+    uint64_t la = static_cast<uint32_t>(pA), lb = static_cast<uint32_t>(pB);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = (t < rl);
+    uint64_t lo = t + (rm1 << 32);
+    c += (lo < t);
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo ^ hi;
+#endif
+  }
+
+  static uint64_t read(const char* pData, size_t pSize) {
+    uint64_t v = 0;
+    std::memcpy(&v, pData, pSize);
+    return v;
+  }
+
+  uint32_t operator()(const llvm::StringRef pKey) const {
+    const uint64_t p0 = 0xa0761d6478bd642fULL;
+    const uint64_t p1 = 0xe7037ed1a0b428dbULL;
+    const uint64_t p2 = 0x8ebc6af09c88c6e3ULL;
+
+    const char* data = pKey.data();
+    size_t size = pKey.size();
+    uint64_t seed = p0 ^ size;
+    while (size > 8) {
+      seed = mix(read(data, 8) ^ p1, seed ^ p2);
+      data += 8;
+      size -= 8;
+    }
+    seed = mix(read(data, size) ^ p1, seed ^ p2);
+    uint64_t hash_val = mix(seed ^ p0, pKey.size() ^ p1);
+    return static_cast<uint32_t>(hash_val ^ (hash_val >> 32));
+  }
+};
+
 /** \class StringHash<ES>
  *  \brief This is a revision of Edward Sayers' string characteristic function.
  *
@@ -41,6 +41,12 @@ class GeneralOptions {
     Both = 0x3
   };
 
+  enum class StatsFormat {
+    Unknown,
+    Text,
+    JSON
+  };
+
   enum class ICF {
     Unknown,
     None,
@@ -166,6 +172,8 @@ class GeneralOptions {
 
   bool hasOrigin() const { return m_bOrigin; }
 
+  bool packRelativeRelocs() const { return m_bPackRelativeRelocs; }
+
   uint64_t commPageSize() const { return m_CommPageSize; }
 
   uint64_t maxPageSize() const { return m_MaxPageSize; }
@@ -263,6 +271,13 @@ class GeneralOptions {
 
   void setHashStyle(HashStyle pStyle) { m_HashStyle = pStyle; }
 
+  // --gnu-hash-load-factor=N
+  void setGNUHashLoadFactor(unsigned pFactor) {
+    m_GNUHashLoadFactor = pFactor;
+  }
+
+  unsigned getGNUHashLoadFactor() const { return m_GNUHashLoadFactor; }
+
   ICF getICFMode() const { return m_ICF; }
 
   void setICFMode(ICF pMode) { m_ICF = pMode; }
@@ -277,6 +292,67 @@ class GeneralOptions {
     m_bPrintICFSections = pPrintICFSections;
   }
 
+  bool printICFStats() const { return m_bPrintICFStats; }
+
+  void setPrintICFStats(bool pPrintICFStats = true) {
+    m_bPrintICFStats = pPrintICFStats;
+  }
+
+  // --threads=N
+  void setNumThreads(unsigned pNum) { m_NumThreads = (pNum == 0) ? 1 : pNum; }
+
+  unsigned numThreads() const { return m_NumThreads; }
+
+  bool hasThreads() const { return m_NumThreads > 1; }
+
+  // --[no-]direct-relocation
+  void setDirectRelocation(bool pEnable = true) {
+    m_bDirectRelocation = pEnable;
+  }
+
+  bool directRelocation() const { return m_bDirectRelocation; }
+
+  // --[no-]merge-sections
+  void setMergeSections(bool pEnable = true) { m_bMergeSections = pEnable; }
+
+  bool mergeSections() const { return m_bMergeSections; }
+
+  // --[no-]tail-merge-strings
+  void setTailMergeStrings(bool pEnable = true) {
+    m_bTailMergeStrings = pEnable;
+  }
+
+  bool tailMergeStrings() const { return m_bTailMergeStrings; }
+
+  // --[no-]stream-debug-info
+  void setStreamDebugInfo(bool pEnable = true) {
+    m_bStreamDebugInfo = pEnable;
+  }
+
+  bool streamDebugInfo() const { return m_bStreamDebugInfo; }
+
+  // --[no-]lazy-dso-symbols
+  void setLazyDSOSymbols(bool pEnable = true) {
+    m_bLazyDSOSymbols = pEnable;
+  }
+
+  bool lazyDSOSymbols() const { return m_bLazyDSOSymbols; }
+
+  // --time-report
+  void setTimeReport(bool pEnable = true) { m_bTimeReport = pEnable; }
+
+  bool timeReport() const { return m_bTimeReport; }
+
+  // --stats
+  void setStats(bool pEnable = true) { m_bStats = pEnable; }
+
+  bool stats() const { return m_bStats; }
+
+  // --stats-format=[text,json]
+  void setStatsFormat(StatsFormat pFormat) { m_StatsFormat = pFormat; }
+
+  StatsFormat statsFormat() const { return m_StatsFormat; }
+
   // -----  link-in rpath  ----- //
   const RpathList& getRpathList() const { return m_RpathList; }
   RpathList& getRpathList() { return m_RpathList; }
@@ -359,6 +435,7 @@ class GeneralOptions {
   bool m_bRelro : 1;         // relro, norelro
   bool m_bNow : 1;           // lazy, now
   bool m_bOrigin : 1;        // origin
+  bool m_bPackRelativeRelocs : 1;  // pack-relative-relocs
   bool m_bTrace : 1;         // --trace
   bool m_Bsymbolic : 1;      // --Bsymbolic
   bool m_Bgroup : 1;
@@ -381,13 +458,24 @@ class GeneralOptions {
   bool m_bPrintGCSections : 1;    // --print-gc-sections
   bool m_bGenUnwindInfo : 1;      // --ld-generated-unwind-info
   bool m_bPrintICFSections : 1;   // --print-icf-sections
+  bool m_bPrintICFStats : 1;      // --print-icf-stats
+  bool m_bDirectRelocation : 1;   // --direct-relocation
+  bool m_bMergeSections : 1;      // --merge-sections
+  bool m_bTailMergeStrings : 1;   // --tail-merge-strings
+  bool m_bStreamDebugInfo : 1;    // --stream-debug-info
+  bool m_bLazyDSOSymbols : 1;     // --lazy-dso-symbols
+  bool m_bTimeReport : 1;         // --time-report
+  bool m_bStats : 1;              // --stats
+  StatsFormat m_StatsFormat;      // --stats-format=[text,json]
   ICF m_ICF;
   size_t m_ICFIterations;
+  unsigned m_NumThreads;  // --threads=N
   StripSymbolMode m_StripSymbols;
   RpathList m_RpathList;
   ScriptList m_ScriptList;
   UndefSymList m_UndefSymList;  // -u [symbol], --undefined [symbol]
   HashStyle m_HashStyle;
+  unsigned m_GNUHashLoadFactor;  // --gnu-hash-load-factor=N
   std::string m_Filter;
   AuxiliaryList m_AuxiliaryList;
   ExcludeLIBS m_ExcludeLIBS;
@@ -22,6 +22,7 @@
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/Resolver.h"
 #include "mcld/MC/Input.h"
 #include "mcld/MC/InputBuilder.h"
 #include "mcld/Support/FileHandle.h"
@@ -58,6 +59,7 @@ class IRBuilder {
   InputBuilder& getInputBuilder() { return m_InputBuilder; }
   const Module& getModule() const { return m_Module; }
   Module& getModule() { return m_Module; }
+  const LinkerConfig& getConfig() const { return m_Config; }
 
   /// @}
   /// @name Input Files On The Command Line
@@ -366,7 +368,9 @@ class IRBuilder {
   ///
   /// @param [in, out] pInput   The input file. Either a relocatable or dynamic
   ///                           object
-  /// @param [in]      pName    The name of the symbol
+  /// @param [in]      pName    The name of the symbol. It is copied into the
+  ///                           name pool, so it may point into the mapped
+  ///                           string table of pInput.
   /// @param [in]      pType    What the symbol refers to. May be a object,
   ///                           function, no-type and so on. @see ResolveInfo
   /// @param [in]      pDesc    { Undefined, Define, Common, Indirect }
@@ -380,18 +384,22 @@ class IRBuilder {
   /// @param [in]      pSection Absolute, undefined, common symbols do not have
   ///                           pSection. Keep their pSection be NULL.
   /// @oaram [in]      pVis     The visibility of the symbol
+  /// @param [in]      pEntry   The entry of pName in the name pool returned
+  ///                           by NamePool::lookupSymbols, or NULL to let
+  ///                           AddSymbol look it up.
   ///
   /// @return The added symbol. If the insertion fails due to the resoluction,
   /// return NULL.
   LDSymbol* AddSymbol(Input& pInput,
-                      const std::string& pName,
+                      const llvm::StringRef& pName,
                       ResolveInfo::Type pType,
                       ResolveInfo::Desc pDesc,
                       ResolveInfo::Binding pBind,
                       ResolveInfo::SizeType pSize,
                       LDSymbol::ValueType pValue = 0x0,
                       LDSection* pSection = NULL,
-                      ResolveInfo::Visibility pVis = ResolveInfo::Default);
+                      ResolveInfo::Visibility pVis = ResolveInfo::Default,
+                      ResolveInfo* pEntry = NULL);
 
   /// AddSymbol - To add a symbol in mcld::Module
   /// This function create a new symbol and insert it into mcld::Module.
@@ -459,23 +467,39 @@ class IRBuilder {
   bool shouldForceLocal(const ResolveInfo& pInfo, const LinkerConfig& pConfig);
 
  private:
-  LDSymbol* addSymbolFromObject(const std::string& pName,
+  LDSymbol* addSymbolFromObject(const llvm::StringRef& pName,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
                                 ResolveInfo::Binding pBinding,
                                 ResolveInfo::SizeType pSize,
                                 LDSymbol::ValueType pValue,
                                 FragmentRef* pFragmentRef,
-                                ResolveInfo::Visibility pVisibility);
+                                ResolveInfo::Visibility pVisibility,
+                                ResolveInfo* pEntry);
 
   LDSymbol* addSymbolFromDynObj(Input& pInput,
-                                const std::string& pName,
+                                const llvm::StringRef& pName,
                                 ResolveInfo::Type pType,
                                 ResolveInfo::Desc pDesc,
                                 ResolveInfo::Binding pBinding,
                                 ResolveInfo::SizeType pSize,
                                 LDSymbol::ValueType pValue,
-                                ResolveInfo::Visibility pVisibility);
+                                ResolveInfo::Visibility pVisibility,
+                                ResolveInfo* pEntry);
+
+  /// insertSymbol - insert and resolve a symbol in the name pool, through
+  /// pEntry if it is not NULL.
+  void insertSymbol(const llvm::StringRef& pName,
+                    bool pIsDyn,
+                    ResolveInfo::Type pType,
+                    ResolveInfo::Desc pDesc,
+                    ResolveInfo::Binding pBinding,
+                    ResolveInfo::SizeType pSize,
+                    LDSymbol::ValueType pValue,
+                    ResolveInfo::Visibility pVisibility,
+                    ResolveInfo* pOldInfo,
+                    ResolveInfo* pEntry,
+                    Resolver::Result& pResult);
 
  private:
   Module& m_Module;
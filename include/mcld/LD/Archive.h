@@ -15,6 +15,8 @@
 #include "mcld/ADT/StringHash.h"
 #include "mcld/Support/GCFactory.h"
 
+#include <llvm/ADT/StringMap.h>
+
 #include <string>
 #include <vector>
 
@@ -107,6 +109,9 @@ class Archive {
 
   typedef std::vector<Symbol*> SymTabType;
 
+  /// SymbolIndices - the symtab indices of the symbols with the same name
+  typedef std::vector<uint32_t> SymbolIndices;
+
  public:
   Archive(Input& pInputFile, InputBuilder& pBuilder);
 
@@ -189,6 +194,10 @@ class Archive {
   /// getSymbolName - get the symbol name with the given index
   const std::string& getSymbolName(size_t pSymIdx) const;
 
+  /// findSymbols - get the symtab indices of the symbols named pName
+  /// @return NULL if no symbol in symtab has the name
+  const SymbolIndices* findSymbols(const llvm::StringRef& pName) const;
+
   /// getObjFileOffset - get the file offset that represent a object file
   uint32_t getObjFileOffset(size_t pSymIdx) const;
 
@@ -207,6 +216,20 @@ class Archive {
   /// hasStrTable - return true if this archive has extended name table
   bool hasStrTable() const;
 
+  /// numOfVisitedObjects - the number of objects in Module whose undefined
+  /// symbols have been looked up in this archive
+  size_t numOfVisitedObjects() const { return m_NumOfVisitedObjects; }
+
+  void setNumOfVisitedObjects(size_t pNum) { m_NumOfVisitedObjects = pNum; }
+
+  /// numOfVisitedLibraries - the number of shared objects in Module when
+  /// the symtab of this archive was scanned last time
+  size_t numOfVisitedLibraries() const { return m_NumOfVisitedLibraries; }
+
+  void setNumOfVisitedLibraries(size_t pNum) {
+    m_NumOfVisitedLibraries = pNum;
+  }
+
   /// getMemberFile       - get the member file in an archive member
   /// @param pArchiveFile - Input reference of the archive member
   /// @param pIsThinAR    - denote the archive menber is a Thin Archive or not
@@ -221,6 +244,7 @@ class Archive {
 
  private:
   typedef GCFactory<Symbol, 0> SymbolFactory;
+  typedef llvm::StringMap<SymbolIndices> SymbolIndexMap;
 
  private:
   Input& m_ArchiveFile;
@@ -229,8 +253,11 @@ class Archive {
   ArchiveMemberMapType m_ArchiveMemberMap;
   SymbolFactory m_SymbolFactory;
   SymTabType m_SymTab;
+  SymbolIndexMap m_SymbolIndexMap;
   size_t m_SymTabSize;
   std::string m_StrTab;
+  size_t m_NumOfVisitedObjects;
+  size_t m_NumOfVisitedLibraries;
   InputBuilder& m_Builder;
 };
 
@@ -12,12 +12,16 @@
 #include "mcld/LD/BranchIsland.h"
 #include "mcld/Support/GCFactory.h"
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/Support/DataTypes.h>
 
+#include <vector>
+
 namespace mcld {
 
 class Fragment;
 class Module;
+class SectionData;
 
 /** \class BranchIslandFactory
  *  \brief
@@ -48,10 +52,18 @@ class BranchIslandFactory : public GCFactory<BranchIsland, 0> {
   /// @return - return the pair of <fwd island, bwd island>
   std::pair<BranchIsland*, BranchIsland*> getIslands(const Fragment& pFragment);
 
+ private:
+  /// IslandList - the islands of a SectionData in the order of their offsets.
+  /// Stubs only make the islands bigger, so the order never changes.
+  typedef std::vector<BranchIsland*> IslandList;
+
+  typedef llvm::DenseMap<const SectionData*, IslandList> IslandMap;
+
  private:
   int64_t m_MaxFwdBranchRange;
   int64_t m_MaxBwdBranchRange;
   size_t m_MaxIslandSize;
+  IslandMap m_IslandMap;
 };
 
 }  // namespace mcld
@@ -12,6 +12,7 @@
 
 #include <llvm/Support/DataTypes.h>
 
+#include <mutex>
 #include <string>
 
 namespace mcld {
@@ -32,6 +33,10 @@ class MsgHandler;
  *  DiagnosticEngine is a complex class, it is responsible for
  *  - remember the argument string for MsgHandler
  *  - choice the severity of a message by options
+ *
+ *  DiagnosticEngine can be used by several threads at once. The MsgHandler
+ *  returned by report() holds the engine lock until the message is emitted,
+ *  so the arguments of two messages never interleave.
  */
 class DiagnosticEngine {
  public:
@@ -138,6 +143,8 @@ class DiagnosticEngine {
   bool m_OwnPrinter;
 
   State m_State;
+
+  std::recursive_mutex m_Mutex;
 };
 
 }  // namespace mcld
@@ -32,6 +32,8 @@ class ELFDynObjReader : public DynObjReader {
   // -----  observers  ----- //
   bool isMyFormat(Input& pFile, bool& pContinue) const;
 
+  bool prefetch(Input& pFile);
+
   // -----  readers  ----- //
   bool readHeader(Input& pFile);
 
@@ -40,6 +42,7 @@ class ELFDynObjReader : public DynObjReader {
  private:
   ELFReaderIF* m_pELFReader;
   IRBuilder& m_Builder;
+  const LinkerConfig& m_Config;
 };
 
 }  // namespace mcld
@@ -15,6 +15,15 @@ namespace mcld {
 
 class ObjectBuilder;
 
+/// The packed relative relocation section and its dynamic tags (SHT_RELR and
+/// DT_RELR*), which are newer than llvm::ELF.
+enum {
+  SHT_RELR = 19,
+  DT_RELRSZ = 35,
+  DT_RELR = 36,
+  DT_RELRENT = 37
+};
+
 /** \class ELFFileFormat
  *  \brief ELFFileFormat describes the common file formats in ELF.
  *  LDFileFormats control the formats of the output file.
@@ -63,6 +72,10 @@ class ELFFileFormat : public LDFileFormat {
     return (f_pRelaPlt != NULL) && (f_pRelaPlt->size() != 0);
   }
 
+  bool hasRelrDyn() const {
+    return (f_pRelrDyn != NULL) && (f_pRelrDyn->size() != 0);
+  }
+
   /// @ref 10.3.1.1, ISO/IEC 23360, Part 1:2010(E), p. 21.
   bool hasComment() const {
     return (f_pComment != NULL) && (f_pComment->size() != 0);
@@ -277,6 +290,16 @@ class ELFFileFormat : public LDFileFormat {
     return *f_pRelaPlt;
   }
 
+  LDSection& getRelrDyn() {
+    assert(f_pRelrDyn != NULL);
+    return *f_pRelrDyn;
+  }
+
+  const LDSection& getRelrDyn() const {
+    assert(f_pRelrDyn != NULL);
+    return *f_pRelrDyn;
+  }
+
   LDSection& getComment() {
     assert(f_pComment != NULL);
     return *f_pComment;
@@ -679,6 +702,7 @@ class ELFFileFormat : public LDFileFormat {
   LDSection* f_pRelPlt;   // .rel.plt
   LDSection* f_pRelaDyn;  // .rela.dyn
   LDSection* f_pRelaPlt;  // .rela.plt
+  LDSection* f_pRelrDyn;  // .relr.dyn
 
   /// @ref 10.3.1.1, ISO/IEC 23360, Part 1:2010(E), p. 21.
   LDSection* f_pComment;       // .comment
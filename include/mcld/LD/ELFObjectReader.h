@@ -20,6 +20,7 @@ class Input;
 class IRBuilder;
 class GNULDBackend;
 class LinkerConfig;
+class MemoryArea;
 
 /** \lclass ELFObjectReader
  *  \brief ELFObjectReader reads target-independent parts of ELF object file
@@ -43,6 +44,12 @@ class ELFObjectReader : public ObjectReader {
   // -----  observers  ----- //
   bool isMyFormat(Input& pFile, bool& pContinue) const;
 
+  bool prefetch(Input& pFile);
+
+  /// prefetch - decode the tables of the archive member at pFileOffset of
+  /// pArea before it is read
+  bool prefetch(MemoryArea& pArea, uint64_t pFileOffset);
+
   // -----  readers  ----- //
   bool readHeader(Input& pFile);
 
@@ -52,7 +59,9 @@ class ELFObjectReader : public ObjectReader {
 
   /// readRelocations - read relocation sections
   ///
-  /// This function should be called after symbol resolution.
+  /// This function should be called after symbol resolution. It only keeps
+  /// the mapped records in the RelocTables, which decode them on
+  /// materialize().
   virtual bool readRelocations(Input& pFile);
 
  private:
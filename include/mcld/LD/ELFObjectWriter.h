@@ -9,9 +9,11 @@
 #ifndef MCLD_LD_ELFOBJECTWRITER_H_
 #define MCLD_LD_ELFOBJECTWRITER_H_
 #include "mcld/LD/ObjectWriter.h"
+#include "mcld/LD/SectionData.h"
 #include "mcld/Support/FileOutputBuffer.h"
 
 #include <cassert>
+#include <vector>
 
 namespace mcld {
 
@@ -21,7 +23,6 @@ class LDSection;
 class LinkerConfig;
 class Module;
 class RelocData;
-class SectionData;
 
 /** \class ELFObjectWriter
  *  \brief ELFObjectWriter writes the target-independent parts of object files.
@@ -36,13 +37,35 @@ class ELFObjectWriter : public ObjectWriter {
 
   std::error_code writeObject(Module& pModule, FileOutputBuffer& pOutput);
 
+  std::error_code writeObject(Module& pModule,
+                              FileOutputBuffer& pOutput,
+                              const std::function<void()>& pApply);
+
   size_t getOutputSize(const Module& pModule) const;
 
  private:
+  typedef std::vector<LDSection*> SectionList;
+
+  /// writeSections - write out pSections. The contents of the regular
+  /// sections are copied by a pool of threads, large sections in several
+  /// fragment ranges. The other sections are written afterwards in order.
+  void writeSections(Module& pModule,
+                     FileOutputBuffer& pOutput,
+                     const SectionList& pSections);
+
   void writeSection(Module& pModule,
                     FileOutputBuffer& pOutput,
                     LDSection* section);
 
+  /// isStreamed - whether pSection is left to streamDebugSections
+  bool isStreamed(const LDSection& pSection) const;
+
+  /// streamDebugSections - copy the non-alloc debug sections for
+  /// --stream-debug-info. The fragments are copied input by input, and the
+  /// pages of an input are released once all its fragments are written.
+  void streamDebugSections(const Module& pModule,
+                           FileOutputBuffer& pOutput) const;
+
   const GNULDBackend& target() const { return m_Backend; }
   GNULDBackend& target() { return m_Backend; }
 
@@ -111,6 +134,13 @@ class ELFObjectWriter : public ObjectWriter {
 
   void emitSectionData(const SectionData& pSD, MemoryRegion& pRegion) const;
 
+  /// emitFragments - emit the fragments [pBegin, pEnd), the first of which
+  /// is at pOffset of pRegion
+  void emitFragments(SectionData::const_iterator pBegin,
+                     SectionData::const_iterator pEnd,
+                     size_t pOffset,
+                     MemoryRegion& pRegion) const;
+
  private:
   GNULDBackend& m_Backend;
 
@@ -62,18 +62,9 @@ class ELFReader<32, true> : public ELFReaderIF {
   /// fileType - the file type of this file
   Input::Type fileType(const void* pELFHeader) const;
 
-  /// readSectionHeaders - read ELF section header table and create LDSections
-  bool readSectionHeaders(Input& pInput, const void* pELFHeader) const;
-
   /// readRegularSection - read a regular section and create fragments.
   bool readRegularSection(Input& pInput, SectionData& pSD) const;
 
-  /// readSymbols - read ELF symbols and create LDSymbol
-  bool readSymbols(Input& pInput,
-                   IRBuilder& pBuilder,
-                   llvm::StringRef pRegion,
-                   const char* StrTab) const;
-
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
   ResolveInfo* readSignature(Input& pInput,
@@ -93,26 +84,11 @@ class ELFReader<32, true> : public ELFReaderIF {
   /// readDynamic - read ELF .dynamic in input dynobj
   bool readDynamic(Input& pInput) const;
 
- private:
-  struct AliasInfo {
-    LDSymbol* pt_alias;  /// potential alias
-    uint64_t ld_value;
-    ResolveInfo::Binding ld_binding;
-  };
-
-  /// comparison function to sort symbols for analyzing weak alias.
-  /// sort symbols by symbol value and then weak before strong.
-  static bool less(AliasInfo p1, AliasInfo p2) {
-    if (p1.ld_value != p2.ld_value)
-      return (p1.ld_value < p2.ld_value);
-    if (p1.ld_binding != p2.ld_binding) {
-      if (ResolveInfo::Weak == p1.ld_binding)
-        return true;
-      else if (ResolveInfo::Weak == p2.ld_binding)
-        return false;
-    }
-    return p1.pt_alias->str() < p2.pt_alias->str();
-  }
+ protected:
+  bool decodeSectionHeaders(llvm::StringRef pImage, ELFTables& pTables) const;
+
+  void decodeSymbols(llvm::StringRef pRegion,
+                     ELFTables::SymbolList& pSymbols) const;
 };
 
 /** \class ELFReader<64, true>
@@ -147,18 +123,9 @@ class ELFReader<64, true> : public ELFReaderIF {
   /// fileType - the file type of this file
   Input::Type fileType(const void* pELFHeader) const;
 
-  /// readSectionHeaders - read ELF section header table and create LDSections
-  bool readSectionHeaders(Input& pInput, const void* pELFHeader) const;
-
   /// readRegularSection - read a regular section and create fragments.
   bool readRegularSection(Input& pInput, SectionData& pSD) const;
 
-  /// readSymbols - read ELF symbols and create LDSymbol
-  bool readSymbols(Input& pInput,
-                   IRBuilder& pBuilder,
-                   llvm::StringRef pRegion,
-                   const char* StrTab) const;
-
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
   ResolveInfo* readSignature(Input& pInput,
@@ -178,26 +145,11 @@ class ELFReader<64, true> : public ELFReaderIF {
   /// readDynamic - read ELF .dynamic in input dynobj
   bool readDynamic(Input& pInput) const;
 
- private:
-  struct AliasInfo {
-    LDSymbol* pt_alias;  /// potential alias
-    uint64_t ld_value;
-    ResolveInfo::Binding ld_binding;
-  };
-
-  /// comparison function to sort symbols for analyzing weak alias.
-  /// sort symbols by symbol value and then weak before strong.
-  static bool less(AliasInfo p1, AliasInfo p2) {
-    if (p1.ld_value != p2.ld_value)
-      return (p1.ld_value < p2.ld_value);
-    if (p1.ld_binding != p2.ld_binding) {
-      if (ResolveInfo::Weak == p1.ld_binding)
-        return true;
-      else if (ResolveInfo::Weak == p2.ld_binding)
-        return false;
-    }
-    return p1.pt_alias->str() < p2.pt_alias->str();
-  }
+ protected:
+  bool decodeSectionHeaders(llvm::StringRef pImage, ELFTables& pTables) const;
+
+  void decodeSymbols(llvm::StringRef pRegion,
+                     ELFTables::SymbolList& pSymbols) const;
 };
 
 }  // namespace mcld
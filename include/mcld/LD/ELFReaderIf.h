@@ -10,18 +10,24 @@
 #define MCLD_LD_ELFREADERIF_H_
 
 #include "mcld/LinkerConfig.h"
+#include "mcld/LD/ELFTables.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/GNULDBackend.h"
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/ELF.h>
 #include <llvm/Support/Host.h>
 
+#include <mutex>
+
 namespace mcld {
 
 class IRBuilder;
 class FragmentRef;
 class LDSection;
+class LDSymbol;
+class MemoryArea;
 class SectionData;
 
 /** \class ELFReaderIF
@@ -31,7 +37,7 @@ class ELFReaderIF {
  public:
   explicit ELFReaderIF(GNULDBackend& pBackend) : m_Backend(pBackend) {}
 
-  virtual ~ELFReaderIF() {}
+  virtual ~ELFReaderIF();
 
   /// ELFHeaderSize - return the size of the ELFHeader
   virtual size_t getELFHeaderSize() const = 0;
@@ -53,17 +59,16 @@ class ELFReaderIF {
   GNULDBackend& target() { return m_Backend; }
 
   /// readSectionHeaders - read ELF section header table and create LDSections
-  virtual bool readSectionHeaders(Input& pInput,
-                                  const void* pELFHeader) const = 0;
+  bool readSectionHeaders(Input& pInput, const void* pELFHeader) const;
 
   /// readRegularSection - read a regular section and create fragments.
   virtual bool readRegularSection(Input& pInput, SectionData& pSD) const = 0;
 
   /// readSymbols - read ELF symbols and create LDSymbol
-  virtual bool readSymbols(Input& pInput,
-                           IRBuilder& pBuilder,
-                           llvm::StringRef pRegion,
-                           const char* StrTab) const = 0;
+  bool readSymbols(Input& pInput,
+                   IRBuilder& pBuilder,
+                   llvm::StringRef pRegion,
+                   const char* pStrTab) const;
 
   /// readSignature - read a symbol from the given Input and index in symtab
   /// This is used to get the signature of a group section.
@@ -84,6 +89,30 @@ class ELFReaderIF {
   /// readDynamic - read ELF .dynamic in input dynobj
   virtual bool readDynamic(Input& pInput) const = 0;
 
+  /// addSymbols - create the LDSymbols of pInput from its decoded symbol
+  /// table
+  bool addSymbols(Input& pInput,
+                  IRBuilder& pBuilder,
+                  const ELFTables::SymbolList& pSymbols,
+                  const char* pStrTab) const;
+
+  /// prefetch - decode the section header table and the symbol table of the
+  /// ELF file at pFileOffset of pArea if it is of type pType for this target,
+  /// and keep them for the readers. The symbols are not decoded if pSymbols
+  /// is false. It only reads the file and may be called for different files
+  /// at the same time.
+  /// @return true if the tables are decoded
+  bool prefetch(MemoryArea& pArea,
+                uint64_t pFileOffset,
+                Input::Type pType,
+                bool pSymbols);
+
+  /// getTables - the tables of pInput decoded by prefetch, or NULL
+  const ELFTables* getTables(Input& pInput) const;
+
+  /// releaseTables - free the tables of pInput once its symbols are read
+  void releaseTables(Input& pInput);
+
  protected:
   /// LinkInfo - some section needs sh_link and sh_info, remember them.
   struct LinkInfo {
@@ -94,7 +123,38 @@ class ELFReaderIF {
 
   typedef std::vector<LinkInfo> LinkInfoList;
 
+  struct AliasInfo {
+    LDSymbol* pt_alias;  /// potential alias
+    uint64_t ld_value;
+    ResolveInfo::Binding ld_binding;
+  };
+
  protected:
+  /// decodeSectionHeaders - decode the section header table of the ELF file
+  /// pImage into pTables
+  /// @return false if the table is out of pImage
+  virtual bool decodeSectionHeaders(llvm::StringRef pImage,
+                                    ELFTables& pTables) const = 0;
+
+  /// decodeSymbols - decode the ELF symbol table pRegion into pSymbols
+  virtual void decodeSymbols(llvm::StringRef pRegion,
+                             ELFTables::SymbolList& pSymbols) const = 0;
+
+  /// decodeTables - decode the tables of the ELF file pImage into pTables if
+  /// it is of type pType for this target
+  bool decodeTables(llvm::StringRef pImage,
+                    Input::Type pType,
+                    bool pSymbols,
+                    ELFTables& pTables) const;
+
+  /// createSections - create the LDSections of pInput from its decoded
+  /// section header table
+  bool createSections(Input& pInput, const ELFTables& pTables) const;
+
+  /// comparison function to sort symbols for analyzing weak alias.
+  /// sort symbols by symbol value and then weak before strong.
+  static bool less(const AliasInfo& p1, const AliasInfo& p2);
+
   ResolveInfo::Type getSymType(uint8_t pInfo, uint16_t pShndx) const;
 
   ResolveInfo::Desc getSymDesc(uint16_t pShndx, const Input& pInput) const;
@@ -113,8 +173,26 @@ class ELFReaderIF {
 
   ResolveInfo::Visibility getSymVisibility(uint8_t pVis) const;
 
+  /// isPooledSymbol - will a symbol with st_info pInfo and st_other pOther be
+  /// inserted into the name pool?
+  static bool isPooledSymbol(uint8_t pInfo, uint8_t pOther, bool pIsDynObj);
+
+  /// lookupSymbols - look up the names of the pooled symbols of an input
+  /// before adding the symbols one by one. Large symbol tables are looked up
+  /// in parallel if --threads is given.
+  void lookupSymbols(IRBuilder& pBuilder,
+                     const std::vector<llvm::StringRef>& pNames,
+                     std::vector<ResolveInfo*>& pEntries) const;
+
  protected:
   GNULDBackend& m_Backend;
+
+ private:
+  typedef llvm::DenseMap<const void*, ELFTables*> TablesMap;
+
+  /// m_Tables - the prefetched tables, keyed by the address of the ELF header
+  TablesMap m_Tables;
+  mutable std::mutex m_TablesMutex;
 };
 
 }  // namespace mcld
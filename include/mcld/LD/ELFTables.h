@@ -0,0 +1,92 @@
+//===- ELFTables.h --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_ELFTABLES_H_
+#define MCLD_LD_ELFTABLES_H_
+
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+/** \class ELFTables
+ *  \brief ELFTables keeps the section header table and the symbol table of
+ *  an ELF file, decoded into host byte order and 64-bit fields.
+ *
+ *  With --threads, the tables of the inputs are decoded by a pool of workers
+ *  ahead of the serial readers. The readers then create the LDSections and
+ *  add the symbols from the decoded tables in command-line order, without
+ *  parsing the file again.
+ */
+class ELFTables {
+ public:
+  struct Section {
+    uint32_t Name;
+    uint32_t Type;
+    uint64_t Flags;
+    uint64_t Offset;
+    uint64_t Size;
+    uint32_t Link;
+    uint32_t Info;
+    uint64_t AddrAlign;
+    uint64_t EntSize;
+  };
+
+  struct Symbol {
+    uint32_t Name;
+    uint8_t Info;
+    uint8_t Other;
+    uint16_t Shndx;
+    uint64_t Value;
+    uint64_t Size;
+  };
+
+  typedef std::vector<Section> SectionList;
+  typedef std::vector<Symbol> SymbolList;
+
+ public:
+  ELFTables() : m_pShStrTab(NULL), m_SymTabOffset(0), m_SymTabSize(0) {}
+
+  /// sections - the section headers, in the order of the LDSections
+  const SectionList& sections() const { return m_Sections; }
+  SectionList& sections() { return m_Sections; }
+
+  /// shStrTab - the contents of the section name string table
+  const char* shStrTab() const { return m_pShStrTab; }
+
+  void setShStrTab(const char* pShStrTab) { m_pShStrTab = pShStrTab; }
+
+  /// symbols - the symbols of the symbol table read by the readers, .symtab
+  /// of an object or .dynsym of a shared object
+  const SymbolList& symbols() const { return m_Symbols; }
+  SymbolList& symbols() { return m_Symbols; }
+
+  void setSymTab(uint64_t pOffset, uint64_t pSize) {
+    m_SymTabOffset = pOffset;
+    m_SymTabSize = pSize;
+  }
+
+  /// hasSymTab - whether symbols() are decoded from the section at pOffset of
+  /// pSize bytes
+  bool hasSymTab(uint64_t pOffset, uint64_t pSize) const {
+    return m_SymTabSize != 0 && m_SymTabOffset == pOffset &&
+           m_SymTabSize == pSize;
+  }
+
+ private:
+  SectionList m_Sections;
+  const char* m_pShStrTab;
+  SymbolList m_Symbols;
+  uint64_t m_SymTabOffset;
+  uint64_t m_SymTabSize;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_ELFTABLES_H_
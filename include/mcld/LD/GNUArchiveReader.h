@@ -12,11 +12,14 @@
 #include "mcld/LD/Archive.h"
 #include "mcld/LD/ArchiveReader.h"
 
+#include <vector>
+
 namespace mcld {
 
 class Archive;
 class ELFObjectReader;
 class Input;
+class LDSymbol;
 class LinkerConfig;
 class Module;
 
@@ -72,6 +75,29 @@ class GNUArchiveReader : public ArchiveReader {
   enum Archive::Symbol::Status shouldIncludeSymbol(
       const llvm::StringRef& pSymName) const;
 
+  /// includeSymbol - include the member that defines the symbol at pSymIdx
+  /// of the symtab if it is needed
+  bool includeSymbol(const LinkerConfig& pConfig,
+                     Archive& pArchive,
+                     size_t pSymIdx);
+
+  /// findUndefSymbols - the symtab entries named after pSymbol if it is
+  /// undefined, or NULL
+  const Archive::SymbolIndices* findUndefSymbols(Archive& pArchive,
+                                                 const LDSymbol& pSymbol) const;
+
+  /// collectMember - collect the offset of the member defining the symbol at
+  /// pSymIdx if it is likely to be included
+  void collectMember(Archive& pArchive,
+                     size_t pSymIdx,
+                     std::vector<uint32_t>& pOffsets) const;
+
+  /// prefetchMembers - decode the tables of the members at pOffsets in
+  /// parallel before they are included
+  void prefetchMembers(const LinkerConfig& pConfig,
+                       Archive& pArchive,
+                       std::vector<uint32_t>& pOffsets);
+
   /// includeMember - include the object member in the given file offset, and
   /// return the size of the object
   /// @param pConfig - LinkerConfig
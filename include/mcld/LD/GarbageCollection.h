@@ -9,12 +9,17 @@
 #ifndef MCLD_LD_GARBAGECOLLECTION_H_
 #define MCLD_LD_GARBAGECOLLECTION_H_
 
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/Support/DataTypes.h>
+
 #include <map>
 #include <set>
+#include <utility>
 #include <vector>
 
 namespace mcld {
 
+class Input;
 class LDSection;
 class LinkerConfig;
 class Module;
@@ -30,8 +35,17 @@ class GarbageCollection {
 
   /** \class SectionReachedListMap
    *  \brief Map the section to the list of sections which it can reach directly
+   *
+   *  The target backends add their own references here. They are folded into
+   *  the reference graph together with the references of the relocations.
    */
   class SectionReachedListMap {
+   private:
+    typedef std::map<const LDSection*, SectionListTy> ReachedSectionsTy;
+
+   public:
+    typedef ReachedSectionsTy::const_iterator const_iterator;
+
    public:
     SectionReachedListMap() {}
 
@@ -46,8 +60,8 @@ class GarbageCollection {
     /// pSection, return NULL if the list not exists
     SectionListTy* findReachedList(const LDSection& pSection);
 
-   private:
-    typedef std::map<const LDSection*, SectionListTy> ReachedSectionsTy;
+    const_iterator begin() const { return m_ReachedSections.begin(); }
+    const_iterator end() const { return m_ReachedSections.end(); }
 
    private:
     /// m_ReachedSections - map a section to the reachable sections list
@@ -64,18 +78,36 @@ class GarbageCollection {
   bool run();
 
  private:
+  /// Reference - a reference from the section of the first ordinal to the
+  /// section of the second
+  typedef std::pair<uint32_t, uint32_t> Reference;
+  typedef std::vector<Reference> ReferenceList;
+
   void setUpReachedSections();
-  void findReferencedSections(SectionVecTy& pEntry);
+  void collectReferences(Input& pInput, ReferenceList& pReferences);
   void getEntrySections(SectionVecTy& pEntry);
+  void findReferencedSections(SectionVecTy& pEntry);
   void stripSections();
 
  private:
-  /// m_SectionReachedListMap - map the section to the list of sections which it
-  /// can reach directly
+  /// m_SectionReachedListMap - the references set up by the target backend
   SectionReachedListMap m_SectionReachedListMap;
 
-  /// m_ReferencedSections - a list of sections which can be reached from entry
-  SectionListTy m_ReferencedSections;
+  /// m_Sections - the input sections, indexed by their ordinals. The sections
+  /// of an input have consecutive ordinals.
+  SectionVecTy m_Sections;
+
+  /// m_Ordinals - map an input section to its ordinal
+  llvm::DenseMap<const LDSection*, uint32_t> m_Ordinals;
+
+  /// m_EdgeBegin, m_Edges - the reference graph in compressed sparse row
+  /// form. The sections which can be reached directly from section i are
+  /// m_Edges[m_EdgeBegin[i]] to m_Edges[m_EdgeBegin[i + 1] - 1].
+  std::vector<size_t> m_EdgeBegin;
+  std::vector<uint32_t> m_Edges;
+
+  /// m_Referenced - whether section i can be reached from the entries
+  std::vector<uint8_t> m_Referenced;
 
   const LinkerConfig& m_Config;
   const TargetLDBackend& m_Backend;
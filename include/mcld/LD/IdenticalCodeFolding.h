@@ -10,6 +10,7 @@
 #define MCLD_LD_IDENTICALCODEFOLDING_H_
 
 #include <llvm/ADT/MapVector.h>
+#include <llvm/Support/DataTypes.h>
 
 #include <string>
 #include <vector>
@@ -27,6 +28,13 @@ class TargetLDBackend;
  *  \brief Implementation of identical code folding for --icf=[none|all|safe]
  *  @ref Safe ICF: Pointer Safe and Unwinding Aware Identical Code Folding in
  *       Gold, http://research.google.com/pubs/pub36912.html
+ *
+ *  The candidates are partitioned into equivalence classes. The constant
+ *  content of every candidate (its bytes and the relocations which do not
+ *  refer to the other candidates) is built and hashed once, and the first
+ *  partition puts the candidates with the same constant content together.
+ *  Then each round splits the classes whose members refer to candidates of
+ *  different classes, until no class is split.
  */
 class IdenticalCodeFolding {
  public:
@@ -36,26 +44,31 @@ class IdenticalCodeFolding {
  private:
   class FoldingCandidate {
    public:
-    FoldingCandidate() : sect(NULL), reloc_sect(NULL), obj(NULL) {}
+    FoldingCandidate()
+        : sect(NULL), reloc_sect(NULL), obj(NULL), content_hash(0) {}
     FoldingCandidate(LDSection* pCode, LDSection* pReloc, Input* pInput)
-        : sect(pCode), reloc_sect(pReloc), obj(pInput) {}
+        : sect(pCode), reloc_sect(pReloc), obj(pInput), content_hash(0) {}
 
     void initConstantContent(
         const TargetLDBackend& pBackend,
         const IdenticalCodeFolding::KeptSections& pKeptSections);
-    std::string getContentWithVariables(
-        const TargetLDBackend& pBackend,
-        const IdenticalCodeFolding::KeptSections& pKeptSections);
 
     LDSection* sect;
     LDSection* reloc_sect;
     Input* obj;
     std::string content;
-    std::vector<Relocation*> variable_relocs;
+    uint32_t content_hash;
+    /// variable_targets - the candidate indices of the sections referred by
+    /// the variable relocations, in relocation order
+    std::vector<size_t> variable_targets;
   };
 
   typedef std::vector<FoldingCandidate> FoldingCandidates;
 
+  /// ClassList - the class of each candidate, which is the index of its first
+  /// candidate
+  typedef std::vector<size_t> ClassList;
+
  public:
   IdenticalCodeFolding(const LinkerConfig& pConfig,
                        const TargetLDBackend& pBackend,
@@ -66,7 +79,15 @@ class IdenticalCodeFolding {
  private:
   void findCandidates(FoldingCandidates& pCandidateList);
 
-  bool matchCandidates(FoldingCandidates& pCandidateList);
+  /// initClasses - put the candidates with the same constant content into
+  /// the same class
+  void initClasses(const FoldingCandidates& pCandidateList,
+                   ClassList& pClasses);
+
+  /// refineClasses - split the classes whose members refer to candidates of
+  /// different classes. Return true if no class is split.
+  bool refineClasses(const FoldingCandidates& pCandidateList,
+                     ClassList& pClasses);
 
  private:
   const LinkerConfig& m_Config;
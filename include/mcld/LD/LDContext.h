@@ -11,16 +11,13 @@
 
 #include "mcld/LD/LDFileFormat.h"
 
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Support/DataTypes.h>
 
 #include <cassert>
 #include <string>
 #include <vector>
 
-namespace llvm {
-class StringRef;
-}  // namespace llvm
-
 namespace mcld {
 
 class LDSymbol;
@@ -86,7 +83,8 @@ class LDContext {
   SymbolTable m_SymTab;
   SectionTable m_RelocSections;
 
-  // FIXME : maintain a map<section name, section index>
+  /// m_SectionIndex - the index of the first section of each name
+  llvm::StringMap<size_t> m_SectionIndex;
 };
 
 }  // namespace mcld
@@ -28,6 +28,12 @@ class LDReader {
   virtual ~LDReader() {}
 
   virtual bool isMyFormat(Input& pInput, bool& pContinue) const = 0;
+
+  /// prefetch - decode the tables of pInput that the reader will parse and
+  /// keep them for the sequential read. It does not create any IR and may be
+  /// called for different inputs at the same time.
+  /// @return true if pInput is in the format of this reader.
+  virtual bool prefetch(Input& pInput) { return false; }
 };
 
 }  // namespace mcld
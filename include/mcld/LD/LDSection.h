@@ -102,6 +102,12 @@ class LDSection {
   ///   Before layouting, output's LDSection::align() should return zero.
   uint32_t align() const { return m_Align; }
 
+  /// entSize - the size of each entry if the section holds a table of
+  /// fixed-size entries, such as the strings or constants of a mergeable
+  /// section.
+  ///   In ELF, it is sh_entsize.
+  uint64_t entSize() const { return m_EntSize; }
+
   size_t index() const { return m_Index; }
 
   /// getLink - return the Link. When a section A needs the other section B
@@ -125,6 +131,8 @@ class LDSection {
 
   void setAlign(uint32_t align) { m_Align = align; }
 
+  void setEntSize(uint64_t pEntSize) { m_EntSize = pEntSize; }
+
   void setFlag(uint32_t flag) { m_Flag = flag; }
 
   void setType(uint32_t type) { m_Type = type; }
@@ -189,6 +197,7 @@ class LDSection {
   uint64_t m_Offset;
   uint64_t m_Addr;
   uint32_t m_Align;
+  uint64_t m_EntSize;
 
   size_t m_Info;
   LDSection* m_pLink;
@@ -0,0 +1,93 @@
+//===- LazyDynSymbols.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_LAZYDYNSYMBOLS_H_
+#define MCLD_LD_LAZYDYNSYMBOLS_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+class ELFReaderIF;
+class Input;
+class IRBuilder;
+class NamePool;
+
+/** \class LazyDynSymbols
+ *  \brief LazyDynSymbols reads the defined symbols of shared libraries only
+ *  when they are referenced (--lazy-dso-symbols).
+ *
+ *  When a shared library is added, its undefined symbols are read at once,
+ *  and so are its definitions of the symbols which are undefined or common
+ *  in the name pool at that time. The other definitions are found later in
+ *  the .gnu.hash or .hash section of the library:
+ *
+ *  - IRBuilder asks for the name of every global symbol of a later input
+ *    before it resolves the symbol, so that the symbols are resolved in the
+ *    same order as with a full read,
+ *  - the standard and script symbols ask for their names before they check
+ *    whether they are referenced,
+ *  - resolveAll() asks for every symbol of the pool at the end of the input
+ *    reading, so that the symbols of the output which the libraries define
+ *    are exported as with a full read.
+ *
+ *  A definition of an object is read together with its aliases of the same
+ *  value, so that the weak alias lists are the same as with a full read.
+ */
+class LazyDynSymbols {
+ public:
+  explicit LazyDynSymbols(NamePool& pPool);
+
+  ~LazyDynSymbols();
+
+  /// add - read the symbols of the shared library pInput lazily.
+  /// @param pSymTab the contents of .dynsym
+  /// @param pStrTab the contents of .dynstr
+  /// @param pHash the contents of .gnu.hash, or .hash if pIsGNUHash is false
+  /// @return false if the hash table is malformed. The symbols of pInput
+  ///         should be read at once then.
+  bool add(const ELFReaderIF& pReader,
+           IRBuilder& pBuilder,
+           Input& pInput,
+           bool pIs64,
+           llvm::StringRef pSymTab,
+           llvm::StringRef pStrTab,
+           llvm::StringRef pHash,
+           bool pIsGNUHash);
+
+  /// resolve - read the definitions of pName in the libraries added before
+  /// pInput, or in all the libraries added so far if pInput is not one of
+  /// them. A library reading its own symbol asks only the libraries before
+  /// it, which a full read would have put into the pool first.
+  /// @return true if any symbol is read
+  bool resolve(llvm::StringRef pName, const Input* pInput = NULL);
+
+  /// resolveAll - read the definitions of the symbols in the name pool
+  void resolveAll();
+
+  bool empty() const { return m_Libraries.empty(); }
+
+ private:
+  class Library;
+
+ private:
+  NamePool& m_Pool;
+  std::vector<Library*> m_Libraries;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(LazyDynSymbols);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_LAZYDYNSYMBOLS_H_
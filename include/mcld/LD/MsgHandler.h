@@ -9,21 +9,28 @@
 #ifndef MCLD_LD_MSGHANDLER_H_
 #define MCLD_LD_MSGHANDLER_H_
 #include "mcld/LD/DiagnosticEngine.h"
+#include "mcld/Support/Compiler.h"
 #include "mcld/Support/Path.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ADT/Twine.h>
 
+#include <mutex>
 #include <string>
 
 namespace mcld {
 
 /** \class MsgHandler
  *  \brief MsgHandler controls the timing to output message.
+ *
+ *  A MsgHandler holds the lock of its DiagnosticEngine from its creation
+ *  until it emits the message. It can be moved but not copied, so exactly
+ *  one handler emits the message and releases the lock.
  */
 class MsgHandler {
  public:
   explicit MsgHandler(DiagnosticEngine& pEngine);
+  MsgHandler(MsgHandler&& pOther);
   ~MsgHandler();
 
   bool emit();
@@ -40,7 +47,11 @@ class MsgHandler {
 
  private:
   DiagnosticEngine& m_Engine;
+  std::unique_lock<std::recursive_mutex> m_Lock;
   mutable unsigned int m_NumArgs;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(MsgHandler);
 };
 
 inline const MsgHandler& operator<<(const MsgHandler& pHandler,
@@ -9,7 +9,7 @@
 #ifndef MCLD_LD_NAMEPOOL_H_
 #define MCLD_LD_NAMEPOOL_H_
 
-#include "mcld/ADT/HashTable.h"
+#include "mcld/ADT/FlatHashTable.h"
 #include "mcld/ADT/StringHash.h"
 #include "mcld/Config/Config.h"
 #include "mcld/LD/ResolveInfo.h"
@@ -18,8 +18,10 @@
 #include "mcld/Support/GCFactory.h"
 
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Allocator.h>
 
 #include <utility>
+#include <vector>
 
 namespace mcld {
 
@@ -27,12 +29,102 @@ namespace mcld {
  *  \brief Store symbol and search symbol by name. Can help symbol resolution.
  *
  *  - MCLinker is responsed for creating NamePool.
+ *
+ *  The names are spread over NumOfShards hash tables by their hash values.
+ *  lookupSymbols() fills the shards of a batch of names in parallel, one
+ *  thread per shard at a time. insertSymbol() resolves the symbols one by
+ *  one in input order, so the first definition of a name is the one of the
+ *  earliest input, and the diagnostics come in the same order for every
+ *  number of threads.
  */
 class NamePool {
  public:
-  typedef HashTable<ResolveInfo, hash::StringHash<hash::DJB> > Table;
-  typedef Table::iterator syminfo_iterator;
-  typedef Table::const_iterator const_syminfo_iterator;
+  /** \class InfoFactory
+   *  \brief InfoFactory creates the ResolveInfos of a shard in an arena,
+   *  instead of one heap allocation for each name. They are released with
+   *  the shard.
+   */
+  class InfoFactory {
+   public:
+    typedef ResolveInfo entry_type;
+    typedef ResolveInfo::key_type key_type;
+
+   public:
+    entry_type* produce(const key_type& pKey) {
+      return ResolveInfo::Create(pKey, m_Allocator);
+    }
+
+    void destroy(entry_type*& pEntry) { pEntry = NULL; }
+
+   private:
+    llvm::BumpPtrAllocator m_Allocator;
+  };
+
+  typedef FlatHashTable<ResolveInfo, hash::StringHash<hash::WY>, InfoFactory>
+      Table;
+
+  enum { NumOfShards = 16 };
+
+  /** \class SymInfoIteratorBase
+   *  \brief SymInfoIteratorBase traverses the shards one after another.
+   */
+  template <typename PoolTy, typename TableIteratorTy>
+  class SymInfoIteratorBase {
+   public:
+    SymInfoIteratorBase() : m_pPool(NULL), m_Shard(0), m_Iter() {}
+
+    SymInfoIteratorBase(PoolTy* pPool, unsigned pShard)
+        : m_pPool(pPool), m_Shard(pShard), m_Iter() {
+      if (m_Shard < NumOfShards)
+        m_Iter = m_pPool->m_Shards[m_Shard].begin();
+      skipEnd();
+    }
+
+    ResolveInfo* getEntry() const { return m_Iter.getEntry(); }
+
+    ResolveInfo& operator*() const { return *getEntry(); }
+
+    ResolveInfo* operator->() const { return getEntry(); }
+
+    SymInfoIteratorBase& operator++() {
+      ++m_Iter;
+      skipEnd();
+      return *this;
+    }
+
+    SymInfoIteratorBase operator++(int) {
+      SymInfoIteratorBase tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const SymInfoIteratorBase& pX) const {
+      return (getEntry() == pX.getEntry());
+    }
+
+    bool operator!=(const SymInfoIteratorBase& pX) const {
+      return !(*this == pX);
+    }
+
+   private:
+    /// skipEnd - move to the next non-empty shard at the end of a shard
+    void skipEnd() {
+      while (m_Shard < NumOfShards &&
+             m_Iter == m_pPool->m_Shards[m_Shard].end()) {
+        if (++m_Shard < NumOfShards)
+          m_Iter = m_pPool->m_Shards[m_Shard].begin();
+      }
+    }
+
+   private:
+    PoolTy* m_pPool;
+    unsigned m_Shard;
+    TableIteratorTy m_Iter;
+  };
+
+  typedef SymInfoIteratorBase<NamePool, Table::iterator> syminfo_iterator;
+  typedef SymInfoIteratorBase<const NamePool, Table::const_iterator>
+      const_syminfo_iterator;
 
   typedef GCFactory<ResolveInfo*, 128> FreeInfoSet;
   typedef FreeInfoSet::iterator freeinfo_iterator;
@@ -74,11 +166,36 @@ class NamePool {
                     ResolveInfo* pOldInfo,
                     Resolver::Result& pResult);
 
+  /// insertSymbol - the same as above, but the name is already in the pool.
+  /// @param pEntry - the entry of the name returned by lookupSymbols
+  void insertSymbol(ResolveInfo& pEntry,
+                    bool pIsDyn,
+                    ResolveInfo::Type pType,
+                    ResolveInfo::Desc pDesc,
+                    ResolveInfo::Binding pBinding,
+                    ResolveInfo::SizeType pSize,
+                    LDSymbol::ValueType pValue,
+                    ResolveInfo::Visibility pVisibility,
+                    ResolveInfo* pOldInfo,
+                    Resolver::Result& pResult);
+
+  /// lookupSymbols - find or create the entries of pNames, and keep them in
+  /// pEntries in the same order. The names are hashed by up to pNumThreads
+  /// threads, and then every shard is filled by one thread in the order of
+  /// pNames, so the layout of the pool does not depend on the number of
+  /// threads. Symbol resolution itself is not done here: passing the entries
+  /// to insertSymbol in the order of the inputs keeps the first-come priority
+  /// of the inputs.
+  void lookupSymbols(const std::vector<llvm::StringRef>& pNames,
+                     std::vector<ResolveInfo*>& pEntries,
+                     unsigned pNumThreads);
+
   /// findSymbol - find the resolved output LDSymbol
   const LDSymbol* findSymbol(const llvm::StringRef& pName) const;
   LDSymbol* findSymbol(const llvm::StringRef& pName);
 
-  /// findInfo - find the resolved ResolveInfo
+  /// findInfo - find the resolved ResolveInfo. Names that are only looked up
+  /// by lookupSymbols but never inserted as symbols are not found.
   const ResolveInfo* findInfo(const llvm::StringRef& pName) const;
   ResolveInfo* findInfo(const llvm::StringRef& pName);
 
@@ -88,18 +205,22 @@ class NamePool {
   llvm::StringRef insertString(const llvm::StringRef& pString);
 
   // -----  observers  ----- //
-  size_type size() const { return m_Table.numOfEntries(); }
+  size_type size() const;
 
-  bool empty() const { return m_Table.empty(); }
+  bool empty() const { return (0 == size()); }
 
-  // syminfo_iterator - traverse the ResolveInfo in the resolved HashTable
-  syminfo_iterator syminfo_begin() { return m_Table.begin(); }
+  // syminfo_iterator - traverse the ResolveInfo in the resolved hash tables
+  syminfo_iterator syminfo_begin() { return syminfo_iterator(this, 0); }
 
-  syminfo_iterator syminfo_end() { return m_Table.end(); }
+  syminfo_iterator syminfo_end() { return syminfo_iterator(); }
 
-  const_syminfo_iterator syminfo_begin() const { return m_Table.begin(); }
+  const_syminfo_iterator syminfo_begin() const {
+    return const_syminfo_iterator(this, 0);
+  }
 
-  const_syminfo_iterator syminfo_end() const { return m_Table.end(); }
+  const_syminfo_iterator syminfo_end() const {
+    return const_syminfo_iterator();
+  }
 
   // freeinfo_iterator - traverse the ResolveInfo those do not need to be
   // resolved, for example, local symbols
@@ -118,10 +239,27 @@ class NamePool {
 
   size_type capacity() const;
 
+ private:
+  /// getShard - the shard of the name whose hash value is pHashValue. The
+  /// bits are taken below the bits FlatHashTable keeps in its control bytes.
+  static unsigned getShard(uint32_t pHashValue) {
+    return (pHashValue >> 21) & (NumOfShards - 1);
+  }
+
+  ResolveInfo* lookup(const llvm::StringRef& pName);
+
+  /// getScratchInfo - a ResolveInfo named pName for the symbol which is
+  /// resolved against an existing one. It is reused by the next call.
+  ResolveInfo* getScratchInfo(const llvm::StringRef& pName);
+
  private:
   Resolver* m_pResolver;
-  Table m_Table;
+  Table m_Shards[NumOfShards];
   FreeInfoSet m_FreeInfoSet;
+  /// m_FreeInfoAllocator - the arena of the ResolveInfos in m_FreeInfoSet
+  llvm::BumpPtrAllocator m_FreeInfoAllocator;
+  /// m_Scratch - the memory of the scratch ResolveInfo
+  std::vector<uint64_t> m_Scratch;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(NamePool);
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #ifndef MCLD_LD_OBJECTWRITER_H_
 #define MCLD_LD_OBJECTWRITER_H_
+#include <functional>
 #include <system_error>
 
 namespace mcld {
@@ -28,6 +29,15 @@ class ObjectWriter {
   virtual std::error_code writeObject(Module& pModule,
                                       FileOutputBuffer& pOutput) = 0;
 
+  /// writeObject - write out the object and call pApply to apply the
+  /// relocations straight into pOutput. pApply is called once the contents
+  /// of the input sections are written. The sections filled by applying
+  /// relocations, such as GOT and dynamic relocations, are written after it,
+  /// so every section is written once.
+  virtual std::error_code writeObject(Module& pModule,
+                                      FileOutputBuffer& pOutput,
+                                      const std::function<void()>& pApply) = 0;
+
   virtual size_t getOutputSize(const Module& pModule) const = 0;
 };
 
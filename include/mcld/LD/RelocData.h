@@ -12,6 +12,7 @@
 #include "mcld/ADT/ilist_sort.h"
 #include "mcld/Config/Config.h"
 #include "mcld/Fragment/Relocation.h"
+#include "mcld/LD/RelocTable.h"
 #include "mcld/Support/Allocators.h"
 #include "mcld/Support/Compiler.h"
 #include "mcld/Support/GCFactoryListTraits.h"
@@ -73,6 +74,10 @@ class RelocData {
   RelocData& append(Relocation& pRelocation);
   Relocation& remove(Relocation& pRelocation);
 
+  /// getTable - the input relocations which are not materialized yet
+  const RelocTable& getTable() const { return m_Table; }
+  RelocTable& getTable() { return m_Table; }
+
   const_reference front() const { return m_Relocations.front(); }
   reference front() { return m_Relocations.front(); }
   const_reference back() const { return m_Relocations.back(); }
@@ -94,6 +99,7 @@ class RelocData {
 
  private:
   RelocationListType m_Relocations;
+  RelocTable m_Table;
   LDSection* m_pSection;
 
  private:
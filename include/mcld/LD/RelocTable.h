@@ -0,0 +1,70 @@
+//===- RelocTable.h -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_RELOCTABLE_H_
+#define MCLD_LD_RELOCTABLE_H_
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+namespace mcld {
+
+class ELFReaderIF;
+class Input;
+class LDSection;
+
+/** \class RelocTable
+ *  \brief RelocTable keeps the mapped relocation records of an input
+ *  relocation section until a pass needs its Relocations.
+ *
+ *  Reading the relocations only keeps the records of the section.
+ *  materialize() decodes them into Relocations when a pass first walks the
+ *  section, so the records of a section which is discarded before that are
+ *  never decoded. Each record is decoded once.
+ */
+class RelocTable {
+ public:
+  RelocTable() : m_pReader(NULL), m_pInput(NULL), m_pSection(NULL) {}
+
+  /// setSource - keep the records of pSection mapped from pInput. They are
+  /// decoded by pReader on materialize().
+  void setSource(const ELFReaderIF& pReader,
+                 Input& pInput,
+                 LDSection& pSection,
+                 llvm::StringRef pRecords) {
+    m_pReader = &pReader;
+    m_pInput = &pInput;
+    m_pSection = &pSection;
+    m_Records = pRecords;
+  }
+
+  /// isMaterialized - whether there are no pending records
+  bool isMaterialized() const { return m_pReader == NULL; }
+
+  /// materialize - create the Relocations of the section from the pending
+  /// records
+  /// @return false if the records are malformed
+  bool materialize();
+
+  /// clear - drop the pending records without decoding them
+  void clear() {
+    m_pReader = NULL;
+    m_Records = llvm::StringRef();
+  }
+
+ private:
+  // the pending records
+  const ELFReaderIF* m_pReader;
+  Input* m_pInput;
+  LDSection* m_pSection;
+  llvm::StringRef m_Records;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_RELOCTABLE_H_
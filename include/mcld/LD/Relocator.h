@@ -11,6 +11,8 @@
 
 #include "mcld/Fragment/Relocation.h"
 
+#include <mutex>
+
 namespace mcld {
 
 class Input;
@@ -80,6 +82,17 @@ class Relocator {
   /// @return - return true for finalization success
   virtual bool finalizeApply(Input& pInput) { return true; }
 
+  /// isConcurrentApplySafe - return true if applyRelocation() and the
+  /// initializeApply()/finalizeApply() hooks can run for different inputs on
+  /// different threads at the same time. Targets which keep per-input state
+  /// while applying return false, and their relocations are applied serially.
+  virtual bool isConcurrentApplySafe() const { return false; }
+
+  /// getApplyMutex - the lock guarding the entries shared by relocations
+  /// of different inputs (e.g., GOT entries whose value is filled lazily by
+  /// the first relocation applied to them).
+  std::mutex& getApplyMutex() { return m_ApplyMutex; }
+
   /// partialScanRelocation - When doing partial linking, backend can do any
   /// modification to relocation to fix the relocation offset after section
   /// merge
@@ -121,6 +134,8 @@ class Relocator {
 
  private:
   const LinkerConfig& m_Config;
+
+  std::mutex m_ApplyMutex;
 };
 
 }  // namespace mcld
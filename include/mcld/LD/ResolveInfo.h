@@ -10,6 +10,7 @@
 #define MCLD_LD_RESOLVEINFO_H_
 
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Allocator.h>
 #include <llvm/Support/DataTypes.h>
 
 namespace mcld {
@@ -36,6 +37,7 @@ class LinkerConfig;
 class ResolveInfo {
   friend class FragmentLinker;
   friend class IRBuilder;
+  friend class NamePool;
 
  public:
   typedef uint64_t SizeType;
@@ -78,6 +80,11 @@ class ResolveInfo {
   // -----  factory method  ----- //
   static ResolveInfo* Create(const key_type& pKey);
 
+  /// Create - create a ResolveInfo in pAllocator. It is released with
+  /// pAllocator and must not be destroyed by Destroy().
+  static ResolveInfo* Create(const key_type& pKey,
+                             llvm::BumpPtrAllocator& pAllocator);
+
   static void Destroy(ResolveInfo*& pInfo);
 
   static ResolveInfo* Null();
@@ -255,6 +262,9 @@ class ResolveInfo {
   ResolveInfo& operator=(const ResolveInfo& pCopy);
   ~ResolveInfo();
 
+  /// construct - construct a ResolveInfo named pKey at pMemory
+  static ResolveInfo* construct(void* pMemory, const key_type& pKey);
+
  private:
   SizeType m_Size;
   SymOrInfo m_Ptr;
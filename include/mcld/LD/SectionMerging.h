@@ -0,0 +1,117 @@
+//===- SectionMerging.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_SECTIONMERGING_H_
+#define MCLD_LD_SECTIONMERGING_H_
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+class Fragment;
+class Input;
+class LDSection;
+class LinkerConfig;
+class Module;
+
+/** \class SectionMerging
+ *  \brief Implementation of --merge-sections for SHF_MERGE input sections.
+ *
+ *  The mergeable input sections which go to the same place of the same
+ *  output section and have the same flags, entry size and alignment form a
+ *  group. Every section of a group is split into pieces, which are the
+ *  NUL-terminated strings of a SHF_STRINGS section or the sh_entsize-byte
+ *  constants of the others, and each distinct piece is kept only once. With
+ *  --tail-merge-strings, a string which is the tail of another string is
+ *  placed inside the longer one.
+ *
+ *  The first section of a group carries the merged contents and the others
+ *  are folded. The symbols defined in the group, and the relocations against
+ *  its section symbols, are redirected to the merged pieces.
+ */
+class SectionMerging {
+ public:
+  SectionMerging(const LinkerConfig& pConfig, Module& pModule);
+  ~SectionMerging();
+
+  /// run - merge the mergeable input sections
+  void run();
+
+ private:
+  /** \struct Piece
+   *  \brief a string or a constant of a mergeable input section
+   */
+  struct Piece {
+    uint32_t InputOffset;
+    uint32_t Size;
+    uint32_t Hash;
+    /// Leader - the first piece of the group with the same contents
+    Piece* Leader;
+    uint64_t OutputOffset;
+  };
+
+  /** \struct Member
+   *  \brief a mergeable input section
+   */
+  struct Member {
+    Input* Obj;
+    LDSection* Section;
+    /// Frag - the RegionFragment holding the input contents
+    Fragment* Frag;
+    llvm::StringRef Data;
+    std::vector<Piece> Pieces;
+  };
+
+  /** \struct Group
+   *  \brief the input sections whose pieces are merged together
+   */
+  struct Group {
+    std::vector<Member> Members;
+    uint64_t EntSize;
+    uint32_t Align;
+    bool IsString;
+    /// Contents - the merged pieces
+    std::vector<char> Contents;
+    /// Frag - the fragment of Contents, which replaces the input fragment of
+    /// the first member
+    Fragment* Frag;
+  };
+
+ private:
+  /// collect - find the mergeable input sections and group them
+  void collect();
+
+  /// split - split the contents of pMember into pieces and hash them
+  static void split(const Group& pGroup, Member& pMember);
+
+  /// deduplicate - set the leaders of the pieces of pGroup in the shard
+  /// pShard
+  static void deduplicate(Group& pGroup, unsigned pShard);
+
+  /// layout - assign the output offsets of the pieces and fill the contents
+  void layout(Group& pGroup);
+
+  /// redirect - redirect the symbols and relocations to the merged pieces
+  void redirect();
+
+  /// getOutputOffset - the offset of pOffset of pMember in the merged contents
+  static uint64_t getOutputOffset(const Member& pMember, uint64_t pOffset);
+
+ private:
+  const LinkerConfig& m_Config;
+  Module& m_Module;
+
+  std::vector<Group*> m_Groups;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_SECTIONMERGING_H_
@@ -9,6 +9,7 @@
 #ifndef MCLD_LD_STUBFACTORY_H_
 #define MCLD_LD_STUBFACTORY_H_
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/Support/DataTypes.h>
 
 #include <vector>
@@ -19,6 +20,7 @@ class BranchIslandFactory;
 class IRBuilder;
 class FragmentRef;
 class Relocation;
+class ResolveInfo;
 class Stub;
 
 /** \class StubFactory
@@ -27,12 +29,18 @@ class Stub;
  */
 class StubFactory {
  public:
+  StubFactory();
+
   ~StubFactory();
 
   /// addPrototype - register a stub prototype
   void addPrototype(Stub* pPrototype);
 
   /// create - create a stub if needed, otherwise return NULL
+  ///
+  /// A relocation which did not need a stub is not examined again until its
+  /// place or target moves, so relaxation passes only pay for the branches
+  /// whose distance changed.
   Stub* create(Relocation& pReloc,
                uint64_t pTargetSymValue,
                IRBuilder& pBuilder,
@@ -51,11 +59,37 @@ class StubFactory {
 
   Stub* findPrototype(const FragmentRef& pFragRef) const;
 
+ public:
+  /// numOfExamined - the number of branches examined by create
+  size_t numOfExamined() const { return m_NumOfExamined; }
+
+  /// numOfSkipped - the number of branches create skipped because they did
+  /// not move since they were examined
+  size_t numOfSkipped() const { return m_NumOfSkipped; }
+
+  /// numOfStubs - the number of stubs created
+  size_t numOfStubs() const { return m_NumOfStubs; }
+
  private:
   typedef std::vector<Stub*> StubPoolType;
 
+  /** \struct Branch
+   *  \brief a branch which did not need a stub when it was examined
+   */
+  struct Branch {
+    uint64_t Place;
+    uint64_t Target;
+    const ResolveInfo* Symbol;
+  };
+
+  typedef llvm::DenseMap<const Relocation*, Branch> BranchMap;
+
  private:
   StubPoolType m_StubPool;  // stub pool
+  BranchMap m_Examined;
+  size_t m_NumOfExamined;
+  size_t m_NumOfSkipped;
+  size_t m_NumOfStubs;
 };
 
 }  // namespace mcld
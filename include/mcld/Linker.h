@@ -18,6 +18,7 @@ class FileOutputBuffer;
 class IRBuilder;
 class LinkerConfig;
 class LinkerScript;
+class LinkerStats;
 class Module;
 class ObjectLinker;
 class Target;
@@ -75,6 +76,7 @@ class Linker {
   const Target* m_pTarget;
   TargetLDBackend* m_pBackend;
   ObjectLinker* m_pObjLinker;
+  LinkerStats* m_pStats;  // --time-report, --stats
 };
 
 }  // namespace mcld
@@ -11,6 +11,7 @@
 #include "mcld/Support/Directory.h"
 #include "mcld/Support/FileSystem.h"
 
+#include <llvm/ADT/StringMap.h>
 #include <llvm/ADT/StringRef.h>
 
 #include <string>
@@ -20,6 +21,8 @@ namespace mcld {
 /** \class MCLDDirectory
  *  \brief MCLDDirectory is an directory entry for library search.
  *
+ *  The first find() reads the whole directory and indexes the entries by
+ *  file name, so a search for a library is a hash lookup.
  */
 class MCLDDirectory : public sys::fs::Directory {
  public:
@@ -38,9 +41,16 @@ class MCLDDirectory : public sys::fs::Directory {
 
   const std::string& name() const { return m_Name; }
 
+  /// find - the entry whose file name is pFileName, or NULL
+  sys::fs::Path* find(llvm::StringRef pFileName);
+
  private:
   std::string m_Name;
   bool m_bInSysroot;
+
+  /// m_Index - the entries by file name, built on the first find
+  llvm::StringMap<sys::fs::Path*> m_Index;
+  bool m_bIndexed;
 };
 
 }  // namespace mcld
@@ -38,6 +38,8 @@ class ZOption {
     Lazy,
     Now,
     Origin,
+    PackRelativeRelocs,
+    NoPackRelativeRelocs,
     CommPageSize,
     MaxPageSize,
     Unknown
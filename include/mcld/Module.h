@@ -14,10 +14,13 @@
 #define MCLD_MODULE_H_
 
 #include "mcld/InputTree.h"
+#include "mcld/LD/LazyDynSymbols.h"
 #include "mcld/LD/NamePool.h"
 #include "mcld/LD/SectionSymbolSet.h"
 #include "mcld/MC/SymbolCategory.h"
 
+#include <llvm/ADT/StringMap.h>
+
 #include <vector>
 #include <string>
 
@@ -104,7 +107,13 @@ class Module {
 
   // -----  sections  ----- //
   const SectionTable& getSectionTable() const { return m_SectionTable; }
-  SectionTable& getSectionTable() { return m_SectionTable; }
+
+  /// appendSection - append pSection to the section table. getSection finds
+  /// the first section appended with a name.
+  Module& appendSection(LDSection& pSection);
+
+  /// clearSections - remove all sections from the section table
+  void clearSections();
 
   iterator begin() { return m_SectionTable.begin(); }
   const_iterator begin() const { return m_SectionTable.begin(); }
@@ -152,6 +161,10 @@ class Module {
   const NamePool& getNamePool() const { return m_NamePool; }
   NamePool& getNamePool() { return m_NamePool; }
 
+  /// getLazyDynSymbols - the shared libraries read with --lazy-dso-symbols
+  const LazyDynSymbols& getLazyDynSymbols() const { return m_LazyDynSymbols; }
+  LazyDynSymbols& getLazyDynSymbols() { return m_LazyDynSymbols; }
+
   // -----  Aliases  ----- //
   // create an alias list for pSym, the aliases of pSym
   // can be added into the list by calling addAlias
@@ -168,8 +181,11 @@ class Module {
   LibraryList m_LibraryList;
   InputTree m_MainTree;
   SectionTable m_SectionTable;
+  /// m_SectionIndex - the first section of each name in m_SectionTable
+  llvm::StringMap<LDSection*> m_SectionIndex;
   SymbolTable m_SymbolTable;
   NamePool m_NamePool;
+  LazyDynSymbols m_LazyDynSymbols;
   SectionSymbolSet m_SectSymbolSet;
   std::vector<AliasList*> m_AliasLists;
 };
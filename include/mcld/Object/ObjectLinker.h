@@ -20,14 +20,18 @@ class DynObjWriter;
 class ExecWriter;
 class FileOutputBuffer;
 class GroupReader;
+class Input;
 class IRBuilder;
 class LinkerConfig;
+class LinkerStats;
 class Module;
 class ObjectReader;
 class ObjectWriter;
+class LDSection;
 class Relocation;
 class ResolveInfo;
 class ScriptReader;
+class SectionMerging;
 class TargetLDBackend;
 
 /** \class ObjectLinker
@@ -123,6 +127,10 @@ class ObjectLinker {
   /// postProcessing - do modificatiion after all processes
   bool postProcessing(FileOutputBuffer& pOutput);
 
+  /// collectStats - count the inputs, sections, fragments, symbols and
+  /// relocations of the link for --stats
+  void collectStats(LinkerStats& pStats) const;
+
   // -----  readers and writers  ----- //
   const ObjectReader* getObjectReader() const { return m_pObjectReader; }
   ObjectReader* getObjectReader() { return m_pObjectReader; }
@@ -146,6 +154,29 @@ class ObjectLinker {
   ObjectWriter* getWriter() { return m_pWriter; }
 
  private:
+  /// prefetchInputs - decode the ELF tables of all object and shared object
+  /// inputs by --threads workers before normalize reads them in order.
+  void prefetchInputs();
+
+  /// materializeRelocations - create the Relocations of the input relocation
+  /// sections which are kept, from their RelocTables
+  void materializeRelocations();
+
+  /// applyAllRelocations - apply the relocations of all inputs, branch islands
+  /// and the LD backend. If pOutput is not NULL, each result is written into
+  /// the output buffer right after it is applied.
+  void applyAllRelocations(uint8_t* pOutput);
+
+  /// applyRelocations - apply all relocations of pInput. When --threads is
+  /// given, it is called for different inputs at the same time.
+  void applyRelocations(Input& pInput,
+                        LDSection* pDebugStrSect,
+                        uint8_t* pOutput);
+
+  /// isDirectRelocation - whether relocations are applied directly into the
+  /// output buffer by emitOutput instead of being synced by postProcessing
+  bool isDirectRelocation() const;
+
   /// normalSyncRelocationResult - sync relocation result when producing shared
   /// objects or executables
   void normalSyncRelocationResult(FileOutputBuffer& pOutput);
@@ -177,6 +208,9 @@ class ObjectLinker {
   BinaryReader* m_pBinaryReader;
   ScriptReader* m_pScriptReader;
   ObjectWriter* m_pWriter;
+
+  /// m_pSectionMerging - owns the merged contents of SHF_MERGE sections
+  SectionMerging* m_pSectionMerging;
 };
 
 }  // namespace mcld
@@ -22,9 +22,14 @@ namespace mcld {
 
 class Fragment;
 class LDSection;
+class SectionMatcher;
 
 /** \class SectionMap
  *  \brief descirbe how to map input sections into output sections
+ *
+ *  find(file, section) compiles the descriptions into a SectionMatcher on
+ *  first use. Inserting a description, or fixing the section order, drops the
+ *  matcher, and the next find builds it again.
  */
 class SectionMap {
  public:
@@ -155,6 +160,7 @@ class SectionMap {
   typedef OutputDescList::reverse_iterator reverse_iterator;
 
  public:
+  SectionMap();
   ~SectionMap();
 
   const_mapping find(const std::string& pInputFile,
@@ -194,15 +200,20 @@ class SectionMap {
   // fixupDotSymbols - ensure the dot assignments are valid
   void fixupDotSymbols();
 
+  /// matched - whether pName matches pPattern
+  static bool matched(const WildcardPattern& pPattern,
+                      const std::string& pName);
+
  private:
-  bool matched(const Input& pInput,
-               const std::string& pInputFile,
-               const std::string& pInputSection) const;
+  /// getMatcher - the matcher of the current descriptions
+  SectionMatcher& getMatcher() const;
 
-  bool matched(const WildcardPattern& pPattern, const std::string& pName) const;
+  /// resetMatcher - drop the matcher after the descriptions change
+  void resetMatcher();
 
  private:
   OutputDescList m_OutputDescList;
+  mutable SectionMatcher* m_pMatcher;
 };
 
 }  // namespace mcld
@@ -0,0 +1,107 @@
+//===- SectionMatcher.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_OBJECT_SECTIONMATCHER_H_
+#define MCLD_OBJECT_SECTIONMATCHER_H_
+
+#include "mcld/Object/SectionMap.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+class StringList;
+class WildcardPattern;
+
+/** \class SectionMatcher
+ *  \brief SectionMatcher compiles the input section descriptions of a
+ *  SectionMap, so that finding the description of an input section does not
+ *  test every pattern.
+ *
+ *  The descriptions are numbered in the order SectionMap::find tries them,
+ *  and the first one which matches wins, as in SectionMap::find.
+ *
+ *  - exact section names are kept in a hash table,
+ *  - prefix patterns (`.text.*') are kept in a trie,
+ *  - the other globs are tried one by one, but only while they may give an
+ *    earlier description than the one found so far.
+ *
+ *  The file patterns and exclude lists of the descriptions are evaluated once
+ *  for each input file. The files with the same results form a class, and
+ *  the result of a lookup is cached for each (class, section name).
+ */
+class SectionMatcher {
+ public:
+  explicit SectionMatcher(const SectionMap& pMap);
+
+  /// find - the first description matching pInputSection of pInputFile
+  SectionMap::mapping find(const std::string& pInputFile,
+                           const std::string& pInputSection);
+
+ private:
+  /// the rule index of no match
+  static const uint32_t NoMatch = ~uint32_t(0);
+
+  /// the file condition index of the rules without file pattern or
+  /// exclude list
+  static const uint32_t AnyFile = ~uint32_t(0);
+
+  struct Rule {
+    SectionMap::mapping Mapping;
+    uint32_t FileCond;
+  };
+
+  struct FileCond {
+    const WildcardPattern* File;
+    const StringList* ExcludeFiles;
+  };
+
+  struct TrieNode {
+    std::map<char, uint32_t> Children;
+    std::vector<uint32_t> Rules;
+  };
+
+  typedef std::vector<bool> FileClass;
+
+ private:
+  void addPattern(const WildcardPattern& pPattern, uint32_t pRule);
+
+  /// getFileClass - the class of pInputFile
+  uint32_t getFileClass(const std::string& pInputFile);
+
+  /// matchFile - whether the input files of class pClass may use pRule
+  bool matchFile(uint32_t pRule, uint32_t pClass) const;
+
+  /// lookup - find the first rule matching pInputSection in the files of
+  /// class pClass
+  uint32_t lookup(uint32_t pClass, const std::string& pInputSection) const;
+
+ private:
+  std::vector<Rule> m_Rules;
+  std::vector<FileCond> m_FileConds;
+
+  llvm::StringMap<std::vector<uint32_t> > m_ExactNames;
+  std::vector<TrieNode> m_Prefixes;
+  std::vector<std::pair<const WildcardPattern*, uint32_t> > m_Globs;
+
+  llvm::StringMap<uint32_t> m_FileClassOf;
+  std::map<FileClass, uint32_t> m_FileClassIds;
+  std::vector<FileClass> m_FileClasses;
+
+  /// m_Cache - the result of each section name for each file class
+  std::vector<llvm::StringMap<uint32_t> > m_Cache;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_OBJECT_SECTIONMATCHER_H_
@@ -0,0 +1,114 @@
+//===- LinkerStats.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_LINKERSTATS_H_
+#define MCLD_SUPPORT_LINKERSTATS_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/Support/DataTypes.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}  // namespace llvm
+
+namespace mcld {
+
+/** \class LinkerStats
+ *  \brief LinkerStats collects the time spent in each linking phase and the
+ *  size of the link for --time-report and --stats.
+ *
+ *  Phases are reported in the order they first start. A phase which runs
+ *  more than once accumulates its time. A phase started while another one is
+ *  running is reported under it and is not added to the total. CPU time is
+ *  the time of the whole process, so a phase running on several threads may
+ *  take more CPU time than wall time.
+ */
+class LinkerStats {
+ public:
+  struct Phase {
+    std::string Name;
+    unsigned Depth;  // the number of enclosing phases
+    double Wall;  // milliseconds
+    double CPU;   // milliseconds
+  };
+
+  struct Counter {
+    std::string Name;
+    uint64_t Value;
+  };
+
+  typedef std::vector<Phase> PhaseList;
+  typedef std::vector<Counter> CounterList;
+
+  /** \class Timer
+   *  \brief Timer measures the phase pName for its lifetime. It does nothing
+   *  if there is no LinkerStats.
+   */
+  class Timer {
+   public:
+    Timer(LinkerStats* pStats, const char* pName);
+    ~Timer();
+
+   private:
+    LinkerStats* m_pStats;
+    size_t m_Phase;
+    std::chrono::steady_clock::time_point m_WallStart;
+    double m_CPUStart;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(Timer);
+  };
+
+ public:
+  LinkerStats(bool pTimeReport, bool pCounters, bool pJSON);
+
+  /// beginPhase - start a run of phase pName within the running phases
+  /// @return the index of the phase
+  size_t beginPhase(const std::string& pName);
+
+  /// endPhase - end the run of the phase at pPhase and add its time
+  void endPhase(size_t pPhase, double pWall, double pCPU);
+
+  /// setCounter - set the counter pName to pValue
+  void setCounter(const std::string& pName, uint64_t pValue);
+
+  /// print - print the report enabled at construction
+  void print(llvm::raw_ostream& pOS) const;
+
+  const PhaseList& phases() const { return m_Phases; }
+
+  const CounterList& counters() const { return m_Counters; }
+
+  /// elapsed - the milliseconds since pStart
+  static double elapsed(std::chrono::steady_clock::time_point pStart);
+
+  /// formatTime - pMilliseconds for a diagnostic, with two decimals
+  static std::string formatTime(double pMilliseconds);
+
+ private:
+  void printText(llvm::raw_ostream& pOS) const;
+
+  void printJSON(llvm::raw_ostream& pOS) const;
+
+ private:
+  PhaseList m_Phases;
+  CounterList m_Counters;
+  unsigned m_Depth;
+  bool m_bTimeReport;
+  bool m_bCounters;
+  bool m_bJSON;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_LINKERSTATS_H_
@@ -39,6 +39,10 @@ class MemoryArea {
 
   size_t size() const;
 
+  // release - drop the resident pages of the area if it is mapped from a
+  // file. The regions requested before stay valid.
+  void release();
+
  private:
   std::unique_ptr<llvm::MemoryBuffer> m_pMemoryBuffer;
 
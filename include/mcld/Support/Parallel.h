@@ -0,0 +1,51 @@
+//===- Parallel.h ---------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_PARALLEL_H_
+#define MCLD_SUPPORT_PARALLEL_H_
+
+#include <llvm/Support/DataTypes.h>
+
+#include <functional>
+#include <iterator>
+
+namespace mcld {
+namespace parallel {
+
+/// getHardwareConcurrency - the number of threads the host can run at once.
+/// Never returns zero.
+unsigned getHardwareConcurrency();
+
+/// forEachN - call pFunc(i) for every i in [pBegin, pEnd) by at most
+/// pNumThreads threads. Indices are handed out dynamically, so a worker that
+/// finishes early steals the remaining work. The calling thread is one of the
+/// workers, and all calls have returned when forEachN returns.
+///
+/// If pNumThreads is less than 2 or there is only one index, pFunc is simply
+/// called in order on the calling thread.
+void forEachN(unsigned pNumThreads,
+              size_t pBegin,
+              size_t pEnd,
+              const std::function<void(size_t)>& pFunc);
+
+/// forEach - call pFunc(*it) for every element in a random access range.
+template <typename RandomAccessIterator, typename Function>
+void forEach(unsigned pNumThreads,
+             RandomAccessIterator pBegin,
+             RandomAccessIterator pEnd,
+             Function pFunc) {
+  forEachN(pNumThreads,
+           0,
+           std::distance(pBegin, pEnd),
+           [&pBegin, &pFunc](size_t pIdx) { pFunc(*(pBegin + pIdx)); });
+}
+
+}  // namespace parallel
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_PARALLEL_H_
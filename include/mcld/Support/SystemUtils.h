@@ -36,6 +36,19 @@ long GetRandomNum();
 /// SetRandomSeed - set the initial seed value for future calls to random().
 void SetRandomSeed(unsigned pSeed);
 
+/// GetProcessCPUTime - the user and system time consumed by all threads of
+/// the process so far, in seconds.
+double GetProcessCPUTime();
+
+/// GetPeakRSS - the peak resident set size of the process in bytes, or 0 if
+/// the host can not tell.
+uint64_t GetPeakRSS();
+
+/// ReleasePages - drop the resident pages of the file mapping at
+/// [pAddr, pAddr + pSize). The contents stay valid, and the pages are read
+/// from the file again when they are touched.
+void ReleasePages(const void* pAddr, size_t pSize);
+
 }  // namespace sys
 }  // namespace mcld
 
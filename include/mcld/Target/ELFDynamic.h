@@ -167,6 +167,10 @@ class ELFDynamic {
 
   size_t symbolSize() const;
 
+  /// numOfRelativeRelocs - the value of DT_RELCOUNT or DT_RELACOUNT of the
+  /// dynamic relocation section pSection
+  size_t numOfRelativeRelocs(const LDSection& pSection) const;
+
   const LinkerConfig& config() const { return m_Config; }
 
  private:
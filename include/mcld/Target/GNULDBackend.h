@@ -20,6 +20,7 @@
 #include <llvm/Support/ELF.h>
 
 #include <cstdint>
+#include <vector>
 
 namespace mcld {
 
@@ -326,6 +327,18 @@ class GNULDBackend : public TargetLDBackend {
   /// process relocations more efficiently
   void sortRelocation(LDSection& pSection);
 
+  /// getRelativeRelocType - the type of the relative dynamic relocation of the
+  /// target. Return 0x0 if the target does not tell it.
+  virtual uint32_t getRelativeRelocType() const { return 0x0; }
+
+  /// numOfRelativeRelocs - the number of relative relocations in the dynamic
+  /// relocation section pSection (DT_RELCOUNT and DT_RELACOUNT)
+  size_t numOfRelativeRelocs(const LDSection& pSection) const;
+
+  /// getSectionsChangedByApply - get the GOT and the dynamic relocation
+  /// sections of the output
+  void getSectionsChangedByApply(std::vector<LDSection*>& pSections);
+
   /// createAndSizeEhFrameHdr - This is seperated since we may add eh_frame
   /// entry in the middle
   void createAndSizeEhFrameHdr(Module& pModule);
@@ -347,6 +360,14 @@ class GNULDBackend : public TargetLDBackend {
   /// getRelEntrySize - the size in BYTE of rela type relocation
   virtual size_t getRelaEntrySize() = 0;
 
+  /// packRelativeRelocs - move the relative relocations of pRelDyn to
+  /// .relr.dyn for -z pack-relative-relocs, and reserve .relr.dyn. The
+  /// relocations whose places may not be word-aligned are kept in pRelDyn.
+  void packRelativeRelocs(LDSection& pRelDyn);
+
+  /// emitRelrDyn - emit the encoded .relr.dyn
+  uint64_t emitRelrDyn(MemoryRegion& pRegion) const;
+
   uint64_t getSymbolSize(const LDSymbol& pSymbol) const;
 
   uint64_t getSymbolInfo(const LDSymbol& pSymbol) const;
@@ -361,9 +382,30 @@ class GNULDBackend : public TargetLDBackend {
   /// getHashBucketCount - calculate hash bucket count.
   static unsigned getHashBucketCount(unsigned pNumOfSymbols, bool pIsGNUStyle);
 
+  /// getGNUHashBucketCount - calculate the bucket count of .gnu.hash, from
+  /// --gnu-hash-load-factor if it is given
+  unsigned getGNUHashBucketCount(unsigned pNumOfSymbols) const;
+
   /// getGNUHashMaskbitslog2 - calculate the number of mask bits in log2
   unsigned getGNUHashMaskbitslog2(unsigned pNumOfSymbols) const;
 
+  /// getNameOffsets - compute the string table offsets of the names of the
+  /// symbols [pBegin, pEnd). The names of the i-th block of symbols start at
+  /// pOffsets[i], relative to the first name.
+  /// @return the total size of the names
+  size_t getNameOffsets(Module::const_sym_iterator pBegin,
+                        Module::const_sym_iterator pEnd,
+                        std::vector<size_t>& pOffsets) const;
+
+  /// emitSymbols - emit the symbols [pBegin, pEnd) from index 1 of the symbol
+  /// table and their names from offset 1 of the string table. The blocks of
+  /// symbols are emitted in parallel.
+  /// @return the size of the string table
+  size_t emitSymbols(Module::const_sym_iterator pBegin,
+                     Module::const_sym_iterator pEnd,
+                     MemoryRegion& pSymtab,
+                     char* pStrtab);
+
   /// emitSymbol32 - emit an ELF32 symbol
   void emitSymbol32(llvm::ELF::Elf32_Sym& pSym32,
                     LDSymbol& pSymbol,
@@ -444,6 +486,19 @@ class GNULDBackend : public TargetLDBackend {
     return false;
   }
 
+ private:
+  /// isRelativeReloc - whether pReloc is a relative dynamic relocation
+  bool isRelativeReloc(const Relocation& pReloc) const;
+
+  /// encodeRelrDyn - encode the places of the packed relative relocations
+  /// and resize .relr.dyn to the encoded size. Unless pMayShrink, .relr.dyn
+  /// only grows. Return true if the size of .relr.dyn changes.
+  bool encodeRelrDyn(bool pMayShrink);
+
+  /// applyRelrAddends - write the addends of the packed relative relocations
+  /// to their places, since .relr.dyn has no room for them
+  void applyRelrAddends(FileOutputBuffer& pOutput) const;
+
  protected:
   // Based on Kind in LDFileFormat to define basic section orders for ELF.
   enum SectionOrder {
@@ -539,6 +594,10 @@ class GNULDBackend : public TargetLDBackend {
   // attribute section
   ELFAttribute* m_pAttribute;
 
+  // the relative relocations packed into .relr.dyn, and their encoding
+  std::vector<Relocation*> m_RelrRelocs;
+  std::vector<uint64_t> m_RelrEntries;
+
   // ----- dynamic flags ----- //
   // DF_TEXTREL of DT_FLAGS
   bool m_bHasTextRel;
@@ -9,13 +9,21 @@
 #ifndef MCLD_TARGET_KEYENTRYMAP_H_
 #define MCLD_TARGET_KEYENTRYMAP_H_
 
+#include <llvm/ADT/DenseMap.h>
+
 #include <list>
+#include <utility>
 #include <vector>
 
 namespace mcld {
 
 /** \class KeyEntryMap
  *  \brief KeyEntryMap is a <const KeyType*, ENTRY*> map.
+ *
+ *  The mappings are kept in the order they are recorded, so that iterating
+ *  the map is deterministic, and are indexed by a hash map from the key
+ *  address to the position of the mapping. If a key is recorded more than
+ *  once, the look-ups return the first mapping.
  */
 template <typename KEY, typename ENTRY>
 class KeyEntryMap {
@@ -46,6 +54,18 @@ class KeyEntryMap {
 
   typedef std::vector<Mapping> KeyEntryPool;
   typedef std::list<EntryPair> PairListType;
+  /// KeyInfo - DenseMapInfo<T*> drops the low 4 bits of the address, which
+  /// packs the small keys allocated one after another into a few buckets.
+  /// Mix all the bits instead.
+  struct KeyInfo : public llvm::DenseMapInfo<const KeyType*> {
+    static unsigned getHashValue(const KeyType* pKey) {
+      uint64_t value = reinterpret_cast<uintptr_t>(pKey);
+      value *= 0x9e3779b97f4a7c15ULL;
+      return static_cast<unsigned>(value >> 32);
+    }
+  };
+
+  typedef llvm::DenseMap<const KeyType*, size_t, KeyInfo> IndexType;
 
  public:
   typedef typename KeyEntryPool::iterator iterator;
@@ -77,88 +97,78 @@ class KeyEntryMap {
 
   void reserve(size_t pSize) { m_Pool.reserve(pSize); }
 
+ private:
+  /// find - the mapping of pKey, or NULL if pKey is not recorded
+  const Mapping* find(const KeyType& pKey) const;
+
+  /// add - append pMapping to the pool and index it
+  void add(const Mapping& pMapping);
+
  private:
   KeyEntryPool m_Pool;
 
+  /// m_Index - the position in m_Pool of the first mapping of each key
+  IndexType m_Index;
+
   /// m_Pairs - the EntryPairs
   PairListType m_Pairs;
 };
 
+template <typename KeyType, typename EntryType>
+const typename KeyEntryMap<KeyType, EntryType>::Mapping*
+KeyEntryMap<KeyType, EntryType>::find(const KeyType& pKey) const {
+  typename IndexType::const_iterator index = m_Index.find(&pKey);
+  if (index == m_Index.end())
+    return NULL;
+  return &m_Pool[index->second];
+}
+
+template <typename KeyType, typename EntryType>
+void KeyEntryMap<KeyType, EntryType>::add(const Mapping& pMapping) {
+  // keep the first mapping of the key
+  m_Index.insert(std::make_pair(pMapping.key, m_Pool.size()));
+  m_Pool.push_back(pMapping);
+}
+
 template <typename KeyType, typename EntryType>
 const EntryType* KeyEntryMap<KeyType, EntryType>::lookUp(
     const KeyType& pKey) const {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.entry_ptr;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  return (mapping == NULL) ? NULL : mapping->entry.entry_ptr;
 }
 
 template <typename KeyType, typename EntryType>
 EntryType* KeyEntryMap<KeyType, EntryType>::lookUp(const KeyType& pKey) {
-  iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.entry_ptr;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  return (mapping == NULL) ? NULL : mapping->entry.entry_ptr;
 }
 
 template <typename KeyType, typename EntryType>
 const EntryType* KeyEntryMap<KeyType, EntryType>::lookUpFirstEntry(
     const KeyType& pKey) const {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.pair_ptr->entry1;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  return (mapping == NULL) ? NULL : mapping->entry.pair_ptr->entry1;
 }
 
 template <typename KeyType, typename EntryType>
 EntryType* KeyEntryMap<KeyType, EntryType>::lookUpFirstEntry(
     const KeyType& pKey) {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.pair_ptr->entry1;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  return (mapping == NULL) ? NULL : mapping->entry.pair_ptr->entry1;
 }
 
 template <typename KeyType, typename EntryType>
 const EntryType* KeyEntryMap<KeyType, EntryType>::lookUpSecondEntry(
     const KeyType& pKey) const {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.pair_ptr->entry2;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  return (mapping == NULL) ? NULL : mapping->entry.pair_ptr->entry2;
 }
 
 template <typename KeyType, typename EntryType>
 EntryType* KeyEntryMap<KeyType, EntryType>::lookUpSecondEntry(
     const KeyType& pKey) {
-  const_iterator mapping, mEnd = m_Pool.end();
-  for (mapping = m_Pool.begin(); mapping != mEnd; ++mapping) {
-    if (mapping->key == &pKey) {
-      return mapping->entry.pair_ptr->entry2;
-    }
-  }
-
-  return NULL;
+  const Mapping* mapping = find(pKey);
+  return (mapping == NULL) ? NULL : mapping->entry.pair_ptr->entry2;
 }
 
 template <typename KeyType, typename EntryType>
@@ -167,7 +177,7 @@ void KeyEntryMap<KeyType, EntryType>::record(const KeyType& pKey,
   Mapping mapping;
   mapping.key = &pKey;
   mapping.entry.entry_ptr = &pEntry;
-  m_Pool.push_back(mapping);
+  add(mapping);
 }
 
 template <typename KeyType, typename EntryType>
@@ -178,7 +188,7 @@ void KeyEntryMap<KeyType, EntryType>::record(const KeyType& pKey,
   mapping.key = &pKey;
   m_Pairs.push_back(EntryPair(&pEntry1, &pEntry2));
   mapping.entry.pair_ptr = &m_Pairs.back();
-  m_Pool.push_back(mapping);
+  add(mapping);
 }
 
 }  // namespace mcld
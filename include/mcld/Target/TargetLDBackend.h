@@ -17,6 +17,8 @@
 #include <llvm/ADT/ilist.h>
 #include <llvm/Support/DataTypes.h>
 
+#include <vector>
+
 namespace mcld {
 
 class ArchiveReader;
@@ -32,6 +34,7 @@ class Input;
 class LDSection;
 class LDSymbol;
 class LinkerConfig;
+class LinkerStats;
 class Module;
 class ObjectBuilder;
 class ObjectReader;
@@ -177,6 +180,13 @@ class TargetLDBackend {
   /// process relocations more efficiently
   virtual void sortRelocation(LDSection& pSection) = 0;
 
+  /// getSectionsChangedByApply - get the linker created output sections whose
+  /// contents are changed by applying relocations, such as GOT entries and
+  /// addends of dynamic relocations. When relocations are applied while the
+  /// output file is written, these sections are written after them.
+  virtual void getSectionsChangedByApply(
+      std::vector<LDSection*>& pSections) = 0;
+
   /// createAndSizeEhFrameHdr - This is seperated since we may add eh_frame
   /// entry in the middle
   virtual void createAndSizeEhFrameHdr(Module& pModule) = 0;
@@ -198,9 +208,14 @@ class TargetLDBackend {
     return m_ExtraReloc.end();
   }
 
+  /// setStats - the LinkerStats of --time-report and --stats, or NULL
+  void setStats(LinkerStats* pStats) { m_pStats = pStats; }
+
  protected:
   const LinkerConfig& config() const { return m_Config; }
 
+  LinkerStats* stats() const { return m_pStats; }
+
   /// addExtraRelocation - Add an extra relocation which are automatically
   /// generated by the LD backend.
   void addExtraRelocation(Relocation* reloc) {
@@ -210,6 +225,8 @@ class TargetLDBackend {
  private:
   const LinkerConfig& m_Config;
 
+  LinkerStats* m_pStats;
+
   /// m_ExtraReloc - Extra relocations that are automatically generated by the
   /// linker.
   ExtraRelocList m_ExtraReloc;
@@ -38,6 +38,7 @@ GeneralOptions::GeneralOptions()
       m_bRelro(false),
       m_bNow(false),
       m_bOrigin(false),
+      m_bPackRelativeRelocs(false),
       m_bTrace(false),
       m_Bsymbolic(false),
       m_Bgroup(false),
@@ -59,10 +60,21 @@ GeneralOptions::GeneralOptions()
       m_bPrintGCSections(false),
       m_bGenUnwindInfo(true),
       m_bPrintICFSections(false),
+      m_bPrintICFStats(false),
+      m_bDirectRelocation(false),
+      m_bMergeSections(false),
+      m_bTailMergeStrings(false),
+      m_bStreamDebugInfo(false),
+      m_bLazyDSOSymbols(false),
+      m_bTimeReport(false),
+      m_bStats(false),
+      m_StatsFormat(StatsFormat::Text),
       m_ICF(ICF::None),
       m_ICFIterations(2),
+      m_NumThreads(1),
       m_StripSymbols(StripSymbolMode::KeepAllSymbols),
-      m_HashStyle(HashStyle::SystemV) {
+      m_HashStyle(HashStyle::SystemV),
+      m_GNUHashLoadFactor(0) {
 }
 
 GeneralOptions::~GeneralOptions() {
@@ -135,6 +147,12 @@ void GeneralOptions::addZOption(const ZOption& pOption) {
     case ZOption::Origin:
       m_bOrigin = true;
       break;
+    case ZOption::PackRelativeRelocs:
+      m_bPackRelativeRelocs = true;
+      break;
+    case ZOption::NoPackRelativeRelocs:
+      m_bPackRelativeRelocs = false;
+      break;
     case ZOption::CommPageSize:
       m_CommPageSize = pOption.pageSize();
       break;
@@ -395,16 +395,17 @@ uint64_t IRBuilder::AppendEhFrame(EhFrame::CIE& pCIE, EhFrame& pEhFrame) {
 /// AddSymbol - To add a symbol in the input file and resolve the symbol
 /// immediately
 LDSymbol* IRBuilder::AddSymbol(Input& pInput,
-                               const std::string& pName,
+                               const llvm::StringRef& pName,
                                ResolveInfo::Type pType,
                                ResolveInfo::Desc pDesc,
                                ResolveInfo::Binding pBind,
                                ResolveInfo::SizeType pSize,
                                LDSymbol::ValueType pValue,
                                LDSection* pSection,
-                               ResolveInfo::Visibility pVis) {
+                               ResolveInfo::Visibility pVis,
+                               ResolveInfo* pEntry) {
   // rename symbols
-  std::string name = pName;
+  llvm::StringRef name = pName;
   if (!m_Module.getScript().renameMap().empty() &&
       ResolveInfo::Undefined == pDesc) {
     // If the renameMap is not empty, some symbols should be renamed.
@@ -412,8 +413,11 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
     const LinkerScript& script = m_Module.getScript();
     LinkerScript::SymbolRenameMap::const_iterator renameSym =
         script.renameMap().find(pName);
-    if (script.renameMap().end() != renameSym)
+    if (script.renameMap().end() != renameSym) {
       name = renameSym.getEntry()->value();
+      // pEntry is the entry of the original name
+      pEntry = NULL;
+    }
   }
 
   // Fix up the visibility if object has no export set.
@@ -423,6 +427,11 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
     }
   }
 
+  // --lazy-dso-symbols: the shared libraries read before pInput put their
+  // definitions of the name into the pool first, as a full read does
+  if (pBind != ResolveInfo::Local)
+    m_Module.getLazyDynSymbols().resolve(name, &pInput);
+
   switch (pInput.type()) {
     case Input::Object: {
       FragmentRef* frag = NULL;
@@ -435,13 +444,13 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
         frag = FragmentRef::Create(*pSection, pValue);
 
       LDSymbol* input_sym = addSymbolFromObject(
-          name, pType, pDesc, pBind, pSize, pValue, frag, pVis);
+          name, pType, pDesc, pBind, pSize, pValue, frag, pVis, pEntry);
       pInput.context()->addSymbol(input_sym);
       return input_sym;
     }
     case Input::DynObj: {
       return addSymbolFromDynObj(
-          pInput, name, pType, pDesc, pBind, pSize, pValue, pVis);
+          pInput, name, pType, pDesc, pBind, pSize, pValue, pVis, pEntry);
     }
     default: {
       return NULL;
@@ -451,14 +460,15 @@ LDSymbol* IRBuilder::AddSymbol(Input& pInput,
   return NULL;
 }
 
-LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
+LDSymbol* IRBuilder::addSymbolFromObject(const llvm::StringRef& pName,
                                          ResolveInfo::Type pType,
                                          ResolveInfo::Desc pDesc,
                                          ResolveInfo::Binding pBinding,
                                          ResolveInfo::SizeType pSize,
                                          LDSymbol::ValueType pValue,
                                          FragmentRef* pFragmentRef,
-                                         ResolveInfo::Visibility pVisibility) {
+                                         ResolveInfo::Visibility pVisibility,
+                                         ResolveInfo* pEntry) {
   // Step 1. calculate a Resolver::Result
   // resolved_result is a triple <resolved_info, existent, override>
   Resolver::Result resolved_result;
@@ -476,16 +486,17 @@ LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
     resolved_result.overriden = true;
   } else {
     // if the symbol is not local, insert and resolve it immediately
-    m_Module.getNamePool().insertSymbol(pName,
-                                        false,
-                                        pType,
-                                        pDesc,
-                                        pBinding,
-                                        pSize,
-                                        pValue,
-                                        pVisibility,
-                                        &old_info,
-                                        resolved_result);
+    insertSymbol(pName,
+                 false,
+                 pType,
+                 pDesc,
+                 pBinding,
+                 pSize,
+                 pValue,
+                 pVisibility,
+                 &old_info,
+                 pEntry,
+                 resolved_result);
   }
 
   // the return ResolveInfo should not NULL
@@ -526,13 +537,14 @@ LDSymbol* IRBuilder::addSymbolFromObject(const std::string& pName,
 }
 
 LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
-                                         const std::string& pName,
+                                         const llvm::StringRef& pName,
                                          ResolveInfo::Type pType,
                                          ResolveInfo::Desc pDesc,
                                          ResolveInfo::Binding pBinding,
                                          ResolveInfo::SizeType pSize,
                                          LDSymbol::ValueType pValue,
-                                         ResolveInfo::Visibility pVisibility) {
+                                         ResolveInfo::Visibility pVisibility,
+                                         ResolveInfo* pEntry) {
   // We don't need sections of dynamic objects. So we ignore section symbols.
   if (pType == ResolveInfo::Section)
     return NULL;
@@ -551,16 +563,17 @@ LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
   // insert symbol and resolve it immediately
   // resolved_result is a triple <resolved_info, existent, override>
   Resolver::Result resolved_result;
-  m_Module.getNamePool().insertSymbol(pName,
-                                      true,
-                                      pType,
-                                      pDesc,
-                                      pBinding,
-                                      pSize,
-                                      pValue,
-                                      pVisibility,
-                                      NULL,
-                                      resolved_result);
+  insertSymbol(pName,
+               true,
+               pType,
+               pDesc,
+               pBinding,
+               pSize,
+               pValue,
+               pVisibility,
+               NULL,
+               pEntry,
+               resolved_result);
 
   // the return ResolveInfo should not NULL
   assert(resolved_result.info != NULL);
@@ -583,6 +596,42 @@ LDSymbol* IRBuilder::addSymbolFromDynObj(Input& pInput,
   return input_sym;
 }
 
+void IRBuilder::insertSymbol(const llvm::StringRef& pName,
+                             bool pIsDyn,
+                             ResolveInfo::Type pType,
+                             ResolveInfo::Desc pDesc,
+                             ResolveInfo::Binding pBinding,
+                             ResolveInfo::SizeType pSize,
+                             LDSymbol::ValueType pValue,
+                             ResolveInfo::Visibility pVisibility,
+                             ResolveInfo* pOldInfo,
+                             ResolveInfo* pEntry,
+                             Resolver::Result& pResult) {
+  if (pEntry != NULL) {
+    m_Module.getNamePool().insertSymbol(*pEntry,
+                                        pIsDyn,
+                                        pType,
+                                        pDesc,
+                                        pBinding,
+                                        pSize,
+                                        pValue,
+                                        pVisibility,
+                                        pOldInfo,
+                                        pResult);
+  } else {
+    m_Module.getNamePool().insertSymbol(pName,
+                                        pIsDyn,
+                                        pType,
+                                        pDesc,
+                                        pBinding,
+                                        pSize,
+                                        pValue,
+                                        pVisibility,
+                                        pOldInfo,
+                                        pResult);
+  }
+}
+
 /// AddRelocation - add a relocation entry
 ///
 /// All symbols should be read and resolved before calling this function.
@@ -642,6 +691,8 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::Force, IRBuilder::Unresolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  // the shared libraries may refer to or define the symbol
+  m_Module.getLazyDynSymbols().resolve(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
   LDSymbol* output_sym = NULL;
   if (info == NULL) {
@@ -712,6 +763,8 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::AsReferred, IRBuilder::Unresolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  // the shared libraries may refer to or define the symbol
+  m_Module.getLazyDynSymbols().resolve(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
 
   if (info == NULL || !(info->isUndef() || info->isDyn())) {
@@ -759,6 +812,9 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::Force, IRBuilder::Resolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  // the shared libraries may refer to or define the symbol
+  m_Module.getLazyDynSymbols().resolve(pName);
+
   // Result is <info, existent, override>
   Resolver::Result result;
   ResolveInfo old_info;
@@ -809,6 +865,8 @@ LDSymbol* IRBuilder::AddSymbol<IRBuilder::AsReferred, IRBuilder::Resolve>(
     LDSymbol::ValueType pValue,
     FragmentRef* pFragmentRef,
     ResolveInfo::Visibility pVisibility) {
+  // the shared libraries may refer to or define the symbol
+  m_Module.getLazyDynSymbols().resolve(pName);
   ResolveInfo* info = m_Module.getNamePool().findInfo(pName);
 
   if (info == NULL || !(info->isUndef() || info->isDyn())) {
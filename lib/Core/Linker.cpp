@@ -22,6 +22,7 @@
 #include "mcld/Object/ObjectLinker.h"
 #include "mcld/Support/FileHandle.h"
 #include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/LinkerStats.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/TargetRegistry.h"
 #include "mcld/Support/raw_ostream.h"
@@ -36,7 +37,8 @@ Linker::Linker()
       m_pIRBuilder(NULL),
       m_pTarget(NULL),
       m_pBackend(NULL),
-      m_pObjLinker(NULL) {
+      m_pObjLinker(NULL),
+      m_pStats(NULL) {
 }
 
 Linker::~Linker() {
@@ -81,6 +83,15 @@ bool Linker::normalize(Module& pModule, IRBuilder& pBuilder) {
 
   m_pObjLinker = new ObjectLinker(*m_pConfig, *m_pBackend);
 
+  const GeneralOptions& options = m_pConfig->options();
+  if (options.timeReport() || options.stats()) {
+    m_pStats = new LinkerStats(
+        options.timeReport(),
+        options.stats(),
+        options.statsFormat() == GeneralOptions::StatsFormat::JSON);
+    m_pBackend->setStats(m_pStats);
+  }
+
   // 2. - initialize ObjectLinker
   if (!m_pObjLinker->initialize(pModule, pBuilder))
     return false;
@@ -101,7 +112,10 @@ bool Linker::normalize(Module& pModule, IRBuilder& pBuilder) {
   //   read out sections and symbol/string tables (from the files) and
   //   set them in Module. When reading out the symbol, resolve their symbols
   //   immediately and set their ResolveInfo (i.e., Symbol Resolution).
-  m_pObjLinker->normalize();
+  {
+    LinkerStats::Timer timer(m_pStats, "normalize");
+    m_pObjLinker->normalize();
+  }
 
   if (m_pConfig->options().trace()) {
     static int counter = 0;
@@ -168,14 +182,20 @@ bool Linker::resolve(Module& pModule) {
 
   // 6. - read all relocation entries from input files
   //   For all relocation sections of each input file (in the tree),
-  //   read out reloc entry info from the object file and accordingly
-  //   initiate their reloc entries in SectOrRelocData of LDSection.
+  //   keep the mapped reloc entries in the RelocTable of the LDSection. They
+  //   are decoded into Relocations when first used, or by dataStrippingOpt.
   //
   //   To collect all edges in the reference graph.
-  m_pObjLinker->readRelocations();
+  {
+    LinkerStats::Timer timer(m_pStats, "readRelocations");
+    m_pObjLinker->readRelocations();
+  }
 
   // 7. - data stripping optimizations
-  m_pObjLinker->dataStrippingOpt();
+  {
+    LinkerStats::Timer timer(m_pStats, "dataStrippingOpt");
+    m_pObjLinker->dataStrippingOpt();
+  }
 
   // 8. - merge all sections
   //   Push sections into Module's SectionTable.
@@ -183,8 +203,11 @@ bool Linker::resolve(Module& pModule) {
   //   Maintain them as fragments in the section.
   //
   //   To merge nodes of the reference graph.
-  if (!m_pObjLinker->mergeSections())
-    return false;
+  {
+    LinkerStats::Timer timer(m_pStats, "mergeSections");
+    if (!m_pObjLinker->mergeSections())
+      return false;
+  }
 
   // 9.a - add symbols to output
   //  After all input symbols have been resolved, add them to output symbol
@@ -210,29 +233,45 @@ bool Linker::layout() {
   // 11. - scan all relocation entries by output symbols.
   //   reserve GOT space for layout.
   //   the space info is needed by pre-layout to compute the section size
-  m_pObjLinker->scanRelocations();
+  {
+    LinkerStats::Timer timer(m_pStats, "scanRelocations");
+    m_pObjLinker->scanRelocations();
+  }
 
   // 12.a - init relaxation stuff.
   m_pObjLinker->initStubs();
 
   // 12.b - pre-layout
-  m_pObjLinker->prelayout();
+  {
+    LinkerStats::Timer timer(m_pStats, "prelayout");
+    m_pObjLinker->prelayout();
+  }
 
   // 12.c - linear layout
   //   Decide which sections will be left in. Sort the sections according to
   //   a given order. Then, create program header accordingly.
   //   Finally, set the offset for sections (@ref LDSection)
   //   according to the new order.
-  m_pObjLinker->layout();
+  {
+    LinkerStats::Timer timer(m_pStats, "layout");
+    m_pObjLinker->layout();
+  }
 
   // 12.d - post-layout (create segment, instruction relaxing)
-  m_pObjLinker->postlayout();
+  {
+    LinkerStats::Timer timer(m_pStats, "postlayout");
+    m_pObjLinker->postlayout();
+  }
 
   // 13. - finalize symbol value
   m_pObjLinker->finalizeSymbolValue();
 
   // 14. - apply relocations
-  m_pObjLinker->relocation();
+  //   With --direct-relocation, relocations are applied while emitting.
+  {
+    LinkerStats::Timer timer(m_pStats, "relocation");
+    m_pObjLinker->relocation();
+  }
 
   if (!Diagnose())
     return false;
@@ -241,14 +280,26 @@ bool Linker::layout() {
 
 bool Linker::emit(FileOutputBuffer& pOutput) {
   // 15. - write out output
-  m_pObjLinker->emitOutput(pOutput);
+  {
+    LinkerStats::Timer timer(m_pStats, "emitOutput");
+    m_pObjLinker->emitOutput(pOutput);
+  }
 
   // 16. - post processing
-  m_pObjLinker->postProcessing(pOutput);
+  {
+    LinkerStats::Timer timer(m_pStats, "postProcessing");
+    m_pObjLinker->postProcessing(pOutput);
+  }
 
   if (!Diagnose())
     return false;
 
+  // 17. - report the statistics
+  if (m_pStats != NULL) {
+    m_pObjLinker->collectStats(*m_pStats);
+    m_pStats->print(mcld::outs());
+  }
+
   return true;
 }
 
@@ -314,6 +365,9 @@ bool Linker::reset() {
   delete m_pObjLinker;
   m_pObjLinker = NULL;
 
+  delete m_pStats;
+  m_pStats = NULL;
+
   LDSection::Clear();
   LDSymbol::Clear();
   FragmentRef::Clear();
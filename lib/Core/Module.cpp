@@ -24,33 +24,46 @@ static GCFactory<Module::AliasList, MCLD_SECTIONS_PER_INPUT>
 //===----------------------------------------------------------------------===//
 // Module
 //===----------------------------------------------------------------------===//
-Module::Module(LinkerScript& pScript) : m_Script(pScript), m_NamePool(1024) {
+Module::Module(LinkerScript& pScript)
+    : m_Script(pScript), m_NamePool(1024), m_LazyDynSymbols(m_NamePool) {
 }
 
 Module::Module(const std::string& pName, LinkerScript& pScript)
-    : m_Name(pName), m_Script(pScript), m_NamePool(1024) {
+    : m_Name(pName),
+      m_Script(pScript),
+      m_NamePool(1024),
+      m_LazyDynSymbols(m_NamePool) {
 }
 
 Module::~Module() {
 }
 
-// Following two functions will be obsolette when we have new section merger.
+Module& Module::appendSection(LDSection& pSection) {
+  m_SectionTable.push_back(&pSection);
+  // keep the first section of the name, as a linear search would find
+  if (m_SectionIndex.find(pSection.name()) == m_SectionIndex.end())
+    m_SectionIndex[pSection.name()] = &pSection;
+  return *this;
+}
+
+void Module::clearSections() {
+  m_SectionTable.clear();
+  m_SectionIndex.clear();
+}
+
 LDSection* Module::getSection(const std::string& pName) {
-  iterator sect, sectEnd = end();
-  for (sect = begin(); sect != sectEnd; ++sect) {
-    if ((*sect)->name() == pName)
-      return *sect;
-  }
-  return NULL;
+  llvm::StringMap<LDSection*>::iterator entry = m_SectionIndex.find(pName);
+  if (entry == m_SectionIndex.end())
+    return NULL;
+  return entry->getValue();
 }
 
 const LDSection* Module::getSection(const std::string& pName) const {
-  const_iterator sect, sectEnd = end();
-  for (sect = begin(); sect != sectEnd; ++sect) {
-    if ((*sect)->name() == pName)
-      return *sect;
-  }
-  return NULL;
+  llvm::StringMap<LDSection*>::const_iterator entry =
+      m_SectionIndex.find(pName);
+  if (entry == m_SectionIndex.end())
+    return NULL;
+  return entry->getValue();
 }
 
 void Module::CreateAliasList(const ResolveInfo& pSym) {
@@ -30,6 +30,8 @@ Archive::Archive(Input& pInputFile, InputBuilder& pBuilder)
     : m_ArchiveFile(pInputFile),
       m_pInputTree(NULL),
       m_SymbolFactory(32),
+      m_NumOfVisitedObjects(0),
+      m_NumOfVisitedLibraries(0),
       m_Builder(pBuilder) {
   // FIXME: move creation of input tree out of Archive.
   m_pInputTree = new InputTree();
@@ -171,6 +173,7 @@ void Archive::addSymbol(const char* pName,
                         enum Archive::Symbol::Status pStatus) {
   Symbol* entry = m_SymbolFactory.allocate();
   new (entry) Symbol(pName, pFileOffset, pStatus);
+  m_SymbolIndexMap[entry->name].push_back(m_SymTab.size());
   m_SymTab.push_back(entry);
 }
 
@@ -180,6 +183,15 @@ const std::string& Archive::getSymbolName(size_t pSymIdx) const {
   return m_SymTab[pSymIdx]->name;
 }
 
+/// findSymbols - get the symtab indices of the symbols named pName
+const Archive::SymbolIndices* Archive::findSymbols(
+    const llvm::StringRef& pName) const {
+  SymbolIndexMap::const_iterator entry = m_SymbolIndexMap.find(pName);
+  if (entry == m_SymbolIndexMap.end())
+    return NULL;
+  return &entry->getValue();
+}
+
 /// getObjFileOffset - get the file offset that represent a object file
 uint32_t Archive::getObjFileOffset(size_t pSymIdx) const {
   assert(pSymIdx < numOfSymbols());
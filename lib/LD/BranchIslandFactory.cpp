@@ -13,6 +13,8 @@
 #include "mcld/LD/SectionData.h"
 #include "mcld/Module.h"
 
+#include <algorithm>
+
 namespace mcld {
 
 //===----------------------------------------------------------------------===//
@@ -69,6 +71,17 @@ BranchIsland* BranchIslandFactory::produce(Fragment& pFragment) {
   new (island) BranchIsland(pFragment,        // entry fragment to the island
                             m_MaxIslandSize,  // the max size of the island
                             size() - 1u);     // index in the island factory
+
+  // islands are usually produced in the order of their offsets
+  IslandList& islands = m_IslandMap[island->getParent()];
+  IslandList::iterator pos = islands.end();
+  if (!islands.empty() && islands.back()->offset() > island->offset()) {
+    pos = std::upper_bound(islands.begin(), islands.end(), island->offset(),
+                           [](uint64_t pOffset, const BranchIsland* pIsland) {
+      return pOffset < pIsland->offset();
+    });
+  }
+  islands.insert(pos, island);
   return island;
 }
 
@@ -78,25 +91,28 @@ std::pair<BranchIsland*, BranchIsland*> BranchIslandFactory::getIslands(
     const Fragment& pFragment) {
   BranchIsland* fwd = NULL;
   BranchIsland* bwd = NULL;
-  for (iterator it = begin(), ie = end(), prev = ie; it != ie;
-       prev = it, ++it) {
-    if (pFragment.getParent() != (*it).getParent()) {
-      continue;
-    }
+  IslandMap::const_iterator entry = m_IslandMap.find(pFragment.getParent());
+  if (entry == m_IslandMap.end())
+    return std::make_pair(fwd, bwd);
 
-    if ((pFragment.getOffset() < (*it).offset()) &&
-        ((pFragment.getOffset() + m_MaxFwdBranchRange) >= (*it).offset())) {
-      fwd = &*it;
+  // the first island after the fragment
+  const IslandList& islands = entry->second;
+  uint64_t offset = pFragment.getOffset();
+  IslandList::const_iterator it =
+      std::upper_bound(islands.begin(), islands.end(), offset,
+                       [](uint64_t pOffset, const BranchIsland* pIsland) {
+        return pOffset < pIsland->offset();
+      });
+  if (it == islands.end() ||
+      (offset + m_MaxFwdBranchRange) < (*it)->offset())
+    return std::make_pair(fwd, bwd);
+  fwd = *it;
 
-      if ((prev != ie) && (pFragment.getParent() == (*prev).getParent())) {
-        int64_t bwd_off = (int64_t)pFragment.getOffset() + m_MaxBwdBranchRange;
-        if ((pFragment.getOffset() > (*prev).offset()) &&
-            (bwd_off <= (int64_t)(*prev).offset())) {
-          bwd = &*prev;
-        }
-      }
-      break;
-    }
+  if (it != islands.begin()) {
+    BranchIsland* prev = *(it - 1);
+    int64_t bwd_off = (int64_t)offset + m_MaxBwdBranchRange;
+    if ((offset > prev->offset()) && (bwd_off <= (int64_t)prev->offset()))
+      bwd = prev;
   }
   return std::make_pair(fwd, bwd);
 }
@@ -67,10 +67,10 @@ bool DiagnosticEngine::emit() {
 
 MsgHandler DiagnosticEngine::report(uint16_t pID,
                                     DiagnosticEngine::Severity pSeverity) {
+  // the handler holds the lock until the message is emitted
+  MsgHandler result(*this);
   m_State.ID = pID;
   m_State.severity = pSeverity;
-
-  MsgHandler result(*this);
   return result;
 }
 
@@ -52,6 +52,11 @@ void ELFDynObjFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                       llvm::ELF::SHT_RELA,
                                       llvm::ELF::SHF_ALLOC,
                                       pBitClass / 8);
+  f_pRelrDyn = pBuilder.CreateSection(".relr.dyn",
+                                      LDFileFormat::Target,
+                                      SHT_RELR,
+                                      llvm::ELF::SHF_ALLOC,
+                                      pBitClass / 8);
   f_pRelDyn = pBuilder.CreateSection(".rel.dyn",
                                      LDFileFormat::Relocation,
                                      llvm::ELF::SHT_REL,
@@ -12,12 +12,16 @@
 #include "mcld/LinkerConfig.h"
 #include "mcld/LD/ELFReader.h"
 #include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/LazyDynSymbols.h"
 #include "mcld/MC/Input.h"
+#include "mcld/Module.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Target/GNULDBackend.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ADT/Twine.h>
+#include <llvm/Support/ELF.h>
 #include <llvm/Support/ErrorHandling.h>
 
 #include <string>
@@ -30,7 +34,10 @@ namespace mcld {
 ELFDynObjReader::ELFDynObjReader(GNULDBackend& pBackend,
                                  IRBuilder& pBuilder,
                                  const LinkerConfig& pConfig)
-    : DynObjReader(), m_pELFReader(0), m_Builder(pBuilder) {
+    : DynObjReader(),
+      m_pELFReader(0),
+      m_Builder(pBuilder),
+      m_Config(pConfig) {
   if (pConfig.targets().is32Bits() && pConfig.targets().isLittleEndian())
     m_pELFReader = new ELFReader<32, true>(pBackend);
   else if (pConfig.targets().is64Bits() && pConfig.targets().isLittleEndian())
@@ -72,6 +79,15 @@ bool ELFDynObjReader::isMyFormat(Input& pInput, bool& pContinue) const {
   return result;
 }
 
+/// prefetch - the symbols are read on demand with --lazy-dso-symbols
+bool ELFDynObjReader::prefetch(Input& pInput) {
+  assert(pInput.hasMemArea());
+  return m_pELFReader->prefetch(*pInput.memArea(),
+                                pInput.fileOffset(),
+                                Input::DynObj,
+                                !m_Config.options().lazyDSOSymbols());
+}
+
 /// readHeader
 bool ELFDynObjReader::readHeader(Input& pInput) {
   assert(pInput.hasMemArea());
@@ -113,8 +129,52 @@ bool ELFDynObjReader::readSymbols(Input& pInput) {
   llvm::StringRef strtab_region = pInput.memArea()->request(
       pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
   const char* strtab = strtab_region.begin();
-  bool result =
-      m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
+
+  // --lazy-dso-symbols: read the definitions through the hash table when
+  // they are referenced
+  if (m_Config.options().lazyDSOSymbols()) {
+    LDSection* hash_shdr = NULL;
+    LDContext::sect_iterator sect, sectEnd = pInput.context()->sectEnd();
+    for (sect = pInput.context()->sectBegin(); sect != sectEnd; ++sect) {
+      if ((*sect)->getLink() != symtab_shdr)
+        continue;
+      if ((*sect)->type() == llvm::ELF::SHT_GNU_HASH) {
+        hash_shdr = *sect;
+        break;
+      }
+      if ((*sect)->type() == llvm::ELF::SHT_HASH)
+        hash_shdr = *sect;
+    }
+
+    if (hash_shdr != NULL) {
+      llvm::StringRef hash_region = pInput.memArea()->request(
+          pInput.fileOffset() + hash_shdr->offset(), hash_shdr->size());
+      if (m_Builder.getModule().getLazyDynSymbols().add(
+              *m_pELFReader,
+              m_Builder,
+              pInput,
+              m_Config.targets().is64Bits(),
+              symtab_region,
+              strtab_region,
+              hash_region,
+              hash_shdr->type() == llvm::ELF::SHT_GNU_HASH)) {
+        m_pELFReader->releaseTables(pInput);
+        return true;
+      }
+    }
+  }
+
+  // use the symbols decoded by prefetch if they are of this .dynsym
+  bool result = false;
+  const ELFTables* tables = m_pELFReader->getTables(pInput);
+  if (tables != NULL &&
+      tables->hasSymTab(symtab_shdr->offset(), symtab_shdr->size()))
+    result = m_pELFReader->addSymbols(
+        pInput, m_Builder, tables->symbols(), strtab);
+  else
+    result =
+        m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
+  m_pELFReader->releaseTables(pInput);
   return result;
 }
 
@@ -22,6 +22,7 @@ ELFFileFormat::ELFFileFormat()
       f_pRelPlt(NULL),
       f_pRelaDyn(NULL),
       f_pRelaPlt(NULL),
+      f_pRelrDyn(NULL),
       f_pComment(NULL),
       f_pData1(NULL),
       f_pDebug(NULL),
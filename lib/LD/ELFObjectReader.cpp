@@ -14,6 +14,7 @@
 #include "mcld/LD/EhFrameReader.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDContext.h"
+#include "mcld/LD/RelocData.h"
 #include "mcld/Target/GNULDBackend.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/MemoryArea.h"
@@ -89,6 +90,17 @@ bool ELFObjectReader::isMyFormat(Input& pInput, bool& pContinue) const {
   return result;
 }
 
+/// prefetch
+bool ELFObjectReader::prefetch(Input& pInput) {
+  assert(pInput.hasMemArea());
+  return prefetch(*pInput.memArea(), pInput.fileOffset());
+}
+
+/// prefetch - decode the tables of the object at pFileOffset of pArea
+bool ELFObjectReader::prefetch(MemoryArea& pArea, uint64_t pFileOffset) {
+  return m_pELFReader->prefetch(pArea, pFileOffset, Input::Object, true);
+}
+
 /// readHeader - read section header and create LDSections.
 bool ELFObjectReader::readHeader(Input& pInput) {
   assert(pInput.hasMemArea());
@@ -295,8 +307,18 @@ bool ELFObjectReader::readSymbols(Input& pInput) {
   llvm::StringRef strtab_region = pInput.memArea()->request(
       pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
   const char* strtab = strtab_region.begin();
-  bool result =
-      m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
+
+  // use the symbols decoded by prefetch if they are of this .symtab
+  bool result = false;
+  const ELFTables* tables = m_pELFReader->getTables(pInput);
+  if (tables != NULL &&
+      tables->hasSymTab(symtab_shdr->offset(), symtab_shdr->size()))
+    result = m_pELFReader->addSymbols(
+        pInput, m_Builder, tables->symbols(), strtab);
+  else
+    result =
+        m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
+  m_pELFReader->releaseTables(pInput);
   return result;
 }
 
@@ -314,23 +336,15 @@ bool ELFObjectReader::readRelocations(Input& pInput) {
     llvm::StringRef region = mem->request(offset, size);
     IRBuilder::CreateRelocData(
         **rs);  ///< create relocation data for the header
-    switch ((*rs)->type()) {
-      case llvm::ELF::SHT_RELA: {
-        if (!m_pELFReader->readRela(pInput, **rs, region)) {
-          return false;
-        }
-        break;
-      }
-      case llvm::ELF::SHT_REL: {
-        if (!m_pELFReader->readRel(pInput, **rs, region)) {
-          return false;
-        }
-        break;
-      }
-      default: {  ///< should not enter
-        return false;
-      }
-    }  // end of switch
+    if ((*rs)->type() != llvm::ELF::SHT_RELA &&
+        (*rs)->type() != llvm::ELF::SHT_REL)
+      return false;
+
+    // keep the mapped records only. They are decoded when garbage collection
+    // walks the section or the section is materialized, so the relocations
+    // of the sections discarded before that are never decoded.
+    (*rs)->getRelocData()->getTable().setSource(
+        *m_pELFReader, pInput, **rs, region);
   }  // end of for all relocation data
 
   return true;
@@ -26,7 +26,11 @@
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/Parallel.h"
+#include "mcld/Support/SystemUtils.h"
 #include "mcld/Target/GNUInfo.h"
 #include "mcld/Target/GNULDBackend.h"
 
@@ -35,8 +39,60 @@
 #include <llvm/Support/Errc.h>
 #include <llvm/Support/ErrorHandling.h>
 
+#include <algorithm>
+#include <utility>
+
 namespace mcld {
 
+namespace {
+
+/// the least number of bytes of a section copied by one task
+const size_t RangeSize = 1u << 20;
+
+/** \struct CopyRange
+ *  \brief a range of fragments of an output section copied by one task
+ */
+struct CopyRange {
+  LDSection* Section;
+  SectionData::const_iterator Begin;
+  SectionData::const_iterator End;
+  size_t Offset;
+};
+
+/// isCopiedInParallel - the sections whose contents only come from their own
+/// fragments
+bool isCopiedInParallel(const LDSection& pSection) {
+  switch (pSection.kind()) {
+    case LDFileFormat::TEXT:
+    case LDFileFormat::DATA:
+    case LDFileFormat::Debug:
+    case LDFileFormat::GCCExceptTable:
+      return pSection.hasSectionData();
+    case LDFileFormat::Note:
+      return pSection.getSectionData() != NULL;
+    default:
+      return false;
+  }
+}
+
+/// takeSections - move the sections of pSections which are in pTaken to
+/// pOut, keeping their order
+void takeSections(std::vector<LDSection*>& pSections,
+                  const std::vector<LDSection*>& pTaken,
+                  std::vector<LDSection*>& pOut) {
+  if (pTaken.empty())
+    return;
+  std::vector<LDSection*>::iterator kept = std::stable_partition(
+      pSections.begin(), pSections.end(), [&pTaken](LDSection* pSection) {
+        return std::find(pTaken.begin(), pTaken.end(), pSection) ==
+               pTaken.end();
+      });
+  pOut.insert(pOut.end(), kept, pSections.end());
+  pSections.erase(kept, pSections.end());
+}
+
+}  // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // ELFObjectWriter
 //===----------------------------------------------------------------------===//
@@ -116,8 +172,139 @@ void ELFObjectWriter::writeSection(Module& pModule,
   }
 }
 
+void ELFObjectWriter::writeSections(Module& pModule,
+                                    FileOutputBuffer& pOutput,
+                                    const SectionList& pSections) {
+  // split the regular sections into ranges of at least RangeSize bytes. A
+  // fragment is never split.
+  std::vector<CopyRange> ranges;
+  SectionList::const_iterator sect, sectEnd = pSections.end();
+  for (sect = pSections.begin(); sect != sectEnd; ++sect) {
+    if (!isCopiedInParallel(**sect) || (*sect)->size() == 0 ||
+        isStreamed(**sect))
+      continue;
+    const SectionData* sd = (*sect)->getSectionData();
+    CopyRange range = {*sect, sd->begin(), sd->end(), 0};
+    size_t offset = 0;
+    SectionData::const_iterator frag, fragEnd = sd->end();
+    for (frag = sd->begin(); frag != fragEnd; ++frag) {
+      if (offset - range.Offset >= RangeSize) {
+        range.End = frag;
+        ranges.push_back(range);
+        range.Begin = frag;
+        range.Offset = offset;
+      }
+      offset += frag->size();
+    }
+    range.End = fragEnd;
+    ranges.push_back(range);
+  }
+
+  parallel::forEachN(m_Config.options().numThreads(), 0, ranges.size(),
+                     [this, &pOutput, &ranges](size_t pIdx) {
+    const CopyRange& range = ranges[pIdx];
+    MemoryRegion region =
+        pOutput.request(range.Section->offset(), range.Section->size());
+    if (region.size() != 0)
+      emitFragments(range.Begin, range.End, range.Offset, region);
+  });
+
+  // the target sections may depend on the other sections
+  for (sect = pSections.begin(); sect != sectEnd; ++sect) {
+    if (!isCopiedInParallel(**sect))
+      writeSection(pModule, pOutput, *sect);
+  }
+}
+
+bool ELFObjectWriter::isStreamed(const LDSection& pSection) const {
+  return m_Config.options().streamDebugInfo() &&
+         LDFileFormat::Debug == pSection.kind() &&
+         (pSection.flag() & llvm::ELF::SHF_ALLOC) == 0 &&
+         pSection.hasSectionData();
+}
+
+void ELFObjectWriter::streamDebugSections(const Module& pModule,
+                                          FileOutputBuffer& pOutput) const {
+  // the mappings of the inputs, sorted by address. The members of an archive
+  // share the mapping of the archive.
+  typedef std::pair<const char*, MemoryArea*> Mapping;
+  std::vector<Mapping> mappings;
+  Module::const_obj_iterator obj, objEnd = pModule.obj_end();
+  for (obj = pModule.obj_begin(); obj != objEnd; ++obj) {
+    if (!(*obj)->hasMemArea())
+      continue;
+    MemoryArea* area = (*obj)->memArea();
+    mappings.push_back(std::make_pair(area->request(0, 0).data(), area));
+  }
+  std::sort(mappings.begin(), mappings.end());
+  mappings.erase(std::unique(mappings.begin(), mappings.end()),
+                 mappings.end());
+
+  // group the region fragments by the mapping they are read from, and write
+  // the others right away
+  typedef std::pair<const RegionFragment*, size_t> Placement;
+  std::vector<std::vector<Placement> > placements(mappings.size());
+  Module::const_iterator sect, sectEnd = pModule.end();
+  for (sect = pModule.begin(); sect != sectEnd; ++sect) {
+    if (!isStreamed(**sect) || (*sect)->size() == 0)
+      continue;
+    MemoryRegion region = pOutput.request((*sect)->offset(), (*sect)->size());
+    if (region.size() == 0)
+      continue;
+
+    const SectionData* sd = (*sect)->getSectionData();
+    size_t offset = 0;
+    SectionData::const_iterator frag, fragEnd = sd->end();
+    for (frag = sd->begin(); frag != fragEnd; offset += frag->size(), ++frag) {
+      const RegionFragment* region_frag =
+          llvm::dyn_cast<RegionFragment>(&*frag);
+      if (region_frag != NULL && frag->size() != 0) {
+        const char* data = region_frag->getRegion().data();
+        std::vector<Mapping>::iterator mapping = std::upper_bound(
+            mappings.begin(), mappings.end(), data,
+            [](const char* pData, const Mapping& pMapping) {
+              return pData < pMapping.first;
+            });
+        if (mapping != mappings.begin()) {
+          --mapping;
+          if (data < mapping->first + mapping->second->size()) {
+            placements[mapping - mappings.begin()].push_back(
+                Placement(region_frag, (*sect)->offset() + offset));
+            continue;
+          }
+        }
+      }
+      SectionData::const_iterator next = frag;
+      emitFragments(frag, ++next, offset, region);
+    }
+  }
+
+  // copy the inputs one by one, and release their pages and the written
+  // pages of the output
+  uint8_t* output = pOutput.getBufferStart();
+  for (size_t i = 0; i < mappings.size(); ++i) {
+    if (placements[i].empty())
+      continue;
+    std::vector<Placement>::const_iterator place, placeEnd =
+        placements[i].end();
+    for (place = placements[i].begin(); place != placeEnd; ++place) {
+      llvm::StringRef data = place->first->getRegion();
+      memcpy(output + place->second, data.data(), data.size());
+      sys::ReleasePages(output + place->second, data.size());
+    }
+    mappings[i].second->release();
+  }
+}
+
 std::error_code ELFObjectWriter::writeObject(Module& pModule,
                                              FileOutputBuffer& pOutput) {
+  return writeObject(pModule, pOutput, std::function<void()>());
+}
+
+std::error_code ELFObjectWriter::writeObject(
+    Module& pModule,
+    FileOutputBuffer& pOutput,
+    const std::function<void()>& pApply) {
   bool is_dynobj = m_Config.codeGenType() == LinkerConfig::DynObj;
   bool is_exec = m_Config.codeGenType() == LinkerConfig::Exec;
   bool is_binary = m_Config.codeGenType() == LinkerConfig::Binary;
@@ -125,6 +312,11 @@ std::error_code ELFObjectWriter::writeObject(Module& pModule,
 
   assert(is_dynobj || is_exec || is_binary || is_object);
 
+  // the sections filled by applying relocations are written after pApply
+  SectionList applied, deferred;
+  if (pApply)
+    target().getSectionsChangedByApply(applied);
+
   if (is_dynobj || is_exec) {
     // Allow backend to sort symbols before emitting
     target().orderSymbolTable(pModule);
@@ -136,27 +328,24 @@ std::error_code ELFObjectWriter::writeObject(Module& pModule,
     target().emitDynNamePools(pModule, pOutput);
   }
 
-  if (is_object || is_dynobj || is_exec) {
-    // Write out name pool sections: .symtab, .strtab
-    target().emitRegNamePools(pModule, pOutput);
-  }
-
   if (is_binary) {
     // Iterate over the loadable segments and write the corresponding sections
+    SectionList sections;
     ELFSegmentFactory::iterator seg, segEnd = target().elfSegmentTable().end();
-
     for (seg = target().elfSegmentTable().begin(); seg != segEnd; ++seg) {
-      if (llvm::ELF::PT_LOAD == (*seg)->type()) {
-        ELFSegment::iterator sect, sectEnd = (*seg)->end();
-        for (sect = (*seg)->begin(); sect != sectEnd; ++sect)
-          writeSection(pModule, pOutput, *sect);
-      }
+      if (llvm::ELF::PT_LOAD == (*seg)->type())
+        sections.insert(sections.end(), (*seg)->begin(), (*seg)->end());
     }
+    takeSections(sections, applied, deferred);
+    writeSections(pModule, pOutput, sections);
   } else {
+    // Write out name pool sections: .symtab, .strtab
+    target().emitRegNamePools(pModule, pOutput);
+
     // Write out regular ELF sections
-    Module::iterator sect, sectEnd = pModule.end();
-    for (sect = pModule.begin(); sect != sectEnd; ++sect)
-      writeSection(pModule, pOutput, *sect);
+    SectionList sections(pModule.begin(), pModule.end());
+    takeSections(sections, applied, deferred);
+    writeSections(pModule, pOutput, sections);
 
     emitShStrTab(target().getOutputFormat()->getShStrTab(), pModule, pOutput);
 
@@ -179,6 +368,17 @@ std::error_code ELFObjectWriter::writeObject(Module& pModule,
     } else {
       return llvm::make_error_code(llvm::errc::function_not_supported);
     }
+
+    // Write out the debug sections left for the final pass
+    if (m_Config.options().streamDebugInfo())
+      streamDebugSections(pModule, pOutput);
+  }
+
+  if (pApply) {
+    pApply();
+    SectionList::iterator sect, sectEnd = deferred.end();
+    for (sect = deferred.begin(); sect != sectEnd; ++sect)
+      writeSection(pModule, pOutput, *sect);
   }
 
   return std::error_code();
@@ -561,6 +761,7 @@ void ELFObjectWriter::emitRela(const LinkerConfig& pConfig,
 /// getSectEntrySize - compute ElfXX_Shdr::sh_entsize
 template <size_t SIZE>
 uint64_t ELFObjectWriter::getSectEntrySize(const LDSection& pSection) const {
+  typedef typename ELFSizeTraits<SIZE>::Addr ElfXX_Addr;
   typedef typename ELFSizeTraits<SIZE>::Word ElfXX_Word;
   typedef typename ELFSizeTraits<SIZE>::Sym ElfXX_Sym;
   typedef typename ELFSizeTraits<SIZE>::Rel ElfXX_Rel;
@@ -574,15 +775,18 @@ uint64_t ELFObjectWriter::getSectEntrySize(const LDSection& pSection) const {
     return sizeof(ElfXX_Rel);
   if (llvm::ELF::SHT_RELA == pSection.type())
     return sizeof(ElfXX_Rela);
+  if (SHT_RELR == pSection.type())
+    return sizeof(ElfXX_Addr);
   if (llvm::ELF::SHT_HASH == pSection.type() ||
       llvm::ELF::SHT_GNU_HASH == pSection.type())
     return sizeof(ElfXX_Word);
   if (llvm::ELF::SHT_DYNAMIC == pSection.type())
     return sizeof(ElfXX_Dyn);
-  // FIXME: We should get the entsize from input since the size of each
-  // character is specified in the section header's sh_entsize field.
-  // For example, traditional string is 0x1, UCS-2 is 0x2, ... and so on.
+  // The size of each entry of a mergeable section comes from the inputs. For
+  // example, traditional string is 0x1, UCS-2 is 0x2, ... and so on.
   // Ref: http://www.sco.com/developers/gabi/2003-12-17/ch4.sheader.html
+  if ((pSection.flag() & llvm::ELF::SHF_MERGE) && pSection.entSize() != 0)
+    return pSection.entSize();
   if (pSection.flag() & llvm::ELF::SHF_STRINGS)
     return 0x1;
   return 0x0;
@@ -648,9 +852,17 @@ uint64_t ELFObjectWriter::getLastStartOffset<64>(const Module& pModule) const {
 /// emitSectionData
 void ELFObjectWriter::emitSectionData(const SectionData& pSD,
                                       MemoryRegion& pRegion) const {
-  SectionData::const_iterator fragIter, fragEnd = pSD.end();
-  size_t cur_offset = 0;
-  for (fragIter = pSD.begin(); fragIter != fragEnd; ++fragIter) {
+  emitFragments(pSD.begin(), pSD.end(), 0, pRegion);
+}
+
+/// emitFragments
+void ELFObjectWriter::emitFragments(SectionData::const_iterator pBegin,
+                                    SectionData::const_iterator pEnd,
+                                    size_t pOffset,
+                                    MemoryRegion& pRegion) const {
+  SectionData::const_iterator fragIter;
+  size_t cur_offset = pOffset;
+  for (fragIter = pBegin; fragIter != pEnd; ++fragIter) {
     size_t size = fragIter->size();
     switch (fragIter->getKind()) {
       case Fragment::Region: {
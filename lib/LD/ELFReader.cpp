@@ -9,6 +9,7 @@
 #include "mcld/LD/ELFReader.h"
 
 #include "mcld/IRBuilder.h"
+#include "mcld/ADT/SizeTraits.h"
 #include "mcld/Fragment/FillFragment.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDContext.h"
@@ -30,6 +31,113 @@
 
 namespace mcld {
 
+namespace {
+
+/// toHost - convert a field of a little-endian ELF file to the host order
+inline uint16_t toHost(uint16_t pValue) {
+  return llvm::sys::IsLittleEndianHost ? pValue : mcld::bswap16(pValue);
+}
+
+inline uint32_t toHost(uint32_t pValue) {
+  return llvm::sys::IsLittleEndianHost ? pValue : mcld::bswap32(pValue);
+}
+
+inline uint64_t toHost(uint64_t pValue) {
+  return llvm::sys::IsLittleEndianHost ? pValue : mcld::bswap64(pValue);
+}
+
+/// decodeELFSectionHeaders - decode the section header table of the
+/// SIZE-bit ELF file pImage
+template <size_t SIZE>
+bool decodeELFSectionHeaders(llvm::StringRef pImage, ELFTables& pTables) {
+  typedef typename ELFReader<SIZE, true>::ELFHeader ELFHeader;
+  typedef typename ELFReader<SIZE, true>::SectionHeader SectionHeader;
+
+  const ELFHeader* ehdr = reinterpret_cast<const ELFHeader*>(pImage.data());
+  uint64_t shoff = toHost(ehdr->e_shoff);
+  uint16_t shentsize = toHost(ehdr->e_shentsize);
+  uint64_t shnum = toHost(ehdr->e_shnum);
+  uint64_t shstrtab = toHost(ehdr->e_shstrndx);
+
+  // If the file has no section header table, e_shoff holds zero.
+  if (shoff == 0x0)
+    return true;
+
+  if (shentsize != sizeof(SectionHeader) || shoff > pImage.size() ||
+      pImage.size() - shoff < sizeof(SectionHeader))
+    return false;
+
+  // if shnum and shstrtab overflow, the actual values are in the 1st shdr
+  if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
+    const SectionHeader* shdr =
+        reinterpret_cast<const SectionHeader*>(pImage.data() + shoff);
+    if (shnum == llvm::ELF::SHN_UNDEF)
+      shnum = toHost(shdr->sh_size);
+    if (shstrtab == llvm::ELF::SHN_XINDEX)
+      shstrtab = toHost(shdr->sh_link);
+
+    shoff += shentsize;
+  }
+
+  if (shnum == 0x0)
+    return true;
+
+  if (shnum > (pImage.size() - shoff) / sizeof(SectionHeader) ||
+      shstrtab >= shnum)
+    return false;
+
+  const SectionHeader* shdr_tab =
+      reinterpret_cast<const SectionHeader*>(pImage.data() + shoff);
+
+  // get .shstrtab first
+  uint64_t str_offset = toHost(shdr_tab[shstrtab].sh_offset);
+  uint64_t str_size = toHost(shdr_tab[shstrtab].sh_size);
+  if (str_offset > pImage.size() || str_size > pImage.size() - str_offset)
+    return false;
+  pTables.setShStrTab(pImage.data() + str_offset);
+
+  ELFTables::SectionList& sections = pTables.sections();
+  sections.resize(shnum);
+  for (size_t idx = 0; idx < shnum; ++idx) {
+    ELFTables::Section& section = sections[idx];
+    section.Name = toHost(shdr_tab[idx].sh_name);
+    section.Type = toHost(shdr_tab[idx].sh_type);
+    section.Flags = toHost(shdr_tab[idx].sh_flags);
+    section.Offset = toHost(shdr_tab[idx].sh_offset);
+    section.Size = toHost(shdr_tab[idx].sh_size);
+    section.Link = toHost(shdr_tab[idx].sh_link);
+    section.Info = toHost(shdr_tab[idx].sh_info);
+    section.AddrAlign = toHost(shdr_tab[idx].sh_addralign);
+    section.EntSize = toHost(shdr_tab[idx].sh_entsize);
+    if (section.Name >= str_size)
+      return false;
+  }
+  return true;
+}
+
+/// decodeELFSymbols - decode the SIZE-bit ELF symbol table pRegion
+template <size_t SIZE>
+void decodeELFSymbols(llvm::StringRef pRegion,
+                      ELFTables::SymbolList& pSymbols) {
+  typedef typename ELFReader<SIZE, true>::Symbol Symbol;
+
+  size_t entsize = pRegion.size() / sizeof(Symbol);
+  const Symbol* symtab = reinterpret_cast<const Symbol*>(pRegion.data());
+
+  pSymbols.resize(entsize);
+  for (size_t idx = 0; idx < entsize; ++idx) {
+    ELFTables::Symbol& symbol = pSymbols[idx];
+    symbol.Name = toHost(symtab[idx].st_name);
+    symbol.Info = symtab[idx].st_info;
+    symbol.Other = symtab[idx].st_other;
+    symbol.Shndx = toHost(symtab[idx].st_shndx);
+    symbol.Value = toHost(symtab[idx].st_value);
+    symbol.Size = toHost(symtab[idx].st_size);
+  }
+}
+
+}  // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // ELFReader<32, true>
 //===----------------------------------------------------------------------===//
@@ -61,140 +169,17 @@ bool ELFReader<32, true>::readRegularSection(Input& pInput,
   return true;
 }
 
-/// readSymbols - read ELF symbols and create LDSymbol
-bool ELFReader<32, true>::readSymbols(Input& pInput,
-                                      IRBuilder& pBuilder,
-                                      llvm::StringRef pRegion,
-                                      const char* pStrTab) const {
-  // get number of symbols
-  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf32_Sym);
-  const llvm::ELF::Elf32_Sym* symtab =
-      reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.begin());
-
-  uint32_t st_name = 0x0;
-  uint32_t st_value = 0x0;
-  uint32_t st_size = 0x0;
-  uint8_t st_info = 0x0;
-  uint8_t st_other = 0x0;
-  uint16_t st_shndx = 0x0;
-
-  // skip the first NULL symbol
-  pInput.context()->addSymbol(LDSymbol::Null());
-
-  /// recording symbols added from DynObj to analyze weak alias
-  std::vector<AliasInfo> potential_aliases;
-  bool is_dyn_obj = (pInput.type() == Input::DynObj);
-  for (size_t idx = 1; idx < entsize; ++idx) {
-    st_info = symtab[idx].st_info;
-    st_other = symtab[idx].st_other;
-
-    if (llvm::sys::IsLittleEndianHost) {
-      st_name = symtab[idx].st_name;
-      st_value = symtab[idx].st_value;
-      st_size = symtab[idx].st_size;
-      st_shndx = symtab[idx].st_shndx;
-    } else {
-      st_name = mcld::bswap32(symtab[idx].st_name);
-      st_value = mcld::bswap32(symtab[idx].st_value);
-      st_size = mcld::bswap32(symtab[idx].st_size);
-      st_shndx = mcld::bswap16(symtab[idx].st_shndx);
-    }
-
-    // If the section should not be included, set the st_shndx SHN_UNDEF
-    // - A section in interrelated groups are not included.
-    if (pInput.type() == Input::Object && st_shndx < llvm::ELF::SHN_LORESERVE &&
-        st_shndx != llvm::ELF::SHN_UNDEF) {
-      if (pInput.context()->getSection(st_shndx) == NULL)
-        st_shndx = llvm::ELF::SHN_UNDEF;
-    }
-
-    // get ld_type
-    ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
-
-    // get ld_desc
-    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
-
-    // get ld_binding
-    ResolveInfo::Binding ld_binding =
-        getSymBinding((st_info >> 4), st_shndx, st_other);
-
-    // get ld_value - ld_value must be section relative.
-    uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
-
-    // get ld_vis
-    ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
-
-    // get section
-    LDSection* section = NULL;
-    if (st_shndx < llvm::ELF::SHN_LORESERVE)  // including ABS and COMMON
-      section = pInput.context()->getSection(st_shndx);
-
-    // get ld_name
-    std::string ld_name;
-    if (ResolveInfo::Section == ld_type) {
-      // Section symbol's st_name is the section index.
-      assert(section != NULL && "get a invalid section");
-      ld_name = section->name();
-    } else {
-      ld_name = std::string(pStrTab + st_name);
-    }
-
-    LDSymbol* psym = pBuilder.AddSymbol(pInput,
-                                        ld_name,
-                                        ld_type,
-                                        ld_desc,
-                                        ld_binding,
-                                        st_size,
-                                        ld_value,
-                                        section,
-                                        ld_vis);
-
-    if (is_dyn_obj && psym != NULL && ResolveInfo::Undefined != ld_desc &&
-        (ResolveInfo::Global == ld_binding ||
-         ResolveInfo::Weak == ld_binding) &&
-        ResolveInfo::Object == ld_type) {
-      AliasInfo p;
-      p.pt_alias = psym;
-      p.ld_binding = ld_binding;
-      p.ld_value = ld_value;
-      potential_aliases.push_back(p);
-    }
-  }  // end of for loop
-
-  // analyze weak alias
-  // FIXME: it is better to let IRBuilder handle alias anlysis.
-  //        1. eliminate code duplication
-  //        2. easy to know if a symbol is from .so
-  //           (so that it may be a potential alias)
-  if (is_dyn_obj) {
-    // sort symbols by symbol value and then weak before strong
-    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
-
-    // for each weak symbol, find out all its aliases, and
-    // then link them as a circular list in Module
-    std::vector<AliasInfo>::iterator sym_it, sym_e;
-    sym_e = potential_aliases.end();
-    for (sym_it = potential_aliases.begin(); sym_it != sym_e; ++sym_it) {
-      if (ResolveInfo::Weak != sym_it->ld_binding)
-        continue;
-
-      Module& pModule = pBuilder.getModule();
-      std::vector<AliasInfo>::iterator alias_it = sym_it + 1;
-      while (alias_it != sym_e) {
-        if (sym_it->ld_value != alias_it->ld_value)
-          break;
-
-        if (sym_it + 1 == alias_it)
-          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
-        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
-        ++alias_it;
-      }
-
-      sym_it = alias_it - 1;
-    }  // end of for loop
-  }
+/// decodeSectionHeaders - decode the section header table of pImage
+bool ELFReader<32, true>::decodeSectionHeaders(llvm::StringRef pImage,
+                                               ELFTables& pTables) const {
+  return decodeELFSectionHeaders<32>(pImage, pTables);
+}
 
-  return true;
+/// decodeSymbols - decode the symbol table pRegion
+void ELFReader<32, true>::decodeSymbols(
+    llvm::StringRef pRegion,
+    ELFTables::SymbolList& pSymbols) const {
+  decodeELFSymbols<32>(pRegion, pSymbols);
 }
 
 //===----------------------------------------------------------------------===//
@@ -299,133 +284,6 @@ Input::Type ELFReader<32, true>::fileType(const void* pELFHeader) const {
   }
 }
 
-/// readSectionHeaders - read ELF section header table and create LDSections
-bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
-                                             const void* pELFHeader) const {
-  const llvm::ELF::Elf32_Ehdr* ehdr =
-      reinterpret_cast<const llvm::ELF::Elf32_Ehdr*>(pELFHeader);
-
-  uint32_t shoff = 0x0;
-  uint16_t shentsize = 0x0;
-  uint32_t shnum = 0x0;
-  uint32_t shstrtab = 0x0;
-
-  if (llvm::sys::IsLittleEndianHost) {
-    shoff = ehdr->e_shoff;
-    shentsize = ehdr->e_shentsize;
-    shnum = ehdr->e_shnum;
-    shstrtab = ehdr->e_shstrndx;
-  } else {
-    shoff = mcld::bswap32(ehdr->e_shoff);
-    shentsize = mcld::bswap16(ehdr->e_shentsize);
-    shnum = mcld::bswap16(ehdr->e_shnum);
-    shstrtab = mcld::bswap16(ehdr->e_shstrndx);
-  }
-
-  // If the file has no section header table, e_shoff holds zero.
-  if (shoff == 0x0)
-    return true;
-
-  const llvm::ELF::Elf32_Shdr* shdr = NULL;
-  llvm::StringRef shdr_region;
-  uint32_t sh_name = 0x0;
-  uint32_t sh_type = 0x0;
-  uint32_t sh_flags = 0x0;
-  uint32_t sh_offset = 0x0;
-  uint32_t sh_size = 0x0;
-  uint32_t sh_link = 0x0;
-  uint32_t sh_info = 0x0;
-  uint32_t sh_addralign = 0x0;
-
-  // if shnum and shstrtab overflow, the actual values are in the 1st shdr
-  if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
-    shdr_region =
-        pInput.memArea()->request(pInput.fileOffset() + shoff, shentsize);
-    shdr = reinterpret_cast<const llvm::ELF::Elf32_Shdr*>(shdr_region.begin());
-
-    if (llvm::sys::IsLittleEndianHost) {
-      sh_size = shdr->sh_size;
-      sh_link = shdr->sh_link;
-    } else {
-      sh_size = mcld::bswap32(shdr->sh_size);
-      sh_link = mcld::bswap32(shdr->sh_link);
-    }
-
-    if (shnum == llvm::ELF::SHN_UNDEF)
-      shnum = sh_size;
-    if (shstrtab == llvm::ELF::SHN_XINDEX)
-      shstrtab = sh_link;
-
-    shoff += shentsize;
-  }
-
-  shdr_region =
-      pInput.memArea()->request(pInput.fileOffset() + shoff, shnum * shentsize);
-  const llvm::ELF::Elf32_Shdr* shdrTab =
-      reinterpret_cast<const llvm::ELF::Elf32_Shdr*>(shdr_region.begin());
-
-  // get .shstrtab first
-  shdr = &shdrTab[shstrtab];
-  if (llvm::sys::IsLittleEndianHost) {
-    sh_offset = shdr->sh_offset;
-    sh_size = shdr->sh_size;
-  } else {
-    sh_offset = mcld::bswap32(shdr->sh_offset);
-    sh_size = mcld::bswap32(shdr->sh_size);
-  }
-
-  llvm::StringRef sect_name_region =
-      pInput.memArea()->request(pInput.fileOffset() + sh_offset, sh_size);
-  const char* sect_name = sect_name_region.begin();
-
-  LinkInfoList link_info_list;
-
-  // create all LDSections, including first NULL section.
-  for (size_t idx = 0; idx < shnum; ++idx) {
-    if (llvm::sys::IsLittleEndianHost) {
-      sh_name = shdrTab[idx].sh_name;
-      sh_type = shdrTab[idx].sh_type;
-      sh_flags = shdrTab[idx].sh_flags;
-      sh_offset = shdrTab[idx].sh_offset;
-      sh_size = shdrTab[idx].sh_size;
-      sh_link = shdrTab[idx].sh_link;
-      sh_info = shdrTab[idx].sh_info;
-      sh_addralign = shdrTab[idx].sh_addralign;
-    } else {
-      sh_name = mcld::bswap32(shdrTab[idx].sh_name);
-      sh_type = mcld::bswap32(shdrTab[idx].sh_type);
-      sh_flags = mcld::bswap32(shdrTab[idx].sh_flags);
-      sh_offset = mcld::bswap32(shdrTab[idx].sh_offset);
-      sh_size = mcld::bswap32(shdrTab[idx].sh_size);
-      sh_link = mcld::bswap32(shdrTab[idx].sh_link);
-      sh_info = mcld::bswap32(shdrTab[idx].sh_info);
-      sh_addralign = mcld::bswap32(shdrTab[idx].sh_addralign);
-    }
-
-    LDSection* section = IRBuilder::CreateELFHeader(
-        pInput, sect_name + sh_name, sh_type, sh_flags, sh_addralign);
-    section->setSize(sh_size);
-    section->setOffset(sh_offset);
-    section->setInfo(sh_info);
-
-    if (sh_link != 0x0 || sh_info != 0x0) {
-      LinkInfo link_info = {section, sh_link, sh_info};
-      link_info_list.push_back(link_info);
-    }
-  }  // end of for
-
-  // set up InfoLink
-  LinkInfoList::iterator info, infoEnd = link_info_list.end();
-  for (info = link_info_list.begin(); info != infoEnd; ++info) {
-    if (LDFileFormat::Relocation == info->section->kind())
-      info->section->setLink(pInput.context()->getSection(info->sh_info));
-    else
-      info->section->setLink(pInput.context()->getSection(info->sh_link));
-  }
-
-  return true;
-}
-
 /// readSignature - read a symbol from the given Input and index in symtab
 /// This is used to get the signature of a group section.
 ResolveInfo* ELFReader<32, true>::readSignature(Input& pInput,
@@ -530,6 +388,7 @@ bool ELFReader<32, true>::readDynamic(Input& pInput) const {
   return true;
 }
 
+
 //===----------------------------------------------------------------------===//
 // ELFReader<64, true>
 //===----------------------------------------------------------------------===//
@@ -561,135 +420,17 @@ bool ELFReader<64, true>::readRegularSection(Input& pInput,
   return true;
 }
 
-/// readSymbols - read ELF symbols and create LDSymbol
-bool ELFReader<64, true>::readSymbols(Input& pInput,
-                                      IRBuilder& pBuilder,
-                                      llvm::StringRef pRegion,
-                                      const char* pStrTab) const {
-  // get number of symbols
-  size_t entsize = pRegion.size() / sizeof(llvm::ELF::Elf64_Sym);
-  const llvm::ELF::Elf64_Sym* symtab =
-      reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.begin());
-
-  uint32_t st_name = 0x0;
-  uint64_t st_value = 0x0;
-  uint64_t st_size = 0x0;
-  uint8_t st_info = 0x0;
-  uint8_t st_other = 0x0;
-  uint16_t st_shndx = 0x0;
-
-  // skip the first NULL symbol
-  pInput.context()->addSymbol(LDSymbol::Null());
-
-  /// recording symbols added from DynObj to analyze weak alias
-  std::vector<AliasInfo> potential_aliases;
-  bool is_dyn_obj = (pInput.type() == Input::DynObj);
-  for (size_t idx = 1; idx < entsize; ++idx) {
-    st_info = symtab[idx].st_info;
-    st_other = symtab[idx].st_other;
-
-    if (llvm::sys::IsLittleEndianHost) {
-      st_name = symtab[idx].st_name;
-      st_value = symtab[idx].st_value;
-      st_size = symtab[idx].st_size;
-      st_shndx = symtab[idx].st_shndx;
-    } else {
-      st_name = mcld::bswap32(symtab[idx].st_name);
-      st_value = mcld::bswap64(symtab[idx].st_value);
-      st_size = mcld::bswap64(symtab[idx].st_size);
-      st_shndx = mcld::bswap16(symtab[idx].st_shndx);
-    }
-
-    // If the section should not be included, set the st_shndx SHN_UNDEF
-    // - A section in interrelated groups are not included.
-    if (pInput.type() == Input::Object && st_shndx < llvm::ELF::SHN_LORESERVE &&
-        st_shndx != llvm::ELF::SHN_UNDEF) {
-      if (pInput.context()->getSection(st_shndx) == NULL)
-        st_shndx = llvm::ELF::SHN_UNDEF;
-    }
-
-    // get ld_type
-    ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
-
-    // get ld_desc
-    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
-
-    // get ld_binding
-    ResolveInfo::Binding ld_binding =
-        getSymBinding((st_info >> 4), st_shndx, st_other);
-
-    // get ld_value - ld_value must be section relative.
-    uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
-
-    // get ld_vis
-    ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
-
-    // get section
-    LDSection* section = NULL;
-    if (st_shndx < llvm::ELF::SHN_LORESERVE)  // including ABS and COMMON
-      section = pInput.context()->getSection(st_shndx);
-
-    // get ld_name
-    std::string ld_name;
-    if (ResolveInfo::Section == ld_type) {
-      // Section symbol's st_name is the section index.
-      assert(section != NULL && "get a invalid section");
-      ld_name = section->name();
-    } else {
-      ld_name = std::string(pStrTab + st_name);
-    }
+/// decodeSectionHeaders - decode the section header table of pImage
+bool ELFReader<64, true>::decodeSectionHeaders(llvm::StringRef pImage,
+                                               ELFTables& pTables) const {
+  return decodeELFSectionHeaders<64>(pImage, pTables);
+}
 
-    LDSymbol* psym = pBuilder.AddSymbol(pInput,
-                                        ld_name,
-                                        ld_type,
-                                        ld_desc,
-                                        ld_binding,
-                                        st_size,
-                                        ld_value,
-                                        section,
-                                        ld_vis);
-
-    if (is_dyn_obj && psym != NULL && ResolveInfo::Undefined != ld_desc &&
-        (ResolveInfo::Global == ld_binding ||
-         ResolveInfo::Weak == ld_binding) &&
-        ResolveInfo::Object == ld_type) {
-      AliasInfo p;
-      p.pt_alias = psym;
-      p.ld_binding = ld_binding;
-      p.ld_value = ld_value;
-      potential_aliases.push_back(p);
-    }
-  }  // end of for loop
-
-  // analyze weak alias here
-  if (is_dyn_obj) {
-    // sort symbols by symbol value and then weak before strong
-    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
-
-    // for each weak symbol, find out all its aliases, and
-    // then link them as a circular list in Module
-    std::vector<AliasInfo>::iterator sym_it, sym_e;
-    sym_e = potential_aliases.end();
-    for (sym_it = potential_aliases.begin(); sym_it != sym_e; ++sym_it) {
-      if (ResolveInfo::Weak != sym_it->ld_binding)
-        continue;
-
-      Module& pModule = pBuilder.getModule();
-      std::vector<AliasInfo>::iterator alias_it = sym_it + 1;
-      while (alias_it != sym_e) {
-        if (sym_it->ld_value != alias_it->ld_value)
-          break;
-
-        if (sym_it + 1 == alias_it)
-          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
-        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
-        ++alias_it;
-      }
-
-      sym_it = alias_it - 1;
-    }  // end of for loop
-  }
-  return true;
+/// decodeSymbols - decode the symbol table pRegion
+void ELFReader<64, true>::decodeSymbols(
+    llvm::StringRef pRegion,
+    ELFTables::SymbolList& pSymbols) const {
+  decodeELFSymbols<64>(pRegion, pSymbols);
 }
 
 //===----------------------------------------------------------------------===//
@@ -793,133 +534,6 @@ Input::Type ELFReader<64, true>::fileType(const void* pELFHeader) const {
   }
 }
 
-/// readSectionHeaders - read ELF section header table and create LDSections
-bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
-                                             const void* pELFHeader) const {
-  const llvm::ELF::Elf64_Ehdr* ehdr =
-      reinterpret_cast<const llvm::ELF::Elf64_Ehdr*>(pELFHeader);
-
-  uint64_t shoff = 0x0;
-  uint16_t shentsize = 0x0;
-  uint32_t shnum = 0x0;
-  uint32_t shstrtab = 0x0;
-
-  if (llvm::sys::IsLittleEndianHost) {
-    shoff = ehdr->e_shoff;
-    shentsize = ehdr->e_shentsize;
-    shnum = ehdr->e_shnum;
-    shstrtab = ehdr->e_shstrndx;
-  } else {
-    shoff = mcld::bswap64(ehdr->e_shoff);
-    shentsize = mcld::bswap16(ehdr->e_shentsize);
-    shnum = mcld::bswap16(ehdr->e_shnum);
-    shstrtab = mcld::bswap16(ehdr->e_shstrndx);
-  }
-
-  // If the file has no section header table, e_shoff holds zero.
-  if (shoff == 0x0)
-    return true;
-
-  const llvm::ELF::Elf64_Shdr* shdr = NULL;
-  llvm::StringRef shdr_region;
-  uint32_t sh_name = 0x0;
-  uint32_t sh_type = 0x0;
-  uint64_t sh_flags = 0x0;
-  uint64_t sh_offset = 0x0;
-  uint64_t sh_size = 0x0;
-  uint32_t sh_link = 0x0;
-  uint32_t sh_info = 0x0;
-  uint64_t sh_addralign = 0x0;
-
-  // if shnum and shstrtab overflow, the actual values are in the 1st shdr
-  if (shnum == llvm::ELF::SHN_UNDEF || shstrtab == llvm::ELF::SHN_XINDEX) {
-    shdr_region =
-        pInput.memArea()->request(pInput.fileOffset() + shoff, shentsize);
-    shdr = reinterpret_cast<const llvm::ELF::Elf64_Shdr*>(shdr_region.begin());
-
-    if (llvm::sys::IsLittleEndianHost) {
-      sh_size = shdr->sh_size;
-      sh_link = shdr->sh_link;
-    } else {
-      sh_size = mcld::bswap64(shdr->sh_size);
-      sh_link = mcld::bswap32(shdr->sh_link);
-    }
-
-    if (shnum == llvm::ELF::SHN_UNDEF)
-      shnum = sh_size;
-    if (shstrtab == llvm::ELF::SHN_XINDEX)
-      shstrtab = sh_link;
-
-    shoff += shentsize;
-  }
-
-  shdr_region =
-      pInput.memArea()->request(pInput.fileOffset() + shoff, shnum * shentsize);
-  const llvm::ELF::Elf64_Shdr* shdrTab =
-      reinterpret_cast<const llvm::ELF::Elf64_Shdr*>(shdr_region.begin());
-
-  // get .shstrtab first
-  shdr = &shdrTab[shstrtab];
-  if (llvm::sys::IsLittleEndianHost) {
-    sh_offset = shdr->sh_offset;
-    sh_size = shdr->sh_size;
-  } else {
-    sh_offset = mcld::bswap64(shdr->sh_offset);
-    sh_size = mcld::bswap64(shdr->sh_size);
-  }
-
-  llvm::StringRef sect_name_region =
-      pInput.memArea()->request(pInput.fileOffset() + sh_offset, sh_size);
-  const char* sect_name = sect_name_region.begin();
-
-  LinkInfoList link_info_list;
-
-  // create all LDSections, including first NULL section.
-  for (size_t idx = 0; idx < shnum; ++idx) {
-    if (llvm::sys::IsLittleEndianHost) {
-      sh_name = shdrTab[idx].sh_name;
-      sh_type = shdrTab[idx].sh_type;
-      sh_flags = shdrTab[idx].sh_flags;
-      sh_offset = shdrTab[idx].sh_offset;
-      sh_size = shdrTab[idx].sh_size;
-      sh_link = shdrTab[idx].sh_link;
-      sh_info = shdrTab[idx].sh_info;
-      sh_addralign = shdrTab[idx].sh_addralign;
-    } else {
-      sh_name = mcld::bswap32(shdrTab[idx].sh_name);
-      sh_type = mcld::bswap32(shdrTab[idx].sh_type);
-      sh_flags = mcld::bswap64(shdrTab[idx].sh_flags);
-      sh_offset = mcld::bswap64(shdrTab[idx].sh_offset);
-      sh_size = mcld::bswap64(shdrTab[idx].sh_size);
-      sh_link = mcld::bswap32(shdrTab[idx].sh_link);
-      sh_info = mcld::bswap32(shdrTab[idx].sh_info);
-      sh_addralign = mcld::bswap64(shdrTab[idx].sh_addralign);
-    }
-
-    LDSection* section = IRBuilder::CreateELFHeader(
-        pInput, sect_name + sh_name, sh_type, sh_flags, sh_addralign);
-    section->setSize(sh_size);
-    section->setOffset(sh_offset);
-    section->setInfo(sh_info);
-
-    if (sh_link != 0x0 || sh_info != 0x0) {
-      LinkInfo link_info = {section, sh_link, sh_info};
-      link_info_list.push_back(link_info);
-    }
-  }  // end of for
-
-  // set up InfoLink
-  LinkInfoList::iterator info, infoEnd = link_info_list.end();
-  for (info = link_info_list.begin(); info != infoEnd; ++info) {
-    if (LDFileFormat::Relocation == info->section->kind())
-      info->section->setLink(pInput.context()->getSection(info->sh_info));
-    else
-      info->section->setLink(pInput.context()->getSection(info->sh_link));
-  }
-
-  return true;
-}
-
 /// readSignature - read a symbol from the given Input and index in symtab
 /// This is used to get the signature of a group section.
 ResolveInfo* ELFReader<64, true>::readSignature(Input& pInput,
@@ -1024,4 +638,5 @@ bool ELFReader<64, true>::readDynamic(Input& pInput) const {
   return true;
 }
 
+
 }  // namespace mcld
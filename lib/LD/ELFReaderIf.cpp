@@ -12,7 +12,10 @@
 #include "mcld/Fragment/FillFragment.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDContext.h"
+#include "mcld/LD/NamePool.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/Module.h"
+#include "mcld/Support/MemoryArea.h"
 #include "mcld/Target/GNULDBackend.h"
 
 #include <llvm/ADT/StringRef.h>
@@ -20,10 +23,28 @@
 #include <llvm/Support/ELF.h>
 #include <llvm/Support/Host.h>
 
+#include <algorithm>
 #include <cstring>
 
 namespace mcld {
 
+namespace {
+
+/// touchRegion - read one byte of every page in pRegion, so that the pages
+/// are mapped in before the sequential readers reach them.
+void touchRegion(llvm::StringRef pRegion) {
+  // the smallest page size of the supported hosts
+  static const size_t kPageSize = 0x1000;
+  volatile char sink = 0;
+  for (size_t offset = 0; offset < pRegion.size(); offset += kPageSize)
+    sink = pRegion[offset];
+  if (!pRegion.empty())
+    sink = pRegion.back();
+  (void)sink;
+}
+
+}  // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // ELFReaderIF
 //===----------------------------------------------------------------------===//
@@ -151,4 +172,358 @@ uint64_t ELFReaderIF::getSymValue(uint64_t pValue,
   return pValue;
 }
 
+/// isPooledSymbol - local and section symbols are never resolved, and
+/// dynamic objects do not export their hidden and internal symbols.
+bool ELFReaderIF::isPooledSymbol(uint8_t pInfo,
+                                 uint8_t pOther,
+                                 bool pIsDynObj) {
+  if ((pInfo >> 4) == llvm::ELF::STB_LOCAL ||
+      (pInfo & 0xf) == llvm::ELF::STT_SECTION)
+    return false;
+
+  if (pIsDynObj) {
+    uint8_t vis = pOther & 0x3;
+    if (vis == llvm::ELF::STV_INTERNAL || vis == llvm::ELF::STV_HIDDEN)
+      return false;
+  }
+  return true;
+}
+
+/// lookupSymbols - look up the names of the pooled symbols of an input
+void ELFReaderIF::lookupSymbols(IRBuilder& pBuilder,
+                                const std::vector<llvm::StringRef>& pNames,
+                                std::vector<ResolveInfo*>& pEntries) const {
+  // starting the threads costs more than hashing a small symbol table
+  static const size_t kMinParallelSymbols = 4096;
+
+  const GeneralOptions& options = pBuilder.getConfig().options();
+  unsigned num_threads = 1;
+  if (options.hasThreads() && pNames.size() >= kMinParallelSymbols)
+    num_threads = options.numThreads();
+
+  pBuilder.getModule().getNamePool().lookupSymbols(
+      pNames, pEntries, num_threads);
+}
+
+/// destructor
+ELFReaderIF::~ELFReaderIF() {
+  TablesMap::iterator it, itEnd = m_Tables.end();
+  for (it = m_Tables.begin(); it != itEnd; ++it)
+    delete it->second;
+}
+
+/// readSectionHeaders - create the LDSections of pInput from the prefetched
+/// tables, or decode the section header table if there are none.
+bool ELFReaderIF::readSectionHeaders(Input& pInput,
+                                     const void* pELFHeader) const {
+  const ELFTables* tables = getTables(pInput);
+  if (tables != NULL)
+    return createSections(pInput, *tables);
+
+  ELFTables local;
+  llvm::StringRef image(
+      reinterpret_cast<const char*>(pELFHeader),
+      pInput.memArea()->size() - pInput.fileOffset());
+  if (!decodeSectionHeaders(image, local)) {
+    fatal(diag::fatal_cannot_read_input) << pInput.path();
+    return false;
+  }
+  return createSections(pInput, local);
+}
+
+/// createSections - create all LDSections, including the first NULL section
+bool ELFReaderIF::createSections(Input& pInput,
+                                 const ELFTables& pTables) const {
+  LinkInfoList link_info_list;
+
+  const ELFTables::SectionList& sections = pTables.sections();
+  ELFTables::SectionList::const_iterator shdr, shdrEnd = sections.end();
+  for (shdr = sections.begin(); shdr != shdrEnd; ++shdr) {
+    LDSection* section =
+        IRBuilder::CreateELFHeader(pInput,
+                                   pTables.shStrTab() + shdr->Name,
+                                   shdr->Type,
+                                   shdr->Flags,
+                                   shdr->AddrAlign);
+    section->setSize(shdr->Size);
+    section->setOffset(shdr->Offset);
+    section->setInfo(shdr->Info);
+    section->setEntSize(shdr->EntSize);
+
+    if (shdr->Link != 0x0 || shdr->Info != 0x0) {
+      LinkInfo link_info = {section, shdr->Link, shdr->Info};
+      link_info_list.push_back(link_info);
+    }
+  }
+
+  // set up InfoLink
+  LinkInfoList::iterator info, infoEnd = link_info_list.end();
+  for (info = link_info_list.begin(); info != infoEnd; ++info) {
+    if (LDFileFormat::Relocation == info->section->kind())
+      info->section->setLink(pInput.context()->getSection(info->sh_info));
+    else
+      info->section->setLink(pInput.context()->getSection(info->sh_link));
+  }
+
+  return true;
+}
+
+/// readSymbols - read ELF symbols and create LDSymbol
+bool ELFReaderIF::readSymbols(Input& pInput,
+                              IRBuilder& pBuilder,
+                              llvm::StringRef pRegion,
+                              const char* pStrTab) const {
+  ELFTables::SymbolList symbols;
+  decodeSymbols(pRegion, symbols);
+  return addSymbols(pInput, pBuilder, symbols, pStrTab);
+}
+
+/// addSymbols - create the LDSymbols of pInput from its decoded symbol table
+bool ELFReaderIF::addSymbols(Input& pInput,
+                             IRBuilder& pBuilder,
+                             const ELFTables::SymbolList& pSymbols,
+                             const char* pStrTab) const {
+  size_t entsize = pSymbols.size();
+
+  // skip the first NULL symbol
+  pInput.context()->addSymbol(LDSymbol::Null());
+
+  /// recording symbols added from DynObj to analyze weak alias
+  std::vector<AliasInfo> potential_aliases;
+  bool is_dyn_obj = (pInput.type() == Input::DynObj);
+
+  // look up the names of the pooled symbols first, then add the symbols in
+  // order through their entries.
+  std::vector<llvm::StringRef> names;
+  std::vector<size_t> pooled_syms;
+  for (size_t idx = 1; idx < entsize; ++idx) {
+    if (!isPooledSymbol(pSymbols[idx].Info, pSymbols[idx].Other, is_dyn_obj))
+      continue;
+    names.push_back(llvm::StringRef(pStrTab + pSymbols[idx].Name));
+    pooled_syms.push_back(idx);
+  }
+  std::vector<ResolveInfo*> entries;
+  lookupSymbols(pBuilder, names, entries);
+
+  size_t next_pooled = 0;
+  for (size_t idx = 1; idx < entsize; ++idx) {
+    const ELFTables::Symbol& sym = pSymbols[idx];
+    uint16_t st_shndx = sym.Shndx;
+
+    // If the section should not be included, set the st_shndx SHN_UNDEF
+    // - A section in interrelated groups are not included.
+    if (pInput.type() == Input::Object && st_shndx < llvm::ELF::SHN_LORESERVE &&
+        st_shndx != llvm::ELF::SHN_UNDEF) {
+      if (pInput.context()->getSection(st_shndx) == NULL)
+        st_shndx = llvm::ELF::SHN_UNDEF;
+    }
+
+    // get ld_type
+    ResolveInfo::Type ld_type = getSymType(sym.Info, st_shndx);
+
+    // get ld_desc
+    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
+
+    // get ld_binding
+    ResolveInfo::Binding ld_binding =
+        getSymBinding((sym.Info >> 4), st_shndx, sym.Other);
+
+    // get ld_value - ld_value must be section relative.
+    uint64_t ld_value = getSymValue(sym.Value, st_shndx, pInput);
+
+    // get ld_vis
+    ResolveInfo::Visibility ld_vis = getSymVisibility(sym.Other);
+
+    // get section
+    LDSection* section = NULL;
+    if (st_shndx < llvm::ELF::SHN_LORESERVE)  // including ABS and COMMON
+      section = pInput.context()->getSection(st_shndx);
+
+    // get ld_name
+    llvm::StringRef ld_name;
+    if (ResolveInfo::Section == ld_type) {
+      // Section symbol's st_name is the section index.
+      assert(section != NULL && "get a invalid section");
+      ld_name = section->name();
+    } else {
+      ld_name = pStrTab + sym.Name;
+    }
+
+    ResolveInfo* entry = NULL;
+    if (next_pooled < pooled_syms.size() && pooled_syms[next_pooled] == idx)
+      entry = entries[next_pooled++];
+
+    LDSymbol* psym = pBuilder.AddSymbol(pInput,
+                                        ld_name,
+                                        ld_type,
+                                        ld_desc,
+                                        ld_binding,
+                                        sym.Size,
+                                        ld_value,
+                                        section,
+                                        ld_vis,
+                                        entry);
+
+    if (is_dyn_obj && psym != NULL && ResolveInfo::Undefined != ld_desc &&
+        (ResolveInfo::Global == ld_binding ||
+         ResolveInfo::Weak == ld_binding) &&
+        ResolveInfo::Object == ld_type) {
+      AliasInfo p;
+      p.pt_alias = psym;
+      p.ld_binding = ld_binding;
+      p.ld_value = ld_value;
+      potential_aliases.push_back(p);
+    }
+  }  // end of for loop
+
+  // analyze weak alias
+  // FIXME: it is better to let IRBuilder handle alias anlysis.
+  //        1. eliminate code duplication
+  //        2. easy to know if a symbol is from .so
+  //           (so that it may be a potential alias)
+  if (is_dyn_obj) {
+    // sort symbols by symbol value and then weak before strong
+    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
+
+    // for each weak symbol, find out all its aliases, and
+    // then link them as a circular list in Module
+    std::vector<AliasInfo>::iterator sym_it, sym_e;
+    sym_e = potential_aliases.end();
+    for (sym_it = potential_aliases.begin(); sym_it != sym_e; ++sym_it) {
+      if (ResolveInfo::Weak != sym_it->ld_binding)
+        continue;
+
+      Module& pModule = pBuilder.getModule();
+      std::vector<AliasInfo>::iterator alias_it = sym_it + 1;
+      while (alias_it != sym_e) {
+        if (sym_it->ld_value != alias_it->ld_value)
+          break;
+
+        if (sym_it + 1 == alias_it)
+          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
+        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
+        ++alias_it;
+      }
+
+      sym_it = alias_it - 1;
+    }  // end of for loop
+  }
+
+  return true;
+}
+
+/// less - sort symbols by symbol value and then weak before strong
+bool ELFReaderIF::less(const AliasInfo& p1, const AliasInfo& p2) {
+  if (p1.ld_value != p2.ld_value)
+    return (p1.ld_value < p2.ld_value);
+  if (p1.ld_binding != p2.ld_binding) {
+    if (ResolveInfo::Weak == p1.ld_binding)
+      return true;
+    else if (ResolveInfo::Weak == p2.ld_binding)
+      return false;
+  }
+  return p1.pt_alias->str() < p2.pt_alias->str();
+}
+
+/// decodeTables - check the ELF header of pImage, then decode its section
+/// header table and, if pSymbols is set, its symbol table.
+bool ELFReaderIF::decodeTables(llvm::StringRef pImage,
+                               Input::Type pType,
+                               bool pSymbols,
+                               ELFTables& pTables) const {
+  if (pImage.size() < getELFHeaderSize())
+    return false;
+
+  const void* ehdr = pImage.data();
+  unsigned char elf_class =
+      (getELFHeaderSize() == sizeof(llvm::ELF::Elf32_Ehdr))
+          ? llvm::ELF::ELFCLASS32
+          : llvm::ELF::ELFCLASS64;
+  if (!isELF(ehdr) || pImage[llvm::ELF::EI_CLASS] != elf_class ||
+      !isMyEndian(ehdr) || !isMyMachine(ehdr) || pType != fileType(ehdr))
+    return false;
+
+  if (!decodeSectionHeaders(pImage, pTables))
+    return false;
+
+  if (!pSymbols)
+    return true;
+
+  // a shared object is linked against its .dynsym, an object its .symtab
+  llvm::StringRef symtab_name =
+      (pType == Input::DynObj) ? ".dynsym" : ".symtab";
+  const ELFTables::SectionList& sections = pTables.sections();
+  for (size_t idx = 0; idx < sections.size(); ++idx) {
+    const ELFTables::Section& symtab = sections[idx];
+    if (symtab_name != pTables.shStrTab() + symtab.Name)
+      continue;
+
+    if (symtab.Link >= sections.size())
+      return true;
+    const ELFTables::Section& strtab = sections[symtab.Link];
+    if (symtab.Offset > pImage.size() ||
+        symtab.Size > pImage.size() - symtab.Offset ||
+        strtab.Offset > pImage.size() ||
+        strtab.Size > pImage.size() - strtab.Offset)
+      return true;
+
+    decodeSymbols(pImage.substr(symtab.Offset, symtab.Size),
+                  pTables.symbols());
+    pTables.setSymTab(symtab.Offset, symtab.Size);
+    touchRegion(pImage.substr(strtab.Offset, strtab.Size));
+    break;
+  }
+  return true;
+}
+
+/// prefetch - decode the tables of the ELF file at pFileOffset of pArea
+bool ELFReaderIF::prefetch(MemoryArea& pArea,
+                           uint64_t pFileOffset,
+                           Input::Type pType,
+                           bool pSymbols) {
+  if (pArea.size() < pFileOffset)
+    return false;
+
+  llvm::StringRef image =
+      pArea.request(pFileOffset, pArea.size() - pFileOffset);
+  ELFTables* tables = new ELFTables();
+  if (!decodeTables(image, pType, pSymbols, *tables)) {
+    delete tables;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_TablesMutex);
+  ELFTables*& slot = m_Tables[image.data()];
+  delete slot;
+  slot = tables;
+  return true;
+}
+
+/// getTables - the tables of pInput decoded by prefetch, or NULL
+const ELFTables* ELFReaderIF::getTables(Input& pInput) const {
+  if (!pInput.hasMemArea())
+    return NULL;
+
+  const void* key = pInput.memArea()->request(pInput.fileOffset(), 0).data();
+  std::lock_guard<std::mutex> lock(m_TablesMutex);
+  TablesMap::const_iterator it = m_Tables.find(key);
+  if (it == m_Tables.end())
+    return NULL;
+  return it->second;
+}
+
+/// releaseTables - free the tables of pInput once its symbols are read
+void ELFReaderIF::releaseTables(Input& pInput) {
+  if (!pInput.hasMemArea())
+    return;
+
+  const void* key = pInput.memArea()->request(pInput.fileOffset(), 0).data();
+  std::lock_guard<std::mutex> lock(m_TablesMutex);
+  TablesMap::iterator it = m_Tables.find(key);
+  if (it == m_Tables.end())
+    return;
+  delete it->second;
+  m_Tables.erase(it);
+}
+
 }  // namespace mcld
@@ -15,18 +15,23 @@
 #include "mcld/MC/Attribute.h"
 #include "mcld/MC/Input.h"
 #include "mcld/LD/ELFObjectReader.h"
+#include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/Support/FileHandle.h"
 #include "mcld/Support/FileSystem.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/Parallel.h"
 #include "mcld/Support/Path.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Host.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 namespace mcld {
 
@@ -92,7 +97,8 @@ bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
     return includeAllMembers(pConfig, pArchive);
 
   // if this is the first time read this archive, setup symtab and strtab
-  if (pArchive.getSymbolTable().empty()) {
+  bool first_visit = pArchive.getSymbolTable().empty();
+  if (first_visit) {
     // read the symtab of the archive
     readSymbolTable(pArchive);
 
@@ -105,38 +111,162 @@ bool GNUArchiveReader::readArchive(const LinkerConfig& pConfig,
                               &InputTree::Downward);
   }
 
-  // include the needed members in the archive and build up the input tree
-  bool willSymResolved;
-  do {
-    willSymResolved = false;
-    for (size_t idx = 0; idx < pArchive.numOfSymbols(); ++idx) {
-      // bypass if we already decided to include this symbol or not
-      if (Archive::Symbol::Unknown != pArchive.getSymbolStatus(idx))
-        continue;
-
-      // bypass if another symbol with the same object file offset is included
-      if (pArchive.hasObjectMember(pArchive.getObjFileOffset(idx))) {
-        pArchive.setSymbolStatus(idx, Archive::Symbol::Include);
-        continue;
+  Module::ObjectList& objects = m_Module.getObjectList();
+  size_t num_libs = m_Module.getLibraryList().size();
+
+  // with --threads, the members are decoded in parallel before they are read
+  bool prefetch = pConfig.options().hasThreads() &&
+                  !isThinArchive(pArchive.getARFile());
+
+  // scan the whole symtab when the archive is read the first time. Shared
+  // objects do not keep their undefined symbols in the input context, so also
+  // scan it again if there are new shared objects.
+  if (first_visit || pArchive.numOfVisitedLibraries() != num_libs) {
+    // the objects read so far are checked by the scan
+    if (first_visit)
+      pArchive.setNumOfVisitedObjects(objects.size());
+
+    if (prefetch) {
+      std::vector<uint32_t> offsets;
+      for (size_t idx = 0; idx < pArchive.numOfSymbols(); ++idx)
+        collectMember(pArchive, idx, offsets);
+      prefetchMembers(pConfig, pArchive, offsets);
+    }
+
+    for (size_t idx = 0; idx < pArchive.numOfSymbols(); ++idx)
+      includeSymbol(pConfig, pArchive, idx);
+  }
+  pArchive.setNumOfVisitedLibraries(num_libs);
+
+  // only the undefined symbols of the objects read after the last visit,
+  // including the members we just included, can pull in more members. Look
+  // up their names instead of rescanning the whole symtab.
+  while (pArchive.numOfVisitedObjects() < objects.size()) {
+    // decode the members the objects of this round may pull in ahead of
+    // reading them one by one
+    size_t end = objects.size();
+    if (prefetch) {
+      std::vector<uint32_t> offsets;
+      for (size_t obj = pArchive.numOfVisitedObjects(); obj < end; ++obj) {
+        LDContext* context = objects[obj]->context();
+        LDContext::sym_iterator sym, symEnd = context->symTabEnd();
+        for (sym = context->symTabBegin(); sym != symEnd; ++sym) {
+          const Archive::SymbolIndices* indices =
+              findUndefSymbols(pArchive, **sym);
+          if (indices == NULL)
+            continue;
+
+          Archive::SymbolIndices::const_iterator idx, idxEnd = indices->end();
+          for (idx = indices->begin(); idx != idxEnd; ++idx)
+            collectMember(pArchive, *idx, offsets);
+        }
       }
+      prefetchMembers(pConfig, pArchive, offsets);
+    }
+
+    while (pArchive.numOfVisitedObjects() < end) {
+      Input* object = objects[pArchive.numOfVisitedObjects()];
+      pArchive.setNumOfVisitedObjects(pArchive.numOfVisitedObjects() + 1);
 
-      // check if we should include this defined symbol
-      Archive::Symbol::Status status =
-          shouldIncludeSymbol(pArchive.getSymbolName(idx));
-      if (Archive::Symbol::Unknown != status)
-        pArchive.setSymbolStatus(idx, status);
+      LDContext::sym_iterator sym, symEnd = object->context()->symTabEnd();
+      for (sym = object->context()->symTabBegin(); sym != symEnd; ++sym) {
+        const Archive::SymbolIndices* indices =
+            findUndefSymbols(pArchive, **sym);
+        if (indices == NULL)
+          continue;
 
-      if (Archive::Symbol::Include == status) {
-        // include the object member from the given offset
-        includeMember(pConfig, pArchive, pArchive.getObjFileOffset(idx));
-        willSymResolved = true;
-      }  // end of if
-    }    // end of for
-  } while (willSymResolved);
+        Archive::SymbolIndices::const_iterator idx, idxEnd = indices->end();
+        for (idx = indices->begin(); idx != idxEnd; ++idx)
+          includeSymbol(pConfig, pArchive, *idx);
+      }
+    }
+  }
 
   return true;
 }
 
+/// includeSymbol - include the member that defines the symbol at pSymIdx of
+/// the symtab if it is needed
+/// @return true if a new member is included
+bool GNUArchiveReader::includeSymbol(const LinkerConfig& pConfig,
+                                     Archive& pArchive,
+                                     size_t pSymIdx) {
+  // bypass if we already decided to include this symbol or not
+  if (Archive::Symbol::Unknown != pArchive.getSymbolStatus(pSymIdx))
+    return false;
+
+  // bypass if another symbol with the same object file offset is included
+  if (pArchive.hasObjectMember(pArchive.getObjFileOffset(pSymIdx))) {
+    pArchive.setSymbolStatus(pSymIdx, Archive::Symbol::Include);
+    return false;
+  }
+
+  // check if we should include this defined symbol
+  Archive::Symbol::Status status =
+      shouldIncludeSymbol(pArchive.getSymbolName(pSymIdx));
+  if (Archive::Symbol::Unknown != status)
+    pArchive.setSymbolStatus(pSymIdx, status);
+
+  if (Archive::Symbol::Include != status)
+    return false;
+
+  // include the object member from the given offset
+  includeMember(pConfig, pArchive, pArchive.getObjFileOffset(pSymIdx));
+  return true;
+}
+
+/// findUndefSymbols - the symtab entries of the archive named after pSymbol
+/// if it is undefined, or NULL
+const Archive::SymbolIndices* GNUArchiveReader::findUndefSymbols(
+    Archive& pArchive,
+    const LDSymbol& pSymbol) const {
+  const ResolveInfo* info = pSymbol.resolveInfo();
+  if (info == NULL || !info->isUndef())
+    return NULL;
+  return pArchive.findSymbols(llvm::StringRef(info->name(), info->nameSize()));
+}
+
+/// collectMember - append the offset of the member defining the symbol at
+/// pSymIdx of the symtab to pOffsets if includeSymbol is likely to include it
+void GNUArchiveReader::collectMember(Archive& pArchive,
+                                     size_t pSymIdx,
+                                     std::vector<uint32_t>& pOffsets) const {
+  if (Archive::Symbol::Unknown != pArchive.getSymbolStatus(pSymIdx))
+    return;
+
+  uint32_t offset = pArchive.getObjFileOffset(pSymIdx);
+  if (pArchive.hasObjectMember(offset))
+    return;
+
+  const ResolveInfo* info =
+      m_Module.getNamePool().findInfo(pArchive.getSymbolName(pSymIdx));
+  if (info == NULL || !info->isUndef() || info->isWeak())
+    return;
+  pOffsets.push_back(offset);
+}
+
+/// prefetchMembers - decode the tables of the members at pOffsets in parallel
+void GNUArchiveReader::prefetchMembers(const LinkerConfig& pConfig,
+                                       Archive& pArchive,
+                                       std::vector<uint32_t>& pOffsets) {
+  if (pOffsets.empty())
+    return;
+
+  std::sort(pOffsets.begin(), pOffsets.end());
+  pOffsets.erase(std::unique(pOffsets.begin(), pOffsets.end()),
+                 pOffsets.end());
+
+  MemoryArea* area = pArchive.getARFile().memArea();
+  ELFObjectReader& reader = m_ELFObjectReader;
+  parallel::forEach(pConfig.options().numThreads(),
+                    pOffsets.begin(),
+                    pOffsets.end(),
+                    [area, &reader](uint32_t pOffset) {
+                      reader.prefetch(*area,
+                                      pOffset + sizeof(Archive::MemberHeader));
+                    });
+}
+
 /// readMemberHeader - read the header of a member in a archive file and then
 /// return the corresponding archive member (it may be an input object or
 /// another archive)
@@ -20,11 +20,15 @@
 #include "mcld/LinkerScript.h"
 #include "mcld/Module.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/Parallel.h"
 #include "mcld/Target/TargetLDBackend.h"
 
 #include <llvm/Support/Casting.h>
 
-#include <queue>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #if !defined(MCLD_ON_WIN32)
 #include <fnmatch.h>
 #define fnmatch0(pattern, string) (fnmatch(pattern, string, 0) == 0)
@@ -107,8 +111,8 @@ GarbageCollection::~GarbageCollection() {
 bool GarbageCollection::run() {
   // 1. traverse all the relocations to set up the reached sections of each
   // section
-  setUpReachedSections();
   m_Backend.setUpReachedSectionsForGC(m_Module, m_SectionReachedListMap);
+  setUpReachedSections();
 
   // 2. get all sections defined the entry point
   SectionVecTy entry;
@@ -123,59 +127,132 @@ bool GarbageCollection::run() {
 }
 
 void GarbageCollection::setUpReachedSections() {
-  // traverse all the input relocations to setup the reached sections
-  Module::obj_iterator input, inEnd = m_Module.obj_end();
-  for (input = m_Module.obj_begin(); input != inEnd; ++input) {
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the discarded relocation section
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      LDSection* reloc_sect = *rs;
-      LDSection* apply_sect = reloc_sect->getLink();
-      if ((LDFileFormat::Ignore == reloc_sect->kind()) ||
-          (!reloc_sect->hasRelocData()))
+  // number the input sections
+  const Module::ObjectList& objects = m_Module.getObjectList();
+  std::vector<uint32_t> first_ordinal(objects.size() + 1);
+  for (size_t i = 0; i < objects.size(); ++i) {
+    first_ordinal[i] = m_Sections.size();
+    LDContext::sect_iterator sect, sectEnd = objects[i]->context()->sectEnd();
+    for (sect = objects[i]->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if (*sect == NULL)
         continue;
+      m_Ordinals[*sect] = m_Sections.size();
+      m_Sections.push_back(*sect);
+    }
+  }
+  first_ordinal[objects.size()] = m_Sections.size();
+
+  // collect the references made by the relocations of each input
+  unsigned threads = m_Config.options().numThreads();
+  std::vector<ReferenceList> references(objects.size());
+  parallel::forEachN(threads, 0, objects.size(),
+                     [this, &objects, &references](size_t pIdx) {
+    collectReferences(*objects[pIdx], references[pIdx]);
+  });
+
+  // count the references from each section. A relocation section applies to
+  // a section of the same input, so the references of an input start from
+  // its own sections.
+  m_EdgeBegin.assign(m_Sections.size() + 1, 0);
+  for (size_t i = 0; i < references.size(); ++i) {
+    ReferenceList::const_iterator ref, refEnd = references[i].end();
+    for (ref = references[i].begin(); ref != refEnd; ++ref)
+      ++m_EdgeBegin[ref->first + 1];
+  }
+  SectionReachedListMap::const_iterator list,
+      listEnd = m_SectionReachedListMap.end();
+  for (list = m_SectionReachedListMap.begin(); list != listEnd; ++list) {
+    llvm::DenseMap<const LDSection*, uint32_t>::const_iterator from =
+        m_Ordinals.find(list->first);
+    if (from != m_Ordinals.end())
+      m_EdgeBegin[from->second + 1] += list->second.size();
+  }
+  for (size_t i = 1; i < m_EdgeBegin.size(); ++i)
+    m_EdgeBegin[i] += m_EdgeBegin[i - 1];
+
+  // fill the edges, the ones of different inputs at the same time
+  m_Edges.resize(m_EdgeBegin.back());
+  std::vector<size_t> next(m_EdgeBegin.begin(), m_EdgeBegin.end() - 1);
+  parallel::forEachN(threads, 0, objects.size(),
+                     [this, &references, &next](size_t pIdx) {
+    ReferenceList::const_iterator ref, refEnd = references[pIdx].end();
+    for (ref = references[pIdx].begin(); ref != refEnd; ++ref)
+      m_Edges[next[ref->first]++] = ref->second;
+  });
+  for (list = m_SectionReachedListMap.begin(); list != listEnd; ++list) {
+    llvm::DenseMap<const LDSection*, uint32_t>::const_iterator from =
+        m_Ordinals.find(list->first);
+    if (from == m_Ordinals.end())
+      continue;
+    SectionListTy::const_iterator to, toEnd = list->second.end();
+    for (to = list->second.begin(); to != toEnd; ++to) {
+      llvm::DenseMap<const LDSection*, uint32_t>::const_iterator target =
+          m_Ordinals.find(*to);
+      // a reference to a section out of the inputs reaches nothing
+      m_Edges[next[from->second]++] =
+          (target == m_Ordinals.end()) ? from->second : target->second;
+    }
+  }
+}
 
-      // bypass the apply target sections which are not handled by gc
-      if (!mayProcessGC(*apply_sect))
-        continue;
+void GarbageCollection::collectReferences(Input& pInput,
+                                          ReferenceList& pReferences) {
+  // traverse all the input relocations to setup the reached sections
+  LDContext::sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    // bypass the discarded relocation section
+    // 1. its section kind is changed to Ignore. (The target section is a
+    // discarded group section.)
+    // 2. it has no reloc data. (All symbols in the input relocs are in the
+    // discarded group sections)
+    const LDSection* reloc_sect = *rs;
+    const LDSection* apply_sect = reloc_sect->getLink();
+    if ((LDFileFormat::Ignore == reloc_sect->kind()) ||
+        (!reloc_sect->hasRelocData()))
+      continue;
 
-      bool add_first = false;
-      SectionListTy* reached_sects = NULL;
-      RelocData::iterator reloc_it, rEnd = reloc_sect->getRelocData()->end();
-      for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
-           ++reloc_it) {
-        Relocation* reloc = llvm::cast<Relocation>(reloc_it);
-        ResolveInfo* sym = reloc->symInfo();
-        // only the target symbols defined in the input fragments can make the
-        // reference
-        if (sym == NULL)
-          continue;
-        if (!sym->isDefine() || !sym->outSymbol()->hasFragRef())
-          continue;
+    // bypass the apply target sections which are not handled by gc
+    if (!mayProcessGC(*apply_sect))
+      continue;
 
-        // only the target symbols defined in the concerned sections can make
-        // the reference
-        const LDSection* target_sect =
-            &sym->outSymbol()->fragRef()->frag()->getParent()->getSection();
-        if (!mayProcessGC(*target_sect))
-          continue;
+    // create the relocations of the section from its pending records
+    if (!(*rs)->getRelocData()->getTable().materialize()) {
+      fatal(diag::fatal_cannot_read_input) << pInput.path();
+      continue;
+    }
 
-        // setup the reached list, if we first add the element to reached list
-        // of this section, create an entry in ReachedSections map
-        if (!add_first) {
-          reached_sects = &m_SectionReachedListMap.getReachedList(*apply_sect);
-          add_first = true;
-        }
-        reached_sects->insert(target_sect);
-      }
-      reached_sects = NULL;
-      add_first = false;
+    uint32_t from = m_Ordinals.find(apply_sect)->second;
+    RelocData::const_iterator reloc_it,
+        rEnd = reloc_sect->getRelocData()->end();
+    for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
+         ++reloc_it) {
+      const Relocation* reloc = llvm::cast<Relocation>(reloc_it);
+      const ResolveInfo* sym = reloc->symInfo();
+      // only the target symbols defined in the input fragments can make the
+      // reference
+      if (sym == NULL)
+        continue;
+      if (!sym->isDefine() || !sym->outSymbol()->hasFragRef())
+        continue;
+
+      // only the target symbols defined in the concerned sections can make
+      // the reference
+      const LDSection* target_sect =
+          &sym->outSymbol()->fragRef()->frag()->getParent()->getSection();
+      if (!mayProcessGC(*target_sect))
+        continue;
+
+      llvm::DenseMap<const LDSection*, uint32_t>::const_iterator to =
+          m_Ordinals.find(target_sect);
+      if (to != m_Ordinals.end())
+        pReferences.push_back(Reference(from, to->second));
     }
   }
+
+  // a section usually refers to the same section many times
+  std::sort(pReferences.begin(), pReferences.end());
+  pReferences.erase(std::unique(pReferences.begin(), pReferences.end()),
+                    pReferences.end());
 }
 
 void GarbageCollection::getEntrySections(SectionVecTy& pEntry) {
@@ -285,41 +362,74 @@ void GarbageCollection::getEntrySections(SectionVecTy& pEntry) {
 }
 
 void GarbageCollection::findReferencedSections(SectionVecTy& pEntry) {
-  // list of sections waiting to be processed
-  typedef std::queue<const LDSection*> WorkListTy;
-  WorkListTy work_list;
-  // start from each entry, resolve the transitive closure
+  std::vector<std::atomic<uint8_t> > referenced(m_Sections.size());
+  for (size_t i = 0; i < m_Sections.size(); ++i)
+    referenced[i].store(0, std::memory_order_relaxed);
+
+  // sections waiting to be processed. Every worker keeps its own stack and
+  // shares the sections with the others through the global one when it has
+  // plenty of them, or takes some from there when it runs out.
+  std::vector<uint32_t> work_list;
+  std::mutex work_list_lock;
+  // the number of sections marked but not processed yet
+  std::atomic<size_t> pending(0);
+
   SectionVecTy::iterator entry_it, entry_end = pEntry.end();
   for (entry_it = pEntry.begin(); entry_it != entry_end; ++entry_it) {
-    // add entry point to work list
-    work_list.push(*entry_it);
-
-    // add section from the work_list to the referencedSections until every
-    // reached sections are added
-    while (!work_list.empty()) {
-      const LDSection* sect = work_list.front();
-      work_list.pop();
-      // add section to the ReferencedSections, if the section has been put into
-      // referencedSections, skip this section
-      if (!m_ReferencedSections.insert(sect).second)
-        continue;
+    llvm::DenseMap<const LDSection*, uint32_t>::const_iterator entry =
+        m_Ordinals.find(*entry_it);
+    if (entry == m_Ordinals.end() || referenced[entry->second].exchange(1))
+      continue;
+    work_list.push_back(entry->second);
+    ++pending;
+  }
 
-      // get the section reached list, if the section do not has one, which
-      // means no referenced between it and other sections, then skip it
-      SectionListTy* reach_list =
-          m_SectionReachedListMap.findReachedList(*sect);
-      if (reach_list == NULL)
-        continue;
+  const size_t share_size = 256;
+  unsigned threads = m_Config.options().numThreads();
+  parallel::forEachN(threads, 0, threads, [&](size_t pWorker) {
+    std::vector<uint32_t> stack;
+    while (true) {
+      if (stack.empty()) {
+        {
+          std::lock_guard<std::mutex> guard(work_list_lock);
+          size_t num = std::min(work_list.size(), share_size);
+          stack.assign(work_list.end() - num, work_list.end());
+          work_list.resize(work_list.size() - num);
+        }
+        if (stack.empty()) {
+          if (pending.load() == 0)
+            return;
+          std::this_thread::yield();
+          continue;
+        }
+      }
 
-      // put the reached sections to work list, skip the one already be in
-      // referencedSections
-      SectionListTy::iterator it, end = reach_list->end();
-      for (it = reach_list->begin(); it != end; ++it) {
-        if (m_ReferencedSections.find(*it) == m_ReferencedSections.end())
-          work_list.push(*it);
+      uint32_t sect = stack.back();
+      stack.pop_back();
+      for (size_t i = m_EdgeBegin[sect]; i != m_EdgeBegin[sect + 1]; ++i) {
+        uint32_t target = m_Edges[i];
+        if (referenced[target].load(std::memory_order_relaxed) ||
+            referenced[target].exchange(1))
+          continue;
+        ++pending;
+        stack.push_back(target);
+      }
+      --pending;
+
+      // give half of a long stack to the idle workers
+      if (threads > 1 && stack.size() > 2 * share_size) {
+        std::lock_guard<std::mutex> guard(work_list_lock);
+        if (work_list.empty()) {
+          work_list.assign(stack.begin(), stack.begin() + share_size);
+          stack.erase(stack.begin(), stack.begin() + share_size);
+        }
       }
     }
-  }
+  });
+
+  m_Referenced.resize(m_Sections.size());
+  for (size_t i = 0; i < m_Sections.size(); ++i)
+    m_Referenced[i] = referenced[i].load(std::memory_order_relaxed);
 }
 
 void GarbageCollection::stripSections() {
@@ -333,7 +443,7 @@ void GarbageCollection::stripSections() {
       if (!mayProcessGC(*section))
         continue;
 
-      if (m_ReferencedSections.find(section) == m_ReferencedSections.end()) {
+      if (!m_Referenced[m_Ordinals[section]]) {
         section->setKind(LDFileFormat::Ignore);
         debug(diag::debug_print_gc_sections) << section->name()
                                              << (*obj)->name();
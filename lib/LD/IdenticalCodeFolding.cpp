@@ -10,6 +10,7 @@
 
 #include "mcld/GeneralOptions.h"
 #include "mcld/Module.h"
+#include "mcld/ADT/StringHash.h"
 #include "mcld/Fragment/RegionFragment.h"
 #include "mcld/LD/LDContext.h"
 #include "mcld/LD/LDSection.h"
@@ -20,21 +21,77 @@
 #include "mcld/LinkerConfig.h"
 #include "mcld/MC/Input.h"
 #include "mcld/Support/Demangle.h"
+#include "mcld/Support/LinkerStats.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/Parallel.h"
 #include "mcld/Target/GNULDBackend.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/Format.h>
 
 #include <cassert>
+#include <chrono>
+#include <cstring>
 #include <map>
 #include <set>
-
-#include <zlib.h>
+#include <unordered_map>
 
 namespace mcld {
 
+namespace {
+
+/// NumOfShards - the candidates are grouped by this many workers, each of
+/// which owns the candidates whose hash values have the same top bits.
+const unsigned NumOfShards = 16;
+
+typedef std::chrono::steady_clock Clock;
+
+/// combine - mix pValue into the hash value pSeed
+uint64_t combine(uint64_t pSeed, uint64_t pValue) {
+  uint64_t hash = (pSeed ^ pValue) * 0x9e3779b97f4a7c15ULL;
+  return hash ^ (hash >> 29);
+}
+
+/// appendValue - append the bytes of pValue to pContent
+template <typename ValueTy>
+void appendValue(std::string& pContent, ValueTy pValue) {
+  char buf[sizeof(ValueTy)];
+  std::memcpy(buf, &pValue, sizeof(ValueTy));
+  pContent.append(buf, sizeof(ValueTy));
+}
+
+/// groupByHash - set pLeaders[i] to the first j with the same hash value for
+/// which pEqual(j, i) holds.
+template <typename EqualTy>
+void groupByHash(unsigned pNumThreads,
+                 const std::vector<uint64_t>& pHashes,
+                 const EqualTy& pEqual,
+                 std::vector<size_t>& pLeaders) {
+  pLeaders.resize(pHashes.size());
+  parallel::forEachN(pNumThreads, 0, NumOfShards, [&](size_t pShard) {
+    typedef std::unordered_multimap<uint64_t, size_t> LeaderMap;
+    LeaderMap leaders;
+    for (size_t i = 0; i < pHashes.size(); ++i) {
+      if ((pHashes[i] >> 60) != pShard)
+        continue;
+      size_t leader = i;
+      std::pair<LeaderMap::iterator, LeaderMap::iterator> range =
+          leaders.equal_range(pHashes[i]);
+      for (LeaderMap::iterator it = range.first; it != range.second; ++it) {
+        if (pEqual(it->second, i)) {
+          leader = it->second;
+          break;
+        }
+      }
+      if (leader == i)
+        leaders.insert(std::make_pair(pHashes[i], i));
+      pLeaders[i] = leader;
+    }
+  });
+}
+
+}  // anonymous namespace
+
 static bool isSymCtorOrDtor(const ResolveInfo& pSym) {
   // We can always fold ctors and dtors since accessing function pointer in C++
   // is forbidden.
@@ -52,27 +109,40 @@ IdenticalCodeFolding::IdenticalCodeFolding(const LinkerConfig& pConfig,
 }
 
 void IdenticalCodeFolding::foldIdenticalCode() {
+  unsigned threads = m_Config.options().numThreads();
+
   // 1. Find folding candidates.
+  Clock::time_point start = Clock::now();
   FoldingCandidates candidate_list;
   findCandidates(candidate_list);
+  double find_ms = LinkerStats::elapsed(start);
 
   // 2. Initialize constant section content
-  for (size_t i = 0; i < candidate_list.size(); ++i) {
-    candidate_list[i].initConstantContent(m_Backend, m_KeptSections);
-  }
+  start = Clock::now();
+  parallel::forEach(threads, candidate_list.begin(), candidate_list.end(),
+                    [this](FoldingCandidate& pCandidate) {
+    pCandidate.initConstantContent(m_Backend, m_KeptSections);
+  });
+  double content_ms = LinkerStats::elapsed(start);
 
-  // 3. Find identical code until convergence
-  bool converged = false;
-  size_t iterations = 0;
-  while (!converged && (iterations < m_Config.options().getICFIterations())) {
-    converged = matchCandidates(candidate_list);
+  // 3. Split the classes of identical code until convergence
+  start = Clock::now();
+  ClassList classes;
+  initClasses(candidate_list, classes);
+  size_t iterations = 1;
+  while (!refineClasses(candidate_list, classes))
     ++iterations;
-  }
+
+  for (size_t i = 0; i < candidate_list.size(); ++i)
+    m_KeptSections[candidate_list[i].sect].second = classes[i];
+  double refine_ms = LinkerStats::elapsed(start);
+
   if (m_Config.options().printICFSections()) {
     debug(diag::debug_icf_iterations) << iterations;
   }
 
   // 4. Fold the identical code
+  start = Clock::now();
   typedef std::set<Input*> FoldedObjects;
   FoldedObjects folded_objs;
   KeptSections::iterator kept, keptEnd = m_KeptSections.end();
@@ -114,6 +184,21 @@ void IdenticalCodeFolding::foldIdenticalCode() {
       }
     }  // for each symbol
   }    // for each folded object
+
+  if (m_Config.options().printICFStats()) {
+    size_t folded = 0;
+    for (size_t i = 0; i < classes.size(); ++i) {
+      if (classes[i] != i)
+        ++folded;
+    }
+    debug(diag::debug_icf_stats) << folded << candidate_list.size()
+                                 << iterations;
+    debug(diag::debug_icf_time)
+        << LinkerStats::formatTime(find_ms)
+        << LinkerStats::formatTime(content_ms)
+        << LinkerStats::formatTime(refine_ms)
+        << LinkerStats::formatTime(LinkerStats::elapsed(start));
+  }
 }
 
 void IdenticalCodeFolding::findCandidates(FoldingCandidates& pCandidateList) {
@@ -177,36 +262,58 @@ void IdenticalCodeFolding::findCandidates(FoldingCandidates& pCandidateList) {
   }  // for each obj
 }
 
-bool IdenticalCodeFolding::matchCandidates(FoldingCandidates& pCandidateList) {
-  typedef std::multimap<uint32_t, size_t> ChecksumMap;
-  ChecksumMap checksum_map;
-  std::vector<std::string> contents(pCandidateList.size());
-  bool converged = true;
-
-  for (size_t index = 0; index < pCandidateList.size(); ++index) {
-    contents[index] = pCandidateList[index].getContentWithVariables(
-        m_Backend, m_KeptSections);
-    uint32_t checksum = ::crc32(0xFFFFFFFF,
-                                (const uint8_t*)contents[index].c_str(),
-                                contents[index].length());
-
-    size_t count = checksum_map.count(checksum);
-    if (count == 0) {
-      checksum_map.insert(std::make_pair(checksum, index));
-    } else {
-      std::pair<ChecksumMap::iterator, ChecksumMap::iterator> ret =
-          checksum_map.equal_range(checksum);
-      for (ChecksumMap::iterator it = ret.first; it != ret.second; ++it) {
-        size_t kept_index = (*it).second;
-        if (contents[index].compare(contents[kept_index]) == 0) {
-          m_KeptSections[pCandidateList[index].sect].second = kept_index;
-          converged = false;
-          break;
-        }
-      }
-    }
+void IdenticalCodeFolding::initClasses(
+    const FoldingCandidates& pCandidateList,
+    ClassList& pClasses) {
+  std::vector<uint64_t> hashes(pCandidateList.size());
+  for (size_t i = 0; i < pCandidateList.size(); ++i) {
+    hashes[i] = combine(pCandidateList[i].content_hash,
+                        pCandidateList[i].variable_targets.size());
   }
 
+  groupByHash(m_Config.options().numThreads(), hashes,
+              [&pCandidateList](size_t pX, size_t pY) {
+    const FoldingCandidate& x = pCandidateList[pX];
+    const FoldingCandidate& y = pCandidateList[pY];
+    return (x.variable_targets.size() == y.variable_targets.size()) &&
+           (x.content == y.content);
+  }, pClasses);
+}
+
+bool IdenticalCodeFolding::refineClasses(
+    const FoldingCandidates& pCandidateList,
+    ClassList& pClasses) {
+  unsigned threads = m_Config.options().numThreads();
+
+  // A candidate stays with the others of its class only if their variable
+  // relocations refer to the same classes.
+  std::vector<uint64_t> hashes(pCandidateList.size());
+  parallel::forEachN(threads, 0, pCandidateList.size(),
+                     [&pCandidateList, &pClasses, &hashes](size_t pIdx) {
+    const std::vector<size_t>& targets = pCandidateList[pIdx].variable_targets;
+    uint64_t hash = combine(0, pClasses[pIdx]);
+    for (size_t i = 0; i < targets.size(); ++i)
+      hash = combine(hash, pClasses[targets[i]]);
+    hashes[pIdx] = hash;
+  });
+
+  ClassList classes;
+  groupByHash(threads, hashes,
+              [&pCandidateList, &pClasses](size_t pX, size_t pY) {
+    if (pClasses[pX] != pClasses[pY])
+      return false;
+    const std::vector<size_t>& x = pCandidateList[pX].variable_targets;
+    const std::vector<size_t>& y = pCandidateList[pY].variable_targets;
+    for (size_t i = 0; i < x.size(); ++i) {
+      if (pClasses[x[i]] != pClasses[y[i]])
+        return false;
+    }
+    return true;
+  }, classes);
+
+  // classes are only split, so nothing changes once no class is split
+  bool converged = (classes == pClasses);
+  pClasses.swap(classes);
   return converged;
 }
 
@@ -234,17 +341,10 @@ void IdenticalCodeFolding::FoldingCandidate::initConstantContent(
   if (reloc_sect != NULL && reloc_sect->hasRelocData()) {
     RelocData::iterator rel, relEnd = reloc_sect->getRelocData()->end();
     for (rel = reloc_sect->getRelocData()->begin(); rel != relEnd; ++rel) {
-      llvm::format_object<Relocation::Type,
-                          Relocation::Address,
-                          Relocation::Address,
-                          Relocation::Address> rel_info("%x%llx%llx%llx",
-                                                        rel->type(),
-                                                        rel->symValue(),
-                                                        rel->addend(),
-                                                        rel->place());
-      char rel_str[48];
-      rel_info.print(rel_str, sizeof(rel_str));
-      content.append(rel_str);
+      appendValue(content, rel->type());
+      appendValue(content, rel->symValue());
+      appendValue(content, rel->addend());
+      appendValue(content, rel->place());
 
       // Handle the recursive call.
       LDSymbol* sym = rel->symInfo()->outSymbol();
@@ -255,12 +355,15 @@ void IdenticalCodeFolding::FoldingCandidate::initConstantContent(
         }
       }
 
-      if (!pBackend.isSymbolPreemptible(*rel->symInfo()) && sym->hasFragRef() &&
-          (pKeptSections.find(
-               &sym->fragRef()->frag()->getParent()->getSection()) !=
-           pKeptSections.end())) {
+      KeptSections::const_iterator kept = pKeptSections.end();
+      if (sym->hasFragRef())
+        kept = pKeptSections.find(
+            &sym->fragRef()->frag()->getParent()->getSection());
+
+      if (!pBackend.isSymbolPreemptible(*rel->symInfo()) &&
+          kept != pKeptSections.end()) {
         // Mark this reloc as a variable.
-        variable_relocs.push_back(rel);
+        variable_targets.push_back((*kept).second.second);
       } else {
         // TODO: Support inlining merge sections if possible (target-dependent).
         if ((sym->binding() == ResolveInfo::Local) ||
@@ -274,26 +377,8 @@ void IdenticalCodeFolding::FoldingCandidate::initConstantContent(
       }
     }
   }
-}
-
-std::string IdenticalCodeFolding::FoldingCandidate::getContentWithVariables(
-    const TargetLDBackend& pBackend,
-    const IdenticalCodeFolding::KeptSections& pKeptSections) {
-  std::string result(content);
-  // Compute the variable content from relocs.
-  std::vector<Relocation*>::const_iterator rel, relEnd = variable_relocs.end();
-  for (rel = variable_relocs.begin(); rel != relEnd; ++rel) {
-    LDSymbol* sym = (*rel)->symInfo()->outSymbol();
-    LDSection* def = &sym->fragRef()->frag()->getParent()->getSection();
-    // Use the kept section index.
-    KeptSections::const_iterator it = pKeptSections.find(def);
-    llvm::format_object<size_t> kept_info("%x", (*it).second.second);
-    char kept_str[8];
-    kept_info.print(kept_str, sizeof(kept_str));
-    result.append(kept_str);
-  }
 
-  return result;
+  content_hash = hash::StringHash<hash::WY>()(content);
 }
 
 }  // namespace mcld
@@ -21,6 +21,8 @@ LDContext& LDContext::appendSection(LDSection& pSection) {
   if (LDFileFormat::Relocation == pSection.kind())
     m_RelocSections.push_back(&pSection);
   pSection.setIndex(m_SectionTable.size());
+  if (m_SectionIndex.find(pSection.name()) == m_SectionIndex.end())
+    m_SectionIndex[pSection.name()] = m_SectionTable.size();
   m_SectionTable.push_back(&pSection);
   return *this;
 }
@@ -38,24 +40,27 @@ const LDSection* LDContext::getSection(unsigned int pIdx) const {
 }
 
 LDSection* LDContext::getSection(const std::string& pName) {
-  sect_iterator sect_iter, sect_end = sectEnd();
-  for (sect_iter = sectBegin(); sect_iter != sect_end; ++sect_iter) {
-    if (*sect_iter != NULL && (*sect_iter)->name() == pName)
-      return *sect_iter;
-  }
-  return NULL;
+  llvm::StringMap<size_t>::const_iterator entry = m_SectionIndex.find(pName);
+  if (entry == m_SectionIndex.end())
+    return NULL;
+  return m_SectionTable[entry->getValue()];
 }
 
 const LDSection* LDContext::getSection(const std::string& pName) const {
-  const_sect_iterator sect_iter, sect_end = sectEnd();
-  for (sect_iter = sectBegin(); sect_iter != sect_end; ++sect_iter) {
-    if (*sect_iter != NULL && (*sect_iter)->name() == pName)
-      return *sect_iter;
-  }
-  return NULL;
+  llvm::StringMap<size_t>::const_iterator entry = m_SectionIndex.find(pName);
+  if (entry == m_SectionIndex.end())
+    return NULL;
+  return m_SectionTable[entry->getValue()];
 }
 
 size_t LDContext::getSectionIdx(const std::string& pName) const {
+  llvm::StringMap<size_t>::const_iterator entry = m_SectionIndex.find(pName);
+  if (entry == m_SectionIndex.end())
+    return 0;
+  if (entry->getValue() != 0)
+    return entry->getValue();
+
+  // the null section has the same name; look for another one
   size_t result = 1;
   size_t size = m_SectionTable.size();
   for (; result != size; ++result)
@@ -30,6 +30,7 @@ LDSection::LDSection()
       m_Offset(~uint64_t(0)),
       m_Addr(0x0),
       m_Align(0),
+      m_EntSize(0),
       m_Info(0),
       m_pLink(NULL),
       m_Index(0) {
@@ -50,6 +51,7 @@ LDSection::LDSection(const std::string& pName,
       m_Offset(~uint64_t(0)),
       m_Addr(pAddr),
       m_Align(0),
+      m_EntSize(0),
       m_Info(0),
       m_pLink(NULL),
       m_Index(0) {
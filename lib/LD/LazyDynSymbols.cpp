@@ -0,0 +1,441 @@
+//===- LazyDynSymbols.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/LazyDynSymbols.h"
+
+#include "mcld/ADT/SizeTraits.h"
+#include "mcld/IRBuilder.h"
+#include "mcld/LD/ELFReaderIf.h"
+#include "mcld/LD/NamePool.h"
+#include "mcld/LD/ResolveInfo.h"
+#include "mcld/MC/Attribute.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Module.h"
+
+#include <llvm/Support/ELF.h>
+#include <llvm/Support/Host.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace mcld {
+
+namespace {
+
+inline uint16_t toHost(uint16_t pValue) {
+  return llvm::sys::IsLittleEndianHost ? pValue : mcld::bswap16(pValue);
+}
+
+inline uint32_t toHost(uint32_t pValue) {
+  return llvm::sys::IsLittleEndianHost ? pValue : mcld::bswap32(pValue);
+}
+
+inline uint64_t toHost(uint64_t pValue) {
+  return llvm::sys::IsLittleEndianHost ? pValue : mcld::bswap64(pValue);
+}
+
+/// gnuHash - the hash function of .gnu.hash
+uint32_t gnuHash(llvm::StringRef pName) {
+  uint32_t h = 5381;
+  for (size_t i = 0; i < pName.size(); ++i)
+    h = (h << 5) + h + static_cast<uint8_t>(pName[i]);
+  return h;
+}
+
+/// sysvHash - the hash function of .hash
+uint32_t sysvHash(llvm::StringRef pName) {
+  uint32_t h = 0;
+  for (size_t i = 0; i < pName.size(); ++i) {
+    h = (h << 4) + static_cast<uint8_t>(pName[i]);
+    uint32_t g = h & 0xf0000000;
+    if (g != 0)
+      h ^= g >> 24;
+    h &= ~g;
+  }
+  return h;
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// LazyDynSymbols::Library
+//===----------------------------------------------------------------------===//
+/** \class LazyDynSymbols::Library
+ *  \brief the symbols and the hash table of a shared library
+ */
+class LazyDynSymbols::Library {
+ public:
+  Library(const ELFReaderIF& pReader,
+          IRBuilder& pBuilder,
+          Input& pInput,
+          bool pIs64,
+          llvm::StringRef pSymTab,
+          llvm::StringRef pStrTab,
+          llvm::StringRef pHash,
+          bool pIsGNUHash)
+      : m_Reader(pReader),
+        m_Builder(pBuilder),
+        m_Input(pInput),
+        m_bIs64(pIs64),
+        m_SymTab(pSymTab),
+        m_StrTab(pStrTab),
+        m_Hash(pHash),
+        m_bIsGNUHash(pIsGNUHash),
+        m_NumSyms(0),
+        m_NumBuckets(0),
+        m_SymOffset(0),
+        m_BloomSize(0),
+        m_BloomShift(0),
+        m_pBloom(NULL),
+        m_pBuckets(NULL),
+        m_pChains(NULL),
+        m_NumChains(0),
+        m_bHasObjects(false) {}
+
+  /// init - check the hash table and read the symbols needed at once
+  bool init() {
+    if (m_bIs64)
+      return doInit<llvm::ELF::Elf64_Sym, uint64_t>();
+    return doInit<llvm::ELF::Elf32_Sym, uint32_t>();
+  }
+
+  const Input& input() const { return m_Input; }
+
+  /// resolve - read the definitions of pName
+  bool resolve(llvm::StringRef pName) {
+    if (m_bIs64)
+      return doResolve<llvm::ELF::Elf64_Sym, uint64_t>(pName);
+    return doResolve<llvm::ELF::Elf32_Sym, uint32_t>(pName);
+  }
+
+ private:
+  template <typename SymTy>
+  const SymTy& symbol(uint32_t pIdx) const {
+    return reinterpret_cast<const SymTy*>(m_SymTab.data())[pIdx];
+  }
+
+  template <typename SymTy>
+  llvm::StringRef name(const SymTy& pSym) const {
+    uint32_t st_name = toHost(pSym.st_name);
+    if (st_name >= m_StrTab.size())
+      return llvm::StringRef();
+    return llvm::StringRef(m_StrTab.data() + st_name);
+  }
+
+  template <typename SymTy>
+  static bool isDefined(const SymTy& pSym) {
+    return toHost(pSym.st_shndx) != llvm::ELF::SHN_UNDEF;
+  }
+
+  /// isObject - whether pSym may be an alias of a weak object, see
+  /// ELFReader::readSymbols
+  template <typename SymTy>
+  static bool isObject(const SymTy& pSym) {
+    uint8_t binding = pSym.st_info >> 4;
+    return isDefined(pSym) && (pSym.st_info & 0xf) == llvm::ELF::STT_OBJECT &&
+           (binding == llvm::ELF::STB_GLOBAL || binding == llvm::ELF::STB_WEAK);
+  }
+
+  /// isExported - whether IRBuilder adds pSym to the name pool
+  template <typename SymTy>
+  static bool isExported(const SymTy& pSym) {
+    uint8_t vis = pSym.st_other & 0x3;
+    return (pSym.st_info >> 4) != llvm::ELF::STB_LOCAL &&
+           (pSym.st_info & 0xf) != llvm::ELF::STT_SECTION &&
+           vis != llvm::ELF::STV_INTERNAL && vis != llvm::ELF::STV_HIDDEN;
+  }
+
+  template <typename SymTy, typename BloomTy>
+  bool doInit();
+
+  template <typename SymTy, typename BloomTy>
+  bool doResolve(llvm::StringRef pName);
+
+  /// lookup - append the definitions of pName which are not read yet
+  template <typename SymTy, typename BloomTy>
+  void lookup(llvm::StringRef pName, std::vector<uint32_t>& pIndices) const;
+
+  /// read - read the symbols pIndices and the aliases of the objects among
+  /// them
+  template <typename SymTy>
+  void read(std::vector<uint32_t>& pIndices);
+
+ private:
+  const ELFReaderIF& m_Reader;
+  IRBuilder& m_Builder;
+  Input& m_Input;
+  bool m_bIs64;
+  llvm::StringRef m_SymTab;
+  llvm::StringRef m_StrTab;
+  llvm::StringRef m_Hash;
+  bool m_bIsGNUHash;
+  uint32_t m_NumSyms;
+
+  // the hash table
+  uint32_t m_NumBuckets;
+  uint32_t m_SymOffset;   // .gnu.hash only
+  uint32_t m_BloomSize;   // .gnu.hash only
+  uint32_t m_BloomShift;  // .gnu.hash only
+  const char* m_pBloom;
+  const uint32_t* m_pBuckets;
+  const uint32_t* m_pChains;
+  uint32_t m_NumChains;
+
+  /// m_Read - whether a symbol is read
+  std::vector<bool> m_Read;
+
+  /// m_Objects - the values and indices of the objects, sorted by value
+  std::vector<std::pair<uint64_t, uint32_t> > m_Objects;
+  bool m_bHasObjects;
+};
+
+template <typename SymTy, typename BloomTy>
+bool LazyDynSymbols::Library::doInit() {
+  m_NumSyms = m_SymTab.size() / sizeof(SymTy);
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(m_Hash.data());
+  size_t num_words = m_Hash.size() / sizeof(uint32_t);
+  if (m_bIsGNUHash) {
+    if (num_words < 4)
+      return false;
+    m_NumBuckets = toHost(words[0]);
+    m_SymOffset = toHost(words[1]);
+    m_BloomSize = toHost(words[2]);
+    m_BloomShift = toHost(words[3]);
+    uint64_t header = 16 + uint64_t(m_BloomSize) * sizeof(BloomTy) +
+                      uint64_t(m_NumBuckets) * sizeof(uint32_t);
+    if (m_NumBuckets == 0 || m_BloomSize == 0 || header > m_Hash.size() ||
+        m_SymOffset > m_NumSyms)
+      return false;
+    m_pBloom = m_Hash.data() + 16;
+    m_pBuckets = reinterpret_cast<const uint32_t*>(
+        m_pBloom + m_BloomSize * sizeof(BloomTy));
+    m_pChains = m_pBuckets + m_NumBuckets;
+    m_NumChains = (m_Hash.size() - header) / sizeof(uint32_t);
+  } else {
+    if (num_words < 2)
+      return false;
+    m_NumBuckets = toHost(words[0]);
+    m_NumChains = toHost(words[1]);
+    if (m_NumBuckets == 0 || 2 + uint64_t(m_NumBuckets) + m_NumChains >
+                                 num_words)
+      return false;
+    m_pBuckets = words + 2;
+    m_pChains = m_pBuckets + m_NumBuckets;
+  }
+
+  m_Read.assign(m_NumSyms, false);
+  if (m_NumSyms == 0)
+    return true;
+  m_Read[0] = true;
+
+  // the undefined symbols are references to other modules and are read at
+  // once, like the definitions of the symbols the pool is waiting for.
+  std::vector<uint32_t> indices;
+  for (uint32_t idx = 1; idx < m_NumSyms; ++idx) {
+    if (!isDefined(symbol<SymTy>(idx)))
+      indices.push_back(idx);
+  }
+
+  NamePool& pool = m_Builder.getModule().getNamePool();
+  NamePool::syminfo_iterator info, infoEnd = pool.syminfo_end();
+  for (info = pool.syminfo_begin(); info != infoEnd; ++info) {
+    if (info->isUndef() || info->isCommon())
+      lookup<SymTy, BloomTy>(
+          llvm::StringRef(info->name(), info->nameSize()), indices);
+  }
+  read<SymTy>(indices);
+
+  // A shared library is needed if it brings a new symbol, see
+  // IRBuilder::AddSymbol. Look for one symbol not in the pool, nor in the
+  // libraries before, whose symbols a full read would have put into the
+  // pool.
+  if (m_Input.attribute()->isAsNeeded() && !m_Input.isNeeded()) {
+    LazyDynSymbols& lazy = m_Builder.getModule().getLazyDynSymbols();
+    for (uint32_t idx = 1; idx < m_NumSyms; ++idx) {
+      const SymTy& sym = symbol<SymTy>(idx);
+      if (m_Read[idx] || !isExported(sym))
+        continue;
+      llvm::StringRef sym_name = name(sym);
+      if (pool.findInfo(sym_name) != NULL)
+        continue;
+      lazy.resolve(sym_name, &m_Input);
+      if (pool.findInfo(sym_name) == NULL) {
+        m_Input.setNeeded();
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename SymTy, typename BloomTy>
+bool LazyDynSymbols::Library::doResolve(llvm::StringRef pName) {
+  std::vector<uint32_t> indices;
+  lookup<SymTy, BloomTy>(pName, indices);
+  if (indices.empty())
+    return false;
+  read<SymTy>(indices);
+  return true;
+}
+
+template <typename SymTy, typename BloomTy>
+void LazyDynSymbols::Library::lookup(llvm::StringRef pName,
+                                     std::vector<uint32_t>& pIndices) const {
+  if (m_bIsGNUHash) {
+    uint32_t hash = gnuHash(pName);
+    const unsigned bits = sizeof(BloomTy) * 8;
+    BloomTy word;
+    memcpy(&word,
+           m_pBloom + ((hash / bits) % m_BloomSize) * sizeof(BloomTy),
+           sizeof(BloomTy));
+    word = toHost(word);
+    BloomTy mask = (BloomTy(1) << (hash % bits)) |
+                   (BloomTy(1) << ((hash >> m_BloomShift) % bits));
+    if ((word & mask) != mask)
+      return;
+
+    uint32_t idx = toHost(m_pBuckets[hash % m_NumBuckets]);
+    if (idx < m_SymOffset)
+      return;
+    for (; idx < m_NumSyms && idx - m_SymOffset < m_NumChains; ++idx) {
+      uint32_t chain = toHost(m_pChains[idx - m_SymOffset]);
+      if ((chain | 1) == (hash | 1) && !m_Read[idx] &&
+          name(symbol<SymTy>(idx)) == pName)
+        pIndices.push_back(idx);
+      if ((chain & 1) != 0)
+        break;
+    }
+    return;
+  }
+
+  // walk at most m_NumChains links in case the chain is broken
+  uint32_t idx = toHost(m_pBuckets[sysvHash(pName) % m_NumBuckets]);
+  for (uint32_t n = 0; idx != 0 && idx < m_NumSyms && idx < m_NumChains &&
+                       n < m_NumChains; ++n) {
+    const SymTy& sym = symbol<SymTy>(idx);
+    if (!m_Read[idx] && isDefined(sym) && name(sym) == pName)
+      pIndices.push_back(idx);
+    idx = toHost(m_pChains[idx]);
+  }
+}
+
+template <typename SymTy>
+void LazyDynSymbols::Library::read(std::vector<uint32_t>& pIndices) {
+  if (pIndices.empty())
+    return;
+
+  // the aliases of an object have the same value
+  size_t num_indices = pIndices.size();
+  for (size_t i = 0; i < num_indices; ++i) {
+    const SymTy& sym = symbol<SymTy>(pIndices[i]);
+    if (!isObject(sym))
+      continue;
+    if (!m_bHasObjects) {
+      for (uint32_t idx = 1; idx < m_NumSyms; ++idx) {
+        const SymTy& obj = symbol<SymTy>(idx);
+        if (isObject(obj))
+          m_Objects.push_back(std::make_pair(uint64_t(toHost(obj.st_value)),
+                                             idx));
+      }
+      std::sort(m_Objects.begin(), m_Objects.end());
+      m_bHasObjects = true;
+    }
+    uint64_t value = toHost(sym.st_value);
+    std::vector<std::pair<uint64_t, uint32_t> >::const_iterator alias =
+        std::lower_bound(m_Objects.begin(), m_Objects.end(),
+                         std::make_pair(value, uint32_t(0)));
+    for (; alias != m_Objects.end() && alias->first == value; ++alias)
+      pIndices.push_back(alias->second);
+  }
+
+  std::sort(pIndices.begin(), pIndices.end());
+  pIndices.erase(std::unique(pIndices.begin(), pIndices.end()),
+                 pIndices.end());
+
+  // ELFReader::readSymbols reads a symbol table whose first entry is null
+  std::vector<SymTy> symtab(1);
+  std::vector<uint32_t>::const_iterator idx, idxEnd = pIndices.end();
+  for (idx = pIndices.begin(); idx != idxEnd; ++idx) {
+    if (m_Read[*idx])
+      continue;
+    m_Read[*idx] = true;
+    symtab.push_back(symbol<SymTy>(*idx));
+  }
+  if (symtab.size() == 1)
+    return;
+
+  m_Reader.readSymbols(
+      m_Input,
+      m_Builder,
+      llvm::StringRef(reinterpret_cast<const char*>(symtab.data()),
+                      symtab.size() * sizeof(SymTy)),
+      m_StrTab.data());
+}
+
+//===----------------------------------------------------------------------===//
+// LazyDynSymbols
+//===----------------------------------------------------------------------===//
+LazyDynSymbols::LazyDynSymbols(NamePool& pPool) : m_Pool(pPool) {
+}
+
+LazyDynSymbols::~LazyDynSymbols() {
+  std::vector<Library*>::iterator lib, libEnd = m_Libraries.end();
+  for (lib = m_Libraries.begin(); lib != libEnd; ++lib)
+    delete *lib;
+}
+
+bool LazyDynSymbols::add(const ELFReaderIF& pReader,
+                         IRBuilder& pBuilder,
+                         Input& pInput,
+                         bool pIs64,
+                         llvm::StringRef pSymTab,
+                         llvm::StringRef pStrTab,
+                         llvm::StringRef pHash,
+                         bool pIsGNUHash) {
+  Library* lib = new Library(pReader, pBuilder, pInput, pIs64, pSymTab,
+                             pStrTab, pHash, pIsGNUHash);
+  if (!lib->init()) {
+    delete lib;
+    return false;
+  }
+  m_Libraries.push_back(lib);
+  return true;
+}
+
+bool LazyDynSymbols::resolve(llvm::StringRef pName, const Input* pInput) {
+  bool result = false;
+  std::vector<Library*>::iterator lib, libEnd = m_Libraries.end();
+  for (lib = m_Libraries.begin(); lib != libEnd; ++lib) {
+    if (&(*lib)->input() == pInput)
+      break;
+    if ((*lib)->resolve(pName))
+      result = true;
+  }
+  return result;
+}
+
+void LazyDynSymbols::resolveAll() {
+  if (m_Libraries.empty())
+    return;
+
+  // Reading a symbol may add its aliases to the pool, so collect the names
+  // first. The symbols already defined by a library are skipped.
+  std::vector<llvm::StringRef> names;
+  NamePool::syminfo_iterator info, infoEnd = m_Pool.syminfo_end();
+  for (info = m_Pool.syminfo_begin(); info != infoEnd; ++info) {
+    if (info->isLocal() || (info->isDyn() && !info->isUndef()))
+      continue;
+    names.push_back(llvm::StringRef(info->name(), info->nameSize()));
+  }
+
+  std::vector<llvm::StringRef>::const_iterator name, nameEnd = names.end();
+  for (name = names.begin(); name != nameEnd; ++name)
+    resolve(*name);
+}
+
+}  // namespace mcld
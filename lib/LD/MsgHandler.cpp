@@ -10,14 +10,24 @@
 
 #include "mcld/LD/DiagnosticEngine.h"
 
+#include <utility>
+
 namespace mcld {
 
 MsgHandler::MsgHandler(DiagnosticEngine& pEngine)
-    : m_Engine(pEngine), m_NumArgs(0) {
+    : m_Engine(pEngine), m_Lock(pEngine.m_Mutex), m_NumArgs(0) {
+}
+
+MsgHandler::MsgHandler(MsgHandler&& pOther)
+    : m_Engine(pOther.m_Engine),
+      m_Lock(std::move(pOther.m_Lock)),
+      m_NumArgs(pOther.m_NumArgs) {
 }
 
 MsgHandler::~MsgHandler() {
-  emit();
+  // a moved-from handler has nothing to emit
+  if (m_Lock.owns_lock())
+    emit();
 }
 
 bool MsgHandler::emit() {
@@ -9,25 +9,25 @@
 #include "mcld/LD/NamePool.h"
 
 #include "mcld/LD/StaticResolver.h"
+#include "mcld/Support/Parallel.h"
 
 #include <llvm/Support/raw_ostream.h>
 
+#include <algorithm>
+
 namespace mcld {
 
 //===----------------------------------------------------------------------===//
 // NamePool
 //===----------------------------------------------------------------------===//
 NamePool::NamePool(NamePool::size_type pSize)
-    : m_pResolver(new StaticResolver()), m_Table(pSize) {
+    : m_pResolver(new StaticResolver()) {
+  reserve(pSize);
 }
 
 NamePool::~NamePool() {
   delete m_pResolver;
-
-  FreeInfoSet::iterator info, iEnd = m_FreeInfoSet.end();
-  for (info = m_FreeInfoSet.begin(); info != iEnd; ++info) {
-    ResolveInfo::Destroy(*info);
-  }
+  // the ResolveInfos are released with the shards and m_FreeInfoAllocator
 }
 
 /// createSymbol - create a symbol
@@ -39,7 +39,7 @@ ResolveInfo* NamePool::createSymbol(const llvm::StringRef& pName,
                                     ResolveInfo::SizeType pSize,
                                     ResolveInfo::Visibility pVisibility) {
   ResolveInfo** result = m_FreeInfoSet.allocate();
-  (*result) = ResolveInfo::Create(pName);
+  (*result) = ResolveInfo::Create(pName, m_FreeInfoAllocator);
   (*result)->setIsSymbol(true);
   (*result)->setSource(pIsDyn);
   (*result)->setType(pType);
@@ -63,17 +63,40 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
                             ResolveInfo::Visibility pVisibility,
                             ResolveInfo* pOldInfo,
                             Resolver::Result& pResult) {
+  insertSymbol(*lookup(pName),
+               pIsDyn,
+               pType,
+               pDesc,
+               pBinding,
+               pSize,
+               pValue,
+               pVisibility,
+               pOldInfo,
+               pResult);
+}
+
+/// insertSymbol - resolve a symbol whose name is already in the pool
+void NamePool::insertSymbol(ResolveInfo& pEntry,
+                            bool pIsDyn,
+                            ResolveInfo::Type pType,
+                            ResolveInfo::Desc pDesc,
+                            ResolveInfo::Binding pBinding,
+                            ResolveInfo::SizeType pSize,
+                            LDSymbol::ValueType pValue,
+                            ResolveInfo::Visibility pVisibility,
+                            ResolveInfo* pOldInfo,
+                            Resolver::Result& pResult) {
   // We should check if there is any symbol with the same name existed.
   // If it already exists, we should use resolver to decide which symbol
   // should be reserved. Otherwise, we insert the symbol and set up its
   // attributes.
-  bool exist = false;
-  ResolveInfo* old_symbol = m_Table.insert(pName, exist);
+  llvm::StringRef name(pEntry.name(), pEntry.nameSize());
+  bool exist = pEntry.isSymbol();
+  ResolveInfo* old_symbol = &pEntry;
   ResolveInfo* new_symbol = NULL;
-  if (exist && old_symbol->isSymbol()) {
-    new_symbol = m_Table.getEntryFactory().produce(pName);
+  if (exist) {
+    new_symbol = getScratchInfo(name);
   } else {
-    exist = false;
     new_symbol = old_symbol;
   }
 
@@ -107,35 +130,114 @@ void NamePool::insertSymbol(const llvm::StringRef& pName,
   } else {
     m_pResolver->resolveAgain(*this, action, *old_symbol, *new_symbol, pResult);
   }
-
-  m_Table.getEntryFactory().destroy(new_symbol);
   return;
 }
 
-llvm::StringRef NamePool::insertString(const llvm::StringRef& pString) {
+/// lookupSymbols - find or create the entries of a batch of names
+void NamePool::lookupSymbols(const std::vector<llvm::StringRef>& pNames,
+                             std::vector<ResolveInfo*>& pEntries,
+                             unsigned pNumThreads) {
+  size_t num = pNames.size();
+  pEntries.resize(num);
+  if (num == 0)
+    return;
+
+  // Step 1. hash the names, a chunk of names per task
+  const size_t chunk_size = 1024;
+  std::vector<uint32_t> hash_values(num);
+  parallel::forEachN(pNumThreads,
+                     0,
+                     (num + chunk_size - 1) / chunk_size,
+                     [&pNames, &hash_values, num, chunk_size](size_t pChunk) {
+    Table::hasher hasher;
+    size_t end = std::min(num, (pChunk + 1) * chunk_size);
+    for (size_t i = pChunk * chunk_size; i < end; ++i)
+      hash_values[i] = hasher(pNames[i]);
+  });
+
+  // Step 2. sort the names by shard, keeping their order in each shard
+  std::vector<size_t> shard_begin(NumOfShards + 1, 0);
+  for (size_t i = 0; i < num; ++i)
+    ++shard_begin[getShard(hash_values[i]) + 1];
+  for (unsigned shard = 0; shard < NumOfShards; ++shard)
+    shard_begin[shard + 1] += shard_begin[shard];
+
+  std::vector<size_t> order(num);
+  std::vector<size_t> cursor(shard_begin.begin(), shard_begin.end() - 1);
+  for (size_t i = 0; i < num; ++i)
+    order[cursor[getShard(hash_values[i])]++] = i;
+
+  // Step 3. fill every shard by one thread
+  parallel::forEachN(pNumThreads,
+                     0,
+                     NumOfShards,
+                     [this, &pNames, &pEntries, &hash_values, &shard_begin,
+                      &order](size_t pShard) {
+    Table& table = m_Shards[pShard];
+    bool exist = false;
+    for (size_t i = shard_begin[pShard]; i < shard_begin[pShard + 1]; ++i) {
+      size_t idx = order[i];
+      pEntries[idx] = table.insert(pNames[idx], hash_values[idx], exist);
+    }
+  });
+}
+
+ResolveInfo* NamePool::lookup(const llvm::StringRef& pName) {
+  uint32_t hash_value = Table::hasher()(pName);
   bool exist = false;
-  ResolveInfo* resolve_info = m_Table.insert(pString, exist);
+  return m_Shards[getShard(hash_value)].insert(pName, hash_value, exist);
+}
+
+ResolveInfo* NamePool::getScratchInfo(const llvm::StringRef& pName) {
+  size_t size = sizeof(ResolveInfo) + pName.size() + 1;
+  size_t num_words = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  if (m_Scratch.size() < num_words)
+    m_Scratch.resize(num_words);
+  return ResolveInfo::construct(m_Scratch.data(), pName);
+}
+
+llvm::StringRef NamePool::insertString(const llvm::StringRef& pString) {
+  ResolveInfo* resolve_info = lookup(pString);
   return llvm::StringRef(resolve_info->name(), resolve_info->nameSize());
 }
 
 void NamePool::reserve(NamePool::size_type pSize) {
-  m_Table.rehash(pSize);
+  for (unsigned shard = 0; shard < NumOfShards; ++shard)
+    m_Shards[shard].rehash(pSize / NumOfShards + 1);
 }
 
 NamePool::size_type NamePool::capacity() const {
-  return (m_Table.numOfBuckets() - m_Table.numOfEntries());
+  size_type result = 0;
+  for (unsigned shard = 0; shard < NumOfShards; ++shard)
+    result += m_Shards[shard].numOfBuckets() - m_Shards[shard].numOfEntries();
+  return result;
+}
+
+NamePool::size_type NamePool::size() const {
+  size_type result = 0;
+  for (unsigned shard = 0; shard < NumOfShards; ++shard)
+    result += m_Shards[shard].numOfEntries();
+  return result;
 }
 
 /// findInfo - find the resolved ResolveInfo
 ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName) {
-  Table::iterator iter = m_Table.find(pName);
-  return iter.getEntry();
+  uint32_t hash_value = Table::hasher()(pName);
+  ResolveInfo* info =
+      m_Shards[getShard(hash_value)].find(pName, hash_value).getEntry();
+  if (info == NULL || !info->isSymbol())
+    return NULL;
+  return info;
 }
 
 /// findInfo - find the resolved ResolveInfo
 const ResolveInfo* NamePool::findInfo(const llvm::StringRef& pName) const {
-  Table::const_iterator iter = m_Table.find(pName);
-  return iter.getEntry();
+  uint32_t hash_value = Table::hasher()(pName);
+  const ResolveInfo* info =
+      m_Shards[getShard(hash_value)].find(pName, hash_value).getEntry();
+  if (info == NULL || !info->isSymbol())
+    return NULL;
+  return info;
 }
 
 /// findSymbol - find the resolved output LDSymbol
@@ -0,0 +1,41 @@
+//===- RelocTable.cpp -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/RelocTable.h"
+
+#include "mcld/LD/ELFReaderIf.h"
+#include "mcld/LD/LDSection.h"
+
+#include <llvm/Support/ELF.h>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// RelocTable
+//===----------------------------------------------------------------------===//
+bool RelocTable::materialize() {
+  if (isMaterialized())
+    return true;
+
+  // the reader appends the decoded Relocations to the section
+  const ELFReaderIF* reader = m_pReader;
+  llvm::StringRef records = m_Records;
+  clear();
+
+  switch (m_pSection->type()) {
+    case llvm::ELF::SHT_RELA:
+      return reader->readRela(*m_pInput, *m_pSection, records);
+    case llvm::ELF::SHT_REL:
+      return reader->readRel(*m_pInput, *m_pSection, records);
+    default:
+      break;
+  }
+  return false;
+}
+
+}  // namespace mcld
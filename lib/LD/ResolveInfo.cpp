@@ -239,7 +239,19 @@ ResolveInfo* ResolveInfo::Create(const ResolveInfo::key_type& pKey) {
   if (info == NULL)
     return NULL;
 
-  new (info) ResolveInfo();  // call constructor at the `result` address.
+  return construct(info, pKey);
+}
+
+ResolveInfo* ResolveInfo::Create(const ResolveInfo::key_type& pKey,
+                                 llvm::BumpPtrAllocator& pAllocator) {
+  void* memory = pAllocator.Allocate(sizeof(ResolveInfo) + pKey.size() + 1,
+                                     alignof(ResolveInfo));
+  return construct(memory, pKey);
+}
+
+ResolveInfo* ResolveInfo::construct(void* pMemory,
+                                    const ResolveInfo::key_type& pKey) {
+  ResolveInfo* info = new (pMemory) ResolveInfo();
   std::memcpy(info->m_Name, pKey.data(), pKey.size());
   info->m_Name[pKey.size()] = '\0';
   info->m_BitField &= ~ResolveInfo::RESOLVE_MASK;
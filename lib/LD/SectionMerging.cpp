@@ -0,0 +1,506 @@
+//===- SectionMerging.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/SectionMerging.h"
+
+#include "mcld/GeneralOptions.h"
+#include "mcld/LinkerConfig.h"
+#include "mcld/LinkerScript.h"
+#include "mcld/Module.h"
+#include "mcld/ADT/StringHash.h"
+#include "mcld/Fragment/FragmentRef.h"
+#include "mcld/Fragment/RegionFragment.h"
+#include "mcld/Fragment/Relocation.h"
+#include "mcld/LD/LDContext.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/RelocData.h"
+#include "mcld/LD/ResolveInfo.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Object/ObjectBuilder.h"
+#include "mcld/Object/SectionMap.h"
+#include "mcld/Support/Parallel.h"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/Support/Casting.h>
+#include <llvm/Support/ELF.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+
+namespace mcld {
+
+namespace {
+
+/// NumOfShards - the pieces of a group are deduplicated by this many workers,
+/// each of which owns the pieces whose hash values have the same top bits.
+const unsigned NumOfShards = 16;
+
+unsigned getShard(uint32_t pHash) {
+  return pHash >> 28;
+}
+
+/** \class PieceTable
+ *  \brief PieceTable maps the contents of a piece to the first piece with the
+ *  same contents. It is used by one worker at a time.
+ */
+template <typename PieceTy>
+class PieceTable {
+ public:
+  PieceTable() : m_Slots(64), m_NumOfEntries(0) {}
+
+  /// insert - return the piece already in the table with pKey, or insert
+  /// pPiece and return it
+  PieceTy* insert(llvm::StringRef pKey, PieceTy* pPiece) {
+    if ((m_NumOfEntries + 1) * 2 > m_Slots.size())
+      grow();
+
+    size_t index = findSlot(m_Slots, pKey, pPiece->Hash);
+    if (m_Slots[index].Piece != NULL)
+      return m_Slots[index].Piece;
+
+    m_Slots[index].Key = pKey;
+    m_Slots[index].Piece = pPiece;
+    ++m_NumOfEntries;
+    return pPiece;
+  }
+
+ private:
+  struct Slot {
+    Slot() : Piece(NULL) {}
+    llvm::StringRef Key;
+    PieceTy* Piece;
+  };
+
+  typedef std::vector<Slot> SlotList;
+
+  static size_t findSlot(const SlotList& pSlots,
+                         llvm::StringRef pKey,
+                         uint32_t pHash) {
+    size_t mask = pSlots.size() - 1;
+    size_t index = pHash & mask;
+    while (pSlots[index].Piece != NULL) {
+      if (pSlots[index].Piece->Hash == pHash && pSlots[index].Key == pKey)
+        break;
+      index = (index + 1) & mask;
+    }
+    return index;
+  }
+
+  void grow() {
+    SlotList slots(m_Slots.size() * 2);
+    typename SlotList::iterator slot, slotEnd = m_Slots.end();
+    for (slot = m_Slots.begin(); slot != slotEnd; ++slot) {
+      if (slot->Piece != NULL)
+        slots[findSlot(slots, slot->Key, slot->Piece->Hash)] = *slot;
+    }
+    m_Slots.swap(slots);
+  }
+
+ private:
+  SlotList m_Slots;
+  size_t m_NumOfEntries;
+};
+
+/// isZero - whether pEntry bytes at pData are all zero
+bool isZero(const char* pData, uint64_t pEntry) {
+  for (uint64_t i = 0; i < pEntry; ++i) {
+    if (pData[i] != 0)
+      return false;
+  }
+  return true;
+}
+
+/// isReversedLess - compare pX and pY from their last characters
+bool isReversedLess(llvm::StringRef pX, llvm::StringRef pY) {
+  typedef std::reverse_iterator<const char*> ReverseIterator;
+  return std::lexicographical_compare(ReverseIterator(pX.end()),
+                                      ReverseIterator(pX.begin()),
+                                      ReverseIterator(pY.end()),
+                                      ReverseIterator(pY.begin()));
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// SectionMerging
+//===----------------------------------------------------------------------===//
+SectionMerging::SectionMerging(const LinkerConfig& pConfig, Module& pModule)
+    : m_Config(pConfig), m_Module(pModule) {
+}
+
+SectionMerging::~SectionMerging() {
+  std::vector<Group*>::iterator group, groupEnd = m_Groups.end();
+  for (group = m_Groups.begin(); group != groupEnd; ++group)
+    delete *group;
+}
+
+void SectionMerging::run() {
+  collect();
+  if (m_Groups.empty())
+    return;
+
+  unsigned threads = m_Config.options().numThreads();
+
+  // 1. Split every input section into pieces and hash them.
+  std::vector<std::pair<Group*, Member*> > members;
+  std::vector<Group*>::iterator group, groupEnd = m_Groups.end();
+  for (group = m_Groups.begin(); group != groupEnd; ++group) {
+    std::vector<Member>::iterator member, memEnd = (*group)->Members.end();
+    for (member = (*group)->Members.begin(); member != memEnd; ++member)
+      members.push_back(std::make_pair(*group, &*member));
+  }
+  parallel::forEachN(threads, 0, members.size(), [&members](size_t pIdx) {
+    split(*members[pIdx].first, *members[pIdx].second);
+  });
+
+  // 2. Find the leader of every piece. The shards of a group are disjoint, so
+  // they are deduplicated at the same time.
+  parallel::forEachN(threads, 0, m_Groups.size() * NumOfShards,
+                     [this](size_t pIdx) {
+    deduplicate(*m_Groups[pIdx / NumOfShards], pIdx % NumOfShards);
+  });
+
+  // 3. Lay out the leaders in input order and build the merged contents.
+  for (group = m_Groups.begin(); group != groupEnd; ++group)
+    layout(**group);
+
+  // 4. Redirect the symbols and relocations, then replace the input contents.
+  redirect();
+  for (group = m_Groups.begin(); group != groupEnd; ++group) {
+    std::vector<Member>::iterator member, memEnd = (*group)->Members.end();
+    member = (*group)->Members.begin();
+    SectionData* data = member->Section->getSectionData();
+    data->getFragmentList().clear();
+    ObjectBuilder::AppendFragment(*(*group)->Frag, *data);
+    member->Section->setSize((*group)->Contents.size());
+
+    for (++member; member != memEnd; ++member)
+      member->Section->setKind(LDFileFormat::Folded);
+  }
+}
+
+void SectionMerging::collect() {
+  typedef std::tuple<const void*, std::string, uint32_t, uint64_t, uint32_t>
+      GroupKey;
+  typedef std::map<GroupKey, Group*> GroupMap;
+  GroupMap groups;
+
+  // 1. Collect the candidates.
+  std::set<const LDSection*> candidates;
+  std::vector<std::pair<Input*, LDSection*> > sections;
+  SectionMap& section_map = m_Module.getScript().sectionMap();
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      LDSection* section = *sect;
+      if (section == NULL || (section->flag() & llvm::ELF::SHF_MERGE) == 0)
+        continue;
+      if (section->kind() != LDFileFormat::DATA &&
+          section->kind() != LDFileFormat::MetaData)
+        continue;
+
+      uint64_t entsize = section->entSize();
+      if (entsize == 0 || section->size() == 0 ||
+          section->size() % entsize != 0 || section->size() > UINT32_MAX)
+        continue;
+
+      // the contents have to be a single input region
+      if (!section->hasSectionData() ||
+          section->getSectionData()->size() != 1 ||
+          !llvm::isa<RegionFragment>(section->getSectionData()->front()))
+        continue;
+      llvm::StringRef region =
+          llvm::cast<RegionFragment>(section->getSectionData()->front())
+              .getRegion();
+      if (region.size() != section->size())
+        continue;
+
+      // the last string has to be terminated
+      if ((section->flag() & llvm::ELF::SHF_STRINGS) != 0 &&
+          !isZero(region.end() - entsize, entsize))
+        continue;
+
+      candidates.insert(section);
+      sections.push_back(std::make_pair(*obj, section));
+    }
+  }
+
+  // 2. Drop the candidates whose contents are relocated, and those referred by
+  // the section symbols of REL relocations, whose addends are in the place
+  // being relocated and can not be redirected.
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator rs, rsEnd = (*obj)->context()->relocSectEnd();
+    for (rs = (*obj)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+      candidates.erase((*rs)->getLink());
+      if ((*rs)->type() != llvm::ELF::SHT_REL)
+        continue;
+
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        ResolveInfo* info = llvm::cast<Relocation>(reloc)->symInfo();
+        if (info->type() != ResolveInfo::Section || info->outSymbol() == NULL ||
+            !info->outSymbol()->hasFragRef())
+          continue;
+        candidates.erase(
+            &info->outSymbol()->fragRef()->frag()->getParent()->getSection());
+      }
+    }
+  }
+
+  // 3. Group the candidates by their destination.
+  std::vector<std::pair<Input*, LDSection*> >::iterator it,
+      itEnd = sections.end();
+  for (it = sections.begin(); it != itEnd; ++it) {
+    LDSection* section = it->second;
+    if (candidates.count(section) == 0)
+      continue;
+
+    SectionMap::mapping pair =
+        section_map.find(it->first->path().native(), section->name());
+    if (pair.first != NULL && pair.first->isDiscard())
+      continue;
+
+    GroupKey key(pair.second,
+                 (pair.first == NULL) ? section->name() : pair.first->name(),
+                 section->flag(),
+                 section->entSize(),
+                 section->align());
+    Group*& group = groups[key];
+    if (group == NULL) {
+      group = new Group();
+      group->EntSize = section->entSize();
+      group->Align = (section->align() == 0) ? 1 : section->align();
+      group->IsString = ((section->flag() & llvm::ELF::SHF_STRINGS) != 0);
+      group->Frag = NULL;
+      m_Groups.push_back(group);
+    }
+
+    Member member;
+    member.Obj = it->first;
+    member.Section = section;
+    member.Frag = &section->getSectionData()->front();
+    member.Data = llvm::cast<RegionFragment>(member.Frag)->getRegion();
+    group->Members.push_back(member);
+  }
+}
+
+void SectionMerging::split(const Group& pGroup, Member& pMember) {
+  hash::StringHash<hash::WY> hasher;
+  const char* data = pMember.Data.data();
+  uint64_t size = pMember.Data.size();
+  uint64_t entsize = pGroup.EntSize;
+
+  if (!pGroup.IsString)
+    pMember.Pieces.reserve(size / entsize);
+
+  uint64_t offset = 0;
+  while (offset < size) {
+    uint64_t end = offset + entsize;
+    if (pGroup.IsString) {
+      if (entsize == 1) {
+        // let the C library find the terminator a vector at a time
+        const void* nul = std::memchr(data + offset, 0, size - offset);
+        end = static_cast<const char*>(nul) - data + 1;
+      } else {
+        while (!isZero(data + end - entsize, entsize))
+          end += entsize;
+      }
+    }
+
+    Piece piece;
+    piece.InputOffset = offset;
+    piece.Size = end - offset;
+    piece.Hash = hasher(llvm::StringRef(data + offset, end - offset));
+    piece.Leader = NULL;
+    piece.OutputOffset = 0;
+    pMember.Pieces.push_back(piece);
+    offset = end;
+  }
+}
+
+void SectionMerging::deduplicate(Group& pGroup, unsigned pShard) {
+  PieceTable<Piece> table;
+  std::vector<Member>::iterator member, memEnd = pGroup.Members.end();
+  for (member = pGroup.Members.begin(); member != memEnd; ++member) {
+    std::vector<Piece>::iterator piece, pEnd = member->Pieces.end();
+    for (piece = member->Pieces.begin(); piece != pEnd; ++piece) {
+      if (getShard(piece->Hash) != pShard)
+        continue;
+      llvm::StringRef key(member->Data.data() + piece->InputOffset,
+                          piece->Size);
+      piece->Leader = table.insert(key, &*piece);
+    }
+  }
+}
+
+void SectionMerging::layout(Group& pGroup) {
+  std::vector<Member>::iterator member, memEnd = pGroup.Members.end();
+  uint64_t offset = 0;
+
+  if (m_Config.options().tailMergeStrings() && pGroup.IsString &&
+      pGroup.EntSize == 1 && pGroup.Align == 1) {
+    // Sort the leaders by their reversed contents, longest first. Then if a
+    // string is the tail of another, it is the tail of the last string which
+    // got its own space.
+    std::vector<std::pair<llvm::StringRef, Piece*> > leaders;
+    for (member = pGroup.Members.begin(); member != memEnd; ++member) {
+      std::vector<Piece>::iterator piece, pEnd = member->Pieces.end();
+      for (piece = member->Pieces.begin(); piece != pEnd; ++piece) {
+        if (piece->Leader == &*piece) {
+          llvm::StringRef str(member->Data.data() + piece->InputOffset,
+                              piece->Size);
+          leaders.push_back(std::make_pair(str, &*piece));
+        }
+      }
+    }
+    std::sort(leaders.begin(), leaders.end(),
+              [](const std::pair<llvm::StringRef, Piece*>& pX,
+                 const std::pair<llvm::StringRef, Piece*>& pY) {
+      return isReversedLess(pY.first, pX.first);
+    });
+
+    llvm::StringRef last;
+    uint64_t last_offset = 0;
+    for (size_t i = 0; i < leaders.size(); ++i) {
+      llvm::StringRef str = leaders[i].first;
+      if (last.endswith(str)) {
+        leaders[i].second->OutputOffset = last_offset + last.size() -
+                                          str.size();
+        continue;
+      }
+      leaders[i].second->OutputOffset = offset;
+      last = str;
+      last_offset = offset;
+      offset += str.size();
+    }
+  } else {
+    // the leaders come before the other pieces with the same contents
+    for (member = pGroup.Members.begin(); member != memEnd; ++member) {
+      std::vector<Piece>::iterator piece, pEnd = member->Pieces.end();
+      for (piece = member->Pieces.begin(); piece != pEnd; ++piece) {
+        if (piece->Leader != &*piece)
+          continue;
+        offset = (offset + pGroup.Align - 1) / pGroup.Align * pGroup.Align;
+        piece->OutputOffset = offset;
+        offset += piece->Size;
+      }
+    }
+  }
+
+  pGroup.Contents.assign(offset, 0);
+  for (member = pGroup.Members.begin(); member != memEnd; ++member) {
+    std::vector<Piece>::iterator piece, pEnd = member->Pieces.end();
+    for (piece = member->Pieces.begin(); piece != pEnd; ++piece) {
+      if (piece->Leader == &*piece) {
+        std::memcpy(&pGroup.Contents[piece->OutputOffset],
+                    member->Data.data() + piece->InputOffset,
+                    piece->Size);
+      } else {
+        piece->OutputOffset = piece->Leader->OutputOffset;
+      }
+    }
+  }
+
+  pGroup.Frag = new RegionFragment(
+      llvm::StringRef(pGroup.Contents.data(), pGroup.Contents.size()));
+}
+
+void SectionMerging::redirect() {
+  typedef llvm::DenseMap<const Fragment*, std::pair<Group*, Member*> >
+      MemberMap;
+  MemberMap members;
+  std::set<Input*> objects;
+  std::vector<Group*>::iterator group, groupEnd = m_Groups.end();
+  for (group = m_Groups.begin(); group != groupEnd; ++group) {
+    std::vector<Member>::iterator member, memEnd = (*group)->Members.end();
+    for (member = (*group)->Members.begin(); member != memEnd; ++member) {
+      members[member->Frag] = std::make_pair(*group, &*member);
+      objects.insert(member->Obj);
+    }
+  }
+
+  // 1. A relocation against a section symbol refers to the offset of its
+  // addend. Redirect the addend to the merged piece; the section symbol is
+  // redirected to the start of the merged contents below.
+  Module::obj_iterator obj, objEnd = m_Module.obj_end();
+  for (obj = m_Module.obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sect_iterator rs, rsEnd = (*obj)->context()->relocSectEnd();
+    for (rs = (*obj)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        Relocation* relocation = llvm::cast<Relocation>(reloc);
+        ResolveInfo* info = relocation->symInfo();
+        if (info->type() != ResolveInfo::Section || info->outSymbol() == NULL ||
+            !info->outSymbol()->hasFragRef())
+          continue;
+        FragmentRef* frag_ref = info->outSymbol()->fragRef();
+        MemberMap::iterator entry = members.find(frag_ref->frag());
+        if (entry == members.end())
+          continue;
+
+        const Member& member = *entry->second.second;
+        int64_t offset = frag_ref->offset() + relocation->addend();
+        if (offset >= 0 && static_cast<uint64_t>(offset) < member.Data.size()) {
+          relocation->setAddend(getOutputOffset(member, offset));
+        } else {
+          // out of the section, keep the distance to the first piece
+          relocation->setAddend(getOutputOffset(member, 0) + offset);
+        }
+      }
+    }
+  }
+
+  // 2. Redirect the symbols defined in the merged sections. An output symbol
+  // shares the FragmentRef of the input symbol that defines it.
+  std::set<Input*>::iterator it, itEnd = objects.end();
+  for (it = objects.begin(); it != itEnd; ++it) {
+    LDContext::sym_iterator sym, symEnd = (*it)->context()->symTabEnd();
+    for (sym = (*it)->context()->symTabBegin(); sym != symEnd; ++sym) {
+      if (!(*sym)->hasFragRef())
+        continue;
+      FragmentRef* frag_ref = (*sym)->fragRef();
+      MemberMap::iterator entry = members.find(frag_ref->frag());
+      if (entry == members.end())
+        continue;
+
+      Group& target = *entry->second.first;
+      if ((*sym)->type() == ResolveInfo::Section)
+        frag_ref->assign(*target.Frag, 0);
+      else
+        frag_ref->assign(*target.Frag,
+                         getOutputOffset(*entry->second.second,
+                                         frag_ref->offset()));
+    }
+  }
+}
+
+uint64_t SectionMerging::getOutputOffset(const Member& pMember,
+                                         uint64_t pOffset) {
+  // find the last piece which starts at or before pOffset
+  std::vector<Piece>::const_iterator piece = std::upper_bound(
+      pMember.Pieces.begin(), pMember.Pieces.end(), pOffset,
+      [](uint64_t pValue, const Piece& pPiece) {
+        return pValue < pPiece.InputOffset;
+      });
+  --piece;
+  return piece->OutputOffset + (pOffset - piece->InputOffset);
+}
+
+}  // namespace mcld
@@ -24,6 +24,10 @@ namespace mcld {
 //===----------------------------------------------------------------------===//
 // StubFactory
 //===----------------------------------------------------------------------===//
+StubFactory::StubFactory()
+    : m_NumOfExamined(0), m_NumOfSkipped(0), m_NumOfStubs(0) {
+}
+
 StubFactory::~StubFactory() {
   for (StubPoolType::iterator it = m_StubPool.begin(), ie = m_StubPool.end();
        it != ie;
@@ -41,9 +45,22 @@ Stub* StubFactory::create(Relocation& pReloc,
                           uint64_t pTargetSymValue,
                           IRBuilder& pBuilder,
                           BranchIslandFactory& pBRIslandFactory) {
+  // skip the branch if it has not moved since it was found in range
+  uint64_t place = pReloc.place();
+  BranchMap::iterator examined = m_Examined.find(&pReloc);
+  if (examined != m_Examined.end()) {
+    const Branch& branch = examined->second;
+    if (branch.Place == place && branch.Target == pTargetSymValue &&
+        branch.Symbol == pReloc.symInfo()) {
+      ++m_NumOfSkipped;
+      return NULL;
+    }
+  }
+  ++m_NumOfExamined;
+
   // find if there is a prototype stub for the input relocation
   Stub* stub = NULL;
-  Stub* prototype = findPrototype(pReloc, pReloc.place(), pTargetSymValue);
+  Stub* prototype = findPrototype(pReloc, place, pTargetSymValue);
   if (prototype != NULL) {
     const Fragment* frag = pReloc.targetRef().frag();
     // find the islands for the input relocation
@@ -71,9 +88,17 @@ Stub* StubFactory::create(Relocation& pReloc,
 
         // add stub to the forward branch island
         islands.first->addStub(prototype, pReloc, *stub);
+        ++m_NumOfStubs;
       }
     }
   }
+
+  if (stub == NULL) {
+    Branch branch = {place, pTargetSymValue, pReloc.symInfo()};
+    m_Examined[&pReloc] = branch;
+  } else {
+    m_Examined.erase(&pReloc);
+  }
   return stub;
 }
 
@@ -98,6 +123,7 @@ Stub* StubFactory::create(FragmentRef& pFragRef,
 
       // add stub to the forward branch island
       islands.first->addStub(*stub);
+      ++m_NumOfStubs;
 
       return stub;
     }  // (islands.first == NULL)
@@ -14,10 +14,12 @@ namespace mcld {
 //===----------------------------------------------------------------------===//
 // MCLDDirectory
 //===----------------------------------------------------------------------===//
-MCLDDirectory::MCLDDirectory() : Directory(), m_Name(), m_bInSysroot(false) {
+MCLDDirectory::MCLDDirectory()
+    : Directory(), m_Name(), m_bInSysroot(false), m_bIndexed(false) {
 }
 
-MCLDDirectory::MCLDDirectory(const char* pName) : Directory(), m_Name(pName) {
+MCLDDirectory::MCLDDirectory(const char* pName)
+    : Directory(), m_Name(pName), m_bIndexed(false) {
   Directory::m_Path.assign(pName);
 
   if (!Directory::m_Path.empty())
@@ -31,7 +33,7 @@ MCLDDirectory::MCLDDirectory(const char* pName) : Directory(), m_Name(pName) {
 }
 
 MCLDDirectory::MCLDDirectory(const std::string& pName)
-    : Directory(), m_Name(pName) {
+    : Directory(), m_Name(pName), m_bIndexed(false) {
   Directory::m_Path.assign(pName);
 
   if (!Directory::m_Path.empty())
@@ -45,7 +47,7 @@ MCLDDirectory::MCLDDirectory(const std::string& pName)
 }
 
 MCLDDirectory::MCLDDirectory(llvm::StringRef pName)
-    : Directory(), m_Name(pName.data(), pName.size()) {
+    : Directory(), m_Name(pName.data(), pName.size()), m_bIndexed(false) {
   Directory::m_Path.assign(pName.str());
 
   if (!Directory::m_Path.empty())
@@ -74,6 +76,8 @@ MCLDDirectory& MCLDDirectory::assign(llvm::StringRef pName) {
   Directory::m_SymLinkStatus = sys::fs::FileStatus();
   Directory::m_Cache.clear();
   Directory::m_Handler = 0;
+  m_Index.clear();
+  m_bIndexed = false;
   return (*this);
 }
 
@@ -92,7 +96,23 @@ void MCLDDirectory::setSysroot(const sys::fs::Path& pSysroot) {
     Directory::m_Path.native() += old_path;
     sys::fs::detail::canonicalize(Directory::m_Path.native());
     sys::fs::detail::open_dir(*this);
+    m_Index.clear();
+    m_bIndexed = false;
   }
 }
 
+sys::fs::Path* MCLDDirectory::find(llvm::StringRef pFileName) {
+  if (!m_bIndexed) {
+    iterator entry = begin(), enEnd = end();
+    for (; entry != enEnd; ++entry)
+      m_Index[entry.path()->filename().native()] = entry.path();
+    m_bIndexed = true;
+  }
+
+  llvm::StringMap<sys::fs::Path*>::iterator file = m_Index.find(pFileName);
+  if (file == m_Index.end())
+    return NULL;
+  return file->getValue();
+}
+
 }  // namespace mcld
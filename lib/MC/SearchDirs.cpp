@@ -85,116 +85,40 @@ mcld::sys::fs::Path* SearchDirs::find(const std::string& pNamespec,
       break;
   }  // end of switch
 
+  std::string shared_lib = file + sys::fs::detail::shared_library_extension;
+  std::string static_lib = file + sys::fs::detail::static_library_extension;
+
   // for all MCLDDirectorys
   DirList::iterator mcld_dir, mcld_dir_end = m_DirList.end();
   for (mcld_dir = m_DirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
-    // for all entries in MCLDDirectory
-    MCLDDirectory::iterator entry = (*mcld_dir)->begin();
-    MCLDDirectory::iterator enEnd = (*mcld_dir)->end();
-
+    sys::fs::Path* path = NULL;
     switch (pType) {
       case Input::Script: {
-        while (entry != enEnd) {
-          if (file == entry.path()->filename().native())
-            return entry.path();
-          ++entry;
-        }
+        path = (*mcld_dir)->find(file);
         break;
       }
       case Input::DynObj: {
-        while (entry != enEnd) {
-          if (file == entry.path()->stem().native()) {
-            if (mcld::sys::fs::detail::shared_library_extension ==
-                entry.path()->extension().native()) {
-              return entry.path();
-            }
-          }
-          ++entry;
-        }
+        path = (*mcld_dir)->find(shared_lib);
+        if (path != NULL)
+          break;
       }
       /** Fall through **/
       case Input::Archive: {
-        entry = (*mcld_dir)->begin();
-        enEnd = (*mcld_dir)->end();
-        while (entry != enEnd) {
-          if (file == entry.path()->stem().native() &&
-              mcld::sys::fs::detail::static_library_extension ==
-                  entry.path()->extension().native()) {
-            return entry.path();
-          }
-          ++entry;
-        }
+        path = (*mcld_dir)->find(static_lib);
+        break;
       }
       default:
         break;
     }  // end of switch
-  }    // end of for
+    if (path != NULL)
+      return path;
+  }  // end of for
   return NULL;
 }
 
 const mcld::sys::fs::Path* SearchDirs::find(const std::string& pNamespec,
                                             mcld::Input::Type pType) const {
-  assert(Input::DynObj == pType || Input::Archive == pType ||
-         Input::Script == pType);
-
-  std::string file;
-  switch (pType) {
-    case Input::Script:
-      file.assign(pNamespec);
-      break;
-    case Input::DynObj:
-    case Input::Archive:
-      SpecToFilename(pNamespec, file);
-      break;
-    default:
-      break;
-  }  // end of switch
-
-  // for all MCLDDirectorys
-  DirList::const_iterator mcld_dir, mcld_dir_end = m_DirList.end();
-  for (mcld_dir = m_DirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
-    // for all entries in MCLDDirectory
-    MCLDDirectory::iterator entry = (*mcld_dir)->begin();
-    MCLDDirectory::iterator enEnd = (*mcld_dir)->end();
-
-    switch (pType) {
-      case Input::Script: {
-        while (entry != enEnd) {
-          if (file == entry.path()->filename().native())
-            return entry.path();
-          ++entry;
-        }
-        break;
-      }
-      case Input::DynObj: {
-        while (entry != enEnd) {
-          if (file == entry.path()->stem().native()) {
-            if (mcld::sys::fs::detail::shared_library_extension ==
-                entry.path()->extension().native()) {
-              return entry.path();
-            }
-          }
-          ++entry;
-        }
-      }
-      /** Fall through **/
-      case Input::Archive: {
-        entry = (*mcld_dir)->begin();
-        enEnd = (*mcld_dir)->end();
-        while (entry != enEnd) {
-          if (file == entry.path()->stem().native() &&
-              mcld::sys::fs::detail::static_library_extension ==
-                  entry.path()->extension().native()) {
-            return entry.path();
-          }
-          ++entry;
-        }
-      }
-      default:
-        break;
-    }  // end of switch
-  }    // end of for
-  return NULL;
+  return const_cast<SearchDirs*>(this)->find(pNamespec, pType);
 }
 
 }  // namespace mcld
@@ -31,6 +31,7 @@
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/LD/SectionMerging.h"
 #include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Script/Assignment.h"
 #include "mcld/Script/Operand.h"
@@ -38,7 +39,9 @@
 #include "mcld/Script/ScriptFile.h"
 #include "mcld/Script/ScriptReader.h"
 #include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/LinkerStats.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/Parallel.h"
 #include "mcld/Support/RealPath.h"
 #include "mcld/Target/TargetLDBackend.h"
 
@@ -46,6 +49,7 @@
 #include <llvm/Support/Host.h>
 
 #include <system_error>
+#include <vector>
 
 namespace mcld {
 
@@ -64,7 +68,8 @@ ObjectLinker::ObjectLinker(const LinkerConfig& pConfig,
       m_pGroupReader(NULL),
       m_pBinaryReader(NULL),
       m_pScriptReader(NULL),
-      m_pWriter(NULL) {
+      m_pWriter(NULL),
+      m_pSectionMerging(NULL) {
 }
 
 ObjectLinker::~ObjectLinker() {
@@ -75,6 +80,7 @@ ObjectLinker::~ObjectLinker() {
   delete m_pBinaryReader;
   delete m_pScriptReader;
   delete m_pWriter;
+  delete m_pSectionMerging;
 }
 
 bool ObjectLinker::initialize(Module& pModule, IRBuilder& pBuilder) {
@@ -144,6 +150,11 @@ void ObjectLinker::addUndefinedSymbols() {
 }
 
 void ObjectLinker::normalize() {
+  // parse the file headers and tables concurrently. The inputs are still read
+  // one by one below, so symbols are resolved in command-line order.
+  if (m_Config.options().hasThreads())
+    prefetchInputs();
+
   // -----  set up inputs  ----- //
   Module::input_iterator input, inEnd = m_pModule->input_end();
   for (input = m_pModule->input_begin(); input != inEnd; ++input) {
@@ -224,6 +235,32 @@ void ObjectLinker::normalize() {
             << (*input)->path() << m_Config.targets().triple().str();
     }
   }  // end of for
+
+  // --lazy-dso-symbols: the symbols defined in the output and in a shared
+  // library are exported, and the undefined ones are defined by the first
+  // library, as if the libraries had been read in full.
+  m_pModule->getLazyDynSymbols().resolveAll();
+}
+
+void ObjectLinker::prefetchInputs() {
+  std::vector<Input*> inputs;
+  InputTree::dfs_iterator input, inEnd = m_pModule->getInputTree().dfs_end();
+  for (input = m_pModule->getInputTree().dfs_begin(); input != inEnd; ++input) {
+    if (isGroup(input))
+      continue;
+    if (Input::Unknown == (*input)->type() && (*input)->hasMemArea())
+      inputs.push_back(*input);
+  }
+
+  ObjectReader* obj_reader = getObjectReader();
+  DynObjReader* dynobj_reader = getDynObjReader();
+  parallel::forEach(m_Config.options().numThreads(),
+                    inputs.begin(),
+                    inputs.end(),
+                    [obj_reader, dynobj_reader](Input* pInput) {
+                      if (!obj_reader->prefetch(*pInput))
+                        dynobj_reader->prefetch(*pInput);
+                    });
 }
 
 bool ObjectLinker::linkable() const {
@@ -263,6 +300,7 @@ bool ObjectLinker::linkable() const {
 
 void ObjectLinker::dataStrippingOpt() {
   if (m_Config.codeGenType() == LinkerConfig::Object) {
+    materializeRelocations();
     return;
   }
 
@@ -272,6 +310,10 @@ void ObjectLinker::dataStrippingOpt() {
     GC.run();
   }
 
+  // The passes from here on work on Relocations. The relocations of the
+  // sections discarded by garbage collection are never materialized.
+  materializeRelocations();
+
   // Identical code folding
   if (m_Config.options().getICFMode() != GeneralOptions::ICF::None) {
     IdenticalCodeFolding icf(m_Config, m_LDBackend, *m_pModule);
@@ -298,6 +340,24 @@ bool ObjectLinker::readRelocations() {
   return true;
 }
 
+/// materializeRelocations - create the Relocations of the kept sections
+void ObjectLinker::materializeRelocations() {
+  Module::obj_iterator input, inEnd = m_pModule->obj_end();
+  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
+    LDContext* context = (*input)->context();
+    LDContext::sect_iterator rs, rsEnd = context->relocSectEnd();
+    for (rs = context->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (!(*rs)->hasRelocData())
+        continue;
+      RelocTable& table = (*rs)->getRelocData()->getTable();
+      if (LDFileFormat::Ignore == (*rs)->kind())
+        table.clear();
+      else if (!table.materialize())
+        fatal(diag::fatal_cannot_read_input) << (*input)->path();
+    }
+  }
+}
+
 /// mergeSections - put allinput sections into output sections
 bool ObjectLinker::mergeSections() {
   // run the target-dependent hooks before merging sections
@@ -335,6 +395,14 @@ bool ObjectLinker::mergeSections() {
     }  // for each output section description
   }
 
+  // Merge the strings and constants of SHF_MERGE sections. The merged
+  // contents replace the first section of each group below.
+  if (m_Config.options().mergeSections() &&
+      LinkerConfig::Object != m_Config.codeGenType()) {
+    m_pSectionMerging = new SectionMerging(m_Config, *m_pModule);
+    m_pSectionMerging->run();
+  }
+
   ObjectBuilder builder(*m_pModule);
   Module::obj_iterator obj, objEnd = m_pModule->obj_end();
   for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
@@ -781,50 +849,33 @@ bool ObjectLinker::relocation() {
   if (LinkerConfig::Object == m_Config.codeGenType())
     return true;
 
-  LDSection* debug_str_sect = m_pModule->getSection(".debug_str");
-
-  // apply all relocations of all inputs
-  Module::obj_iterator input, inEnd = m_pModule->obj_end();
-  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
-    m_LDBackend.getRelocator()->initializeApply(**input);
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the reloc section if
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
-        continue;
-      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
-      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
-        Relocation* relocation = llvm::cast<Relocation>(reloc);
+  // relocations will be applied by emitOutput
+  if (isDirectRelocation())
+    return true;
 
-        // bypass the reloc if the symbol is in the discarded input section
-        ResolveInfo* info = relocation->symInfo();
-        if (!info->outSymbol()->hasFragRef() &&
-            ResolveInfo::Section == info->type() &&
-            ResolveInfo::Undefined == info->desc())
-          continue;
+  applyAllRelocations(NULL);
+  return true;
+}
 
-        // apply the relocation aginst symbol on DebugString
-        if (info->outSymbol()->hasFragRef() &&
-            info->outSymbol()->fragRef()->frag()->getKind()
-                == Fragment::Region &&
-            info->outSymbol()->fragRef()->frag()->getParent()->getSection()
-                .kind() == LDFileFormat::DebugString) {
-          assert(debug_str_sect != NULL);
-          assert(debug_str_sect->hasDebugString());
-          debug_str_sect->getDebugString()->applyOffset(*relocation,
-                                                        m_LDBackend);
-          continue;
-        }
+void ObjectLinker::applyAllRelocations(uint8_t* pOutput) {
+  LDSection* debug_str_sect = m_pModule->getSection(".debug_str");
 
-        relocation->apply(*m_LDBackend.getRelocator());
-      }  // for all relocations
-    }    // for all relocation section
-    m_LDBackend.getRelocator()->finalizeApply(**input);
-  }  // for all inputs
+  // apply all relocations of all inputs
+  Relocator* relocator = m_LDBackend.getRelocator();
+  if (m_Config.options().hasThreads() && relocator->isConcurrentApplySafe()) {
+    // relocations of different inputs never write the same place, so each
+    // worker takes a whole input.
+    parallel::forEach(m_Config.options().numThreads(),
+                      m_pModule->obj_begin(),
+                      m_pModule->obj_end(),
+                      [this, debug_str_sect, pOutput](Input* pInput) {
+                        applyRelocations(*pInput, debug_str_sect, pOutput);
+                      });
+  } else {
+    Module::obj_iterator input, inEnd = m_pModule->obj_end();
+    for (input = m_pModule->obj_begin(); input != inEnd; ++input)
+      applyRelocations(**input, debug_str_sect, pOutput);
+  }
 
   // apply relocations created by relaxation
   BranchIslandFactory* br_factory = m_LDBackend.getBRIslandFactory();
@@ -832,31 +883,98 @@ bool ObjectLinker::relocation() {
   for (facIter = br_factory->begin(); facIter != facEnd; ++facIter) {
     BranchIsland& island = *facIter;
     BranchIsland::reloc_iterator iter, iterEnd = island.reloc_end();
-    for (iter = island.reloc_begin(); iter != iterEnd; ++iter)
-      (*iter)->apply(*m_LDBackend.getRelocator());
+    for (iter = island.reloc_begin(); iter != iterEnd; ++iter) {
+      (*iter)->apply(*relocator);
+      if (pOutput != NULL)
+        writeRelocationResult(**iter, pOutput);
+    }
   }
 
   // apply relocations created by LD backend
   for (TargetLDBackend::extra_reloc_iterator
        iter = m_LDBackend.extra_reloc_begin(),
        end = m_LDBackend.extra_reloc_end(); iter != end; ++iter) {
-    iter->apply(*m_LDBackend.getRelocator());
+    iter->apply(*relocator);
+    if (pOutput != NULL)
+      writeRelocationResult(*iter, pOutput);
   }
+}
 
-  return true;
+/// applyRelocations - apply all relocations of the input
+void ObjectLinker::applyRelocations(Input& pInput,
+                                    LDSection* pDebugStrSect,
+                                    uint8_t* pOutput) {
+  Relocator* relocator = m_LDBackend.getRelocator();
+  relocator->initializeApply(pInput);
+  LDContext::sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    // bypass the reloc section if
+    // 1. its section kind is changed to Ignore. (The target section is a
+    // discarded group section.)
+    // 2. it has no reloc data. (All symbols in the input relocs are in the
+    // discarded group sections)
+    if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+      continue;
+    RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+    for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+      Relocation* relocation = llvm::cast<Relocation>(reloc);
+
+      // bypass the reloc if the symbol is in the discarded input section
+      ResolveInfo* info = relocation->symInfo();
+      if (!info->outSymbol()->hasFragRef() &&
+          ResolveInfo::Section == info->type() &&
+          ResolveInfo::Undefined == info->desc())
+        continue;
+
+      // apply the relocation aginst symbol on DebugString
+      if (info->outSymbol()->hasFragRef() &&
+          info->outSymbol()->fragRef()->frag()->getKind()
+              == Fragment::Region &&
+          info->outSymbol()->fragRef()->frag()->getParent()->getSection()
+              .kind() == LDFileFormat::DebugString) {
+        assert(pDebugStrSect != NULL);
+        assert(pDebugStrSect->hasDebugString());
+        pDebugStrSect->getDebugString()->applyOffset(*relocation,
+                                                     m_LDBackend);
+      } else {
+        relocation->apply(*relocator);
+      }
+
+      // write the result right away. NONE type relocations are bypassed as
+      // normalSyncRelocationResult does.
+      if (pOutput != NULL && relocation->type() != 0x0)
+        writeRelocationResult(*relocation, pOutput);
+    }  // for all relocations
+  }    // for all relocation section
+  relocator->finalizeApply(pInput);
+}
+
+bool ObjectLinker::isDirectRelocation() const {
+  return m_Config.options().directRelocation() &&
+         LinkerConfig::Object != m_Config.codeGenType();
 }
 
 /// emitOutput - emit the output file.
 bool ObjectLinker::emitOutput(FileOutputBuffer& pOutput) {
-  return std::error_code() == getWriter()->writeObject(*m_pModule, pOutput);
+  if (!isDirectRelocation())
+    return std::error_code() == getWriter()->writeObject(*m_pModule, pOutput);
+
+  // apply relocations straight into the output buffer once the input
+  // sections are written. This replaces the second traversal of
+  // normalSyncRelocationResult.
+  uint8_t* buffer = pOutput.getBufferStart();
+  return std::error_code() ==
+         getWriter()->writeObject(*m_pModule, pOutput, [this, buffer]() {
+           applyAllRelocations(buffer);
+         });
 }
 
 /// postProcessing - do modification after all processes
 bool ObjectLinker::postProcessing(FileOutputBuffer& pOutput) {
-  if (LinkerConfig::Object != m_Config.codeGenType())
-    normalSyncRelocationResult(pOutput);
-  else
+  if (LinkerConfig::Object == m_Config.codeGenType())
     partialSyncRelocationResult(pOutput);
+  else if (!isDirectRelocation())
+    normalSyncRelocationResult(pOutput);
 
   // emit .eh_frame_hdr
   // eh_frame_hdr should be emitted after syncRelocation, because eh_frame_hdr
@@ -865,6 +983,39 @@ bool ObjectLinker::postProcessing(FileOutputBuffer& pOutput) {
   return true;
 }
 
+void ObjectLinker::collectStats(LinkerStats& pStats) const {
+  uint64_t num_sections = 0, num_relocs = 0;
+  Module::const_obj_iterator obj, objEnd = m_pModule->obj_end();
+  for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
+    LDContext::const_sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
+    for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
+      if (*sect != NULL)
+        ++num_sections;
+    }
+    LDContext::const_sect_iterator rs, rsEnd = (*obj)->context()->relocSectEnd();
+    for (rs = (*obj)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if ((*rs)->hasRelocData())
+        num_relocs += (*rs)->getRelocData()->size();
+    }
+  }
+
+  uint64_t num_frags = 0;
+  Module::const_iterator out, outEnd = m_pModule->end();
+  for (out = m_pModule->begin(); out != outEnd; ++out) {
+    if ((*out)->hasSectionData())
+      num_frags += (*out)->getSectionData()->size();
+  }
+
+  pStats.setCounter("objects", m_pModule->getObjectList().size());
+  pStats.setCounter("shared objects", m_pModule->getLibraryList().size());
+  pStats.setCounter("input sections", num_sections);
+  pStats.setCounter("output sections", m_pModule->size());
+  pStats.setCounter("fragments", num_frags);
+  pStats.setCounter("symbols", m_pModule->getNamePool().size());
+  pStats.setCounter("output symbols", m_pModule->sym_size());
+  pStats.setCounter("relocations", num_relocs);
+}
+
 void ObjectLinker::normalSyncRelocationResult(FileOutputBuffer& pOutput) {
   uint8_t* data = pOutput.getBufferStart();
 
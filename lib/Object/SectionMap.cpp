@@ -11,6 +11,7 @@
 #include "mcld/Fragment/NullFragment.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/Object/SectionMatcher.h"
 #include "mcld/Script/Assignment.h"
 #include "mcld/Script/Operand.h"
 #include "mcld/Script/Operator.h"
@@ -155,7 +156,11 @@ SectionMap::Output::dot_iterator SectionMap::Output::find_last_explicit_dot() {
 //===----------------------------------------------------------------------===//
 // SectionMap
 //===----------------------------------------------------------------------===//
+SectionMap::SectionMap() : m_pMatcher(NULL) {
+}
+
 SectionMap::~SectionMap() {
+  delete m_pMatcher;
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
     if (*out != NULL) {
@@ -172,29 +177,12 @@ SectionMap::~SectionMap() {
 SectionMap::const_mapping SectionMap::find(
     const std::string& pInputFile,
     const std::string& pInputSection) const {
-  const_iterator out, outBegin = begin(), outEnd = end();
-  for (out = outBegin; out != outEnd; ++out) {
-    Output::const_iterator in, inBegin = (*out)->begin(), inEnd = (*out)->end();
-    for (in = inBegin; in != inEnd; ++in) {
-      if (matched(**in, pInputFile, pInputSection))
-        return std::make_pair(*out, *in);
-    }
-  }
-  return std::make_pair((const Output*)NULL, (const Input*)NULL);
+  return getMatcher().find(pInputFile, pInputSection);
 }
 
 SectionMap::mapping SectionMap::find(const std::string& pInputFile,
                                      const std::string& pInputSection) {
-  iterator out, outBegin = begin(), outEnd = end();
-  for (out = outBegin; out != outEnd; ++out) {
-    Output::iterator in, inBegin = (*out)->begin(), inEnd = (*out)->end();
-    for (in = inBegin; in != inEnd; ++in) {
-      if (matched(**in, pInputFile, pInputSection))
-        return std::make_pair(*out, *in);
-    }
-  }
-  return std::make_pair(reinterpret_cast<Output*>(NULL),
-                        reinterpret_cast<Input*>(NULL));
+  return getMatcher().find(pInputFile, pInputSection);
 }
 
 SectionMap::const_iterator SectionMap::find(
@@ -220,6 +208,7 @@ std::pair<SectionMap::mapping, bool> SectionMap::insert(
     const std::string& pInputSection,
     const std::string& pOutputSection,
     InputSectDesc::KeepPolicy pPolicy) {
+  resetMatcher();
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
     if ((*out)->name().compare(pOutputSection) == 0)
@@ -252,6 +241,7 @@ std::pair<SectionMap::mapping, bool> SectionMap::insert(
 std::pair<SectionMap::mapping, bool> SectionMap::insert(
     const InputSectDesc& pInputDesc,
     const OutputSectDesc& pOutputDesc) {
+  resetMatcher();
   iterator out, outBegin = begin(), outEnd = end();
   for (out = outBegin; out != outEnd; ++out) {
     if ((*out)->name().compare(pOutputDesc.name()) == 0 &&
@@ -287,42 +277,15 @@ std::pair<SectionMap::mapping, bool> SectionMap::insert(
 
 SectionMap::iterator SectionMap::insert(iterator pPosition,
                                         LDSection* pSection) {
+  resetMatcher();
   Output* output = new Output(pSection->name());
   output->append(new Input(pSection->name(), InputSectDesc::NoKeep));
   output->setSection(pSection);
   return m_OutputDescList.insert(pPosition, output);
 }
 
-bool SectionMap::matched(const SectionMap::Input& pInput,
-                         const std::string& pInputFile,
-                         const std::string& pInputSection) const {
-  if (pInput.spec().hasFile() && !matched(pInput.spec().file(), pInputFile))
-    return false;
-
-  if (pInput.spec().hasExcludeFiles()) {
-    StringList::const_iterator file, fileEnd;
-    fileEnd = pInput.spec().excludeFiles().end();
-    for (file = pInput.spec().excludeFiles().begin(); file != fileEnd; ++file) {
-      if (matched(llvm::cast<WildcardPattern>(**file), pInputFile)) {
-        return false;
-      }
-    }
-  }
-
-  if (pInput.spec().hasSections()) {
-    StringList::const_iterator sect, sectEnd = pInput.spec().sections().end();
-    for (sect = pInput.spec().sections().begin(); sect != sectEnd; ++sect) {
-      if (matched(llvm::cast<WildcardPattern>(**sect), pInputSection)) {
-        return true;
-      }
-    }
-  }
-
-  return false;
-}
-
 bool SectionMap::matched(const WildcardPattern& pPattern,
-                         const std::string& pName) const {
+                         const std::string& pName) {
   if (pPattern.isPrefix()) {
     llvm::StringRef name(pName);
     return name.startswith(pPattern.prefix());
@@ -331,8 +294,22 @@ bool SectionMap::matched(const WildcardPattern& pPattern,
   }
 }
 
+SectionMatcher& SectionMap::getMatcher() const {
+  if (m_pMatcher == NULL)
+    m_pMatcher = new SectionMatcher(*this);
+  return *m_pMatcher;
+}
+
+void SectionMap::resetMatcher() {
+  delete m_pMatcher;
+  m_pMatcher = NULL;
+}
+
 // fixupDotSymbols - ensure the dot symbols are valid
 void SectionMap::fixupDotSymbols() {
+  // the output sections may have been reordered
+  resetMatcher();
+
   for (iterator it = begin() + 1, ie = end(); it != ie; ++it) {
     // fixup the 1st explicit dot assignment if needed
     if (!(*it)->dotAssignments().empty()) {
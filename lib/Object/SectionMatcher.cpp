@@ -0,0 +1,197 @@
+//===- SectionMatcher.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Object/SectionMatcher.h"
+
+#include "mcld/Script/StringList.h"
+#include "mcld/Script/WildcardPattern.h"
+
+#include <llvm/Support/Casting.h>
+
+#include <cassert>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// SectionMatcher
+//===----------------------------------------------------------------------===//
+SectionMatcher::SectionMatcher(const SectionMap& pMap) {
+  // the root of the trie is the empty prefix
+  m_Prefixes.push_back(TrieNode());
+
+  SectionMap::const_iterator out, outEnd = pMap.end();
+  for (out = pMap.begin(); out != outEnd; ++out) {
+    SectionMap::Output::iterator in, inEnd = (*out)->end();
+    for (in = (*out)->begin(); in != inEnd; ++in) {
+      const InputSectDesc::Spec& spec = (*in)->spec();
+      if (!spec.hasSections())
+        continue;
+
+      Rule rule = {std::make_pair(*out, *in), AnyFile};
+      if (spec.hasFile() || spec.hasExcludeFiles()) {
+        FileCond cond = {spec.hasFile() ? &spec.file() : NULL,
+                         spec.hasExcludeFiles() ? &spec.excludeFiles() : NULL};
+        std::vector<FileCond>::iterator it, itEnd = m_FileConds.end();
+        for (it = m_FileConds.begin(); it != itEnd; ++it) {
+          if (it->File == cond.File && it->ExcludeFiles == cond.ExcludeFiles)
+            break;
+        }
+        rule.FileCond = it - m_FileConds.begin();
+        if (it == itEnd)
+          m_FileConds.push_back(cond);
+      }
+
+      uint32_t idx = m_Rules.size();
+      m_Rules.push_back(rule);
+      StringList::const_iterator sect, sectEnd = spec.sections().end();
+      for (sect = spec.sections().begin(); sect != sectEnd; ++sect)
+        addPattern(llvm::cast<WildcardPattern>(**sect), idx);
+    }
+  }
+}
+
+void SectionMatcher::addPattern(const WildcardPattern& pPattern,
+                                uint32_t pRule) {
+  // the empty pattern is a prefix pattern without the trailing `*', and its
+  // prefix is out of the name. SectionMap::matched never matches it.
+  if (pPattern.isPrefix() && pPattern.prefix().size() > pPattern.name().size())
+    return;
+
+  // SectionMap::matched compares the prefix of a prefix pattern literally
+  if (pPattern.isPrefix()) {
+    uint32_t node = 0;
+    llvm::StringRef prefix = pPattern.prefix();
+    for (size_t i = 0; i < prefix.size(); ++i) {
+      std::map<char, uint32_t>::iterator child =
+          m_Prefixes[node].Children.find(prefix[i]);
+      if (child == m_Prefixes[node].Children.end()) {
+        m_Prefixes[node].Children[prefix[i]] = m_Prefixes.size();
+        node = m_Prefixes.size();
+        m_Prefixes.push_back(TrieNode());
+      } else {
+        node = child->second;
+      }
+    }
+    m_Prefixes[node].Rules.push_back(pRule);
+    return;
+  }
+
+  if (pPattern.name().find_first_of("*?[\\") == std::string::npos)
+    m_ExactNames[pPattern.name()].push_back(pRule);
+  else
+    m_Globs.push_back(std::make_pair(&pPattern, pRule));
+}
+
+SectionMap::mapping SectionMatcher::find(const std::string& pInputFile,
+                                         const std::string& pInputSection) {
+  uint32_t file_class = getFileClass(pInputFile);
+  llvm::StringMap<uint32_t>& cache = m_Cache[file_class];
+  llvm::StringMap<uint32_t>::iterator entry = cache.find(pInputSection);
+  uint32_t rule;
+  if (entry != cache.end()) {
+    rule = entry->getValue();
+  } else {
+    rule = lookup(file_class, pInputSection);
+    cache[pInputSection] = rule;
+  }
+
+  if (rule == NoMatch)
+    return std::make_pair(static_cast<SectionMap::Output*>(NULL),
+                          static_cast<SectionMap::Input*>(NULL));
+  return m_Rules[rule].Mapping;
+}
+
+uint32_t SectionMatcher::getFileClass(const std::string& pInputFile) {
+  llvm::StringMap<uint32_t>::iterator entry = m_FileClassOf.find(pInputFile);
+  if (entry != m_FileClassOf.end())
+    return entry->getValue();
+
+  FileClass file_class(m_FileConds.size());
+  for (size_t i = 0; i < m_FileConds.size(); ++i) {
+    const FileCond& cond = m_FileConds[i];
+    bool matched = true;
+    if (cond.File != NULL && !SectionMap::matched(*cond.File, pInputFile))
+      matched = false;
+    if (matched && cond.ExcludeFiles != NULL) {
+      StringList::const_iterator file, fileEnd = cond.ExcludeFiles->end();
+      for (file = cond.ExcludeFiles->begin(); file != fileEnd; ++file) {
+        if (SectionMap::matched(llvm::cast<WildcardPattern>(**file),
+                                pInputFile)) {
+          matched = false;
+          break;
+        }
+      }
+    }
+    file_class[i] = matched;
+  }
+
+  std::map<FileClass, uint32_t>::iterator id =
+      m_FileClassIds.find(file_class);
+  if (id == m_FileClassIds.end()) {
+    id = m_FileClassIds.insert(
+        std::make_pair(file_class, m_FileClasses.size())).first;
+    m_FileClasses.push_back(file_class);
+    m_Cache.push_back(llvm::StringMap<uint32_t>());
+  }
+  m_FileClassOf[pInputFile] = id->second;
+  return id->second;
+}
+
+bool SectionMatcher::matchFile(uint32_t pRule, uint32_t pClass) const {
+  uint32_t cond = m_Rules[pRule].FileCond;
+  return cond == AnyFile || m_FileClasses[pClass][cond];
+}
+
+uint32_t SectionMatcher::lookup(uint32_t pClass,
+                                const std::string& pInputSection) const {
+  uint32_t result = NoMatch;
+
+  // the rules of a list are in order, so the first usable one is the best
+  llvm::StringMap<std::vector<uint32_t> >::const_iterator exact =
+      m_ExactNames.find(pInputSection);
+  if (exact != m_ExactNames.end()) {
+    std::vector<uint32_t>::const_iterator rule, ruleEnd = exact->second.end();
+    for (rule = exact->second.begin(); rule != ruleEnd; ++rule) {
+      if (*rule < result && matchFile(*rule, pClass)) {
+        result = *rule;
+        break;
+      }
+    }
+  }
+
+  // every prefix of the name on the path of the trie
+  uint32_t node = 0;
+  for (size_t i = 0; ; ++i) {
+    std::vector<uint32_t>::const_iterator rule,
+        ruleEnd = m_Prefixes[node].Rules.end();
+    for (rule = m_Prefixes[node].Rules.begin(); rule != ruleEnd; ++rule) {
+      if (*rule < result && matchFile(*rule, pClass)) {
+        result = *rule;
+        break;
+      }
+    }
+    if (i == pInputSection.size())
+      break;
+    std::map<char, uint32_t>::const_iterator child =
+        m_Prefixes[node].Children.find(pInputSection[i]);
+    if (child == m_Prefixes[node].Children.end())
+      break;
+    node = child->second;
+  }
+
+  std::vector<std::pair<const WildcardPattern*, uint32_t> >::const_iterator
+      glob, globEnd = m_Globs.end();
+  for (glob = m_Globs.begin(); glob != globEnd; ++glob) {
+    if (glob->second < result && matchFile(glob->second, pClass) &&
+        SectionMap::matched(*glob->first, pInputSection))
+      result = glob->second;
+  }
+  return result;
+}
+
+}  // namespace mcld
@@ -0,0 +1,166 @@
+//===- LinkerStats.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/LinkerStats.h"
+
+#include "mcld/Support/SystemUtils.h"
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cassert>
+#include <cstdio>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// LinkerStats::Timer
+//===----------------------------------------------------------------------===//
+LinkerStats::Timer::Timer(LinkerStats* pStats, const char* pName)
+    : m_pStats(pStats), m_Phase(0), m_CPUStart(0.0) {
+  if (m_pStats == NULL)
+    return;
+  m_Phase = m_pStats->beginPhase(pName);
+  m_WallStart = std::chrono::steady_clock::now();
+  m_CPUStart = sys::GetProcessCPUTime();
+}
+
+LinkerStats::Timer::~Timer() {
+  if (m_pStats == NULL)
+    return;
+  double wall = elapsed(m_WallStart);
+  double cpu = (sys::GetProcessCPUTime() - m_CPUStart) * 1000.0;
+  m_pStats->endPhase(m_Phase, wall, cpu);
+}
+
+//===----------------------------------------------------------------------===//
+// LinkerStats
+//===----------------------------------------------------------------------===//
+LinkerStats::LinkerStats(bool pTimeReport, bool pCounters, bool pJSON)
+    : m_Depth(0),
+      m_bTimeReport(pTimeReport),
+      m_bCounters(pCounters),
+      m_bJSON(pJSON) {
+}
+
+size_t LinkerStats::beginPhase(const std::string& pName) {
+  size_t index = 0;
+  while (index < m_Phases.size() && m_Phases[index].Name != pName)
+    ++index;
+  if (index == m_Phases.size()) {
+    Phase entry = {pName, m_Depth, 0.0, 0.0};
+    m_Phases.push_back(entry);
+  }
+  ++m_Depth;
+  return index;
+}
+
+void LinkerStats::endPhase(size_t pPhase, double pWall, double pCPU) {
+  assert(m_Depth > 0 && pPhase < m_Phases.size());
+  --m_Depth;
+  m_Phases[pPhase].Wall += pWall;
+  m_Phases[pPhase].CPU += pCPU;
+}
+
+double LinkerStats::elapsed(std::chrono::steady_clock::time_point pStart) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - pStart).count();
+}
+
+std::string LinkerStats::formatTime(double pMilliseconds) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.2f", pMilliseconds);
+  return buf;
+}
+
+void LinkerStats::setCounter(const std::string& pName, uint64_t pValue) {
+  CounterList::iterator counter, cEnd = m_Counters.end();
+  for (counter = m_Counters.begin(); counter != cEnd; ++counter) {
+    if (counter->Name == pName) {
+      counter->Value = pValue;
+      return;
+    }
+  }
+  Counter entry = {pName, pValue};
+  m_Counters.push_back(entry);
+}
+
+void LinkerStats::print(llvm::raw_ostream& pOS) const {
+  if (m_bJSON)
+    printJSON(pOS);
+  else
+    printText(pOS);
+  pOS.flush();
+}
+
+void LinkerStats::printText(llvm::raw_ostream& pOS) const {
+  if (m_bTimeReport) {
+    double total_wall = 0.0, total_cpu = 0.0;
+    pOS << "===- Time report -===\n";
+    pOS << "  phase                       wall (ms)     cpu (ms)\n";
+    PhaseList::const_iterator phase, pEnd = m_Phases.end();
+    for (phase = m_Phases.begin(); phase != pEnd; ++phase) {
+      // a nested phase is indented under its enclosing phase
+      std::string name = std::string(2 * phase->Depth, ' ') + phase->Name;
+      pOS << llvm::format("  %-24s %12.2f %12.2f\n", name.c_str(),
+                          phase->Wall, phase->CPU);
+      if (phase->Depth != 0)
+        continue;
+      total_wall += phase->Wall;
+      total_cpu += phase->CPU;
+    }
+    pOS << llvm::format("  total                    %12.2f %12.2f\n",
+                        total_wall, total_cpu);
+  }
+
+  uint64_t peak_rss = sys::GetPeakRSS();
+  if (peak_rss != 0)
+    pOS << llvm::format("  peak RSS                 %12.2f MiB\n",
+                        peak_rss / (1024.0 * 1024.0));
+
+  if (m_bCounters) {
+    pOS << "===- Statistics -===\n";
+    CounterList::const_iterator counter, cEnd = m_Counters.end();
+    for (counter = m_Counters.begin(); counter != cEnd; ++counter)
+      pOS << llvm::format("  %-24s %12llu\n", counter->Name.c_str(),
+                          static_cast<unsigned long long>(counter->Value));
+  }
+}
+
+void LinkerStats::printJSON(llvm::raw_ostream& pOS) const {
+  pOS << "{";
+  if (m_bTimeReport) {
+    pOS << "\"phases\": [";
+    PhaseList::const_iterator phase, pEnd = m_Phases.end();
+    for (phase = m_Phases.begin(); phase != pEnd; ++phase) {
+      if (phase != m_Phases.begin())
+        pOS << ", ";
+      pOS << "{\"name\": \"" << phase->Name << "\", "
+          << "\"depth\": " << phase->Depth << ", "
+          << llvm::format("\"wall_ms\": %.3f, \"cpu_ms\": %.3f}", phase->Wall,
+                          phase->CPU);
+    }
+    pOS << "], ";
+  }
+
+  pOS << "\"peak_rss\": " << sys::GetPeakRSS();
+
+  if (m_bCounters) {
+    pOS << ", \"counters\": {";
+    CounterList::const_iterator counter, cEnd = m_Counters.end();
+    for (counter = m_Counters.begin(); counter != cEnd; ++counter) {
+      if (counter != m_Counters.begin())
+        pOS << ", ";
+      pOS << "\"" << counter->Name << "\": " << counter->Value;
+    }
+    pOS << "}";
+  }
+  pOS << "}\n";
+}
+
+}  // namespace mcld
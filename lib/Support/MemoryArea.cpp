@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/SystemUtils.h"
 
 #include <llvm/Support/ErrorOr.h>
 
@@ -46,4 +47,12 @@ size_t MemoryArea::size() const {
   return m_pMemoryBuffer->getBufferSize();
 }
 
+void MemoryArea::release() {
+  // the contents read into the heap can not be read again
+  if (m_pMemoryBuffer->getBufferKind() != llvm::MemoryBuffer::MemoryBuffer_MMap)
+    return;
+  sys::ReleasePages(m_pMemoryBuffer->getBufferStart(),
+                    m_pMemoryBuffer->getBufferSize());
+}
+
 }  // namespace mcld
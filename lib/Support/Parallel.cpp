@@ -0,0 +1,58 @@
+//===- Parallel.cpp -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace mcld {
+namespace parallel {
+
+unsigned getHardwareConcurrency() {
+  unsigned num = std::thread::hardware_concurrency();
+  return (num == 0) ? 1 : num;
+}
+
+void forEachN(unsigned pNumThreads,
+              size_t pBegin,
+              size_t pEnd,
+              const std::function<void(size_t)>& pFunc) {
+  if (pBegin >= pEnd)
+    return;
+
+  size_t num_tasks = pEnd - pBegin;
+  unsigned num_threads = std::min<size_t>(pNumThreads, num_tasks);
+  if (num_threads < 2) {
+    for (size_t i = pBegin; i != pEnd; ++i)
+      pFunc(i);
+    return;
+  }
+
+  std::atomic<size_t> next(pBegin);
+  auto worker = [&next, pEnd, &pFunc]() {
+    for (size_t i = next++; i < pEnd; i = next++)
+      pFunc(i);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (unsigned i = 1; i < num_threads; ++i)
+    threads.push_back(std::thread(worker));
+
+  // the calling thread works as well instead of just waiting.
+  worker();
+
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+}  // namespace parallel
+}  // namespace mcld
@@ -217,6 +217,8 @@ void AArch64GNULDBackend::doPreLayout(IRBuilder& pBuilder) {
       assert(
           !config().isCodeStatic() &&
           "static linkage should not result in a dynamic relocation section");
+      if (config().options().packRelativeRelocs())
+        packRelativeRelocs(file_format->getRelaDyn());
       file_format->getRelaDyn().setSize(m_pRelaDyn->numOfRelocs() *
                                         getRelaEntrySize());
     }
@@ -286,6 +288,9 @@ uint64_t AArch64GNULDBackend::emitSectionData(const LDSection& pSection,
     return result;
   }
 
+  if (file_format->hasRelrDyn() && (&pSection == &(file_format->getRelrDyn())))
+    return emitRelrDyn(pRegion);
+
   return pRegion.size();
 }
 
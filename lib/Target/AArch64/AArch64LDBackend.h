@@ -64,6 +64,10 @@ class AArch64GNULDBackend : public GNULDBackend {
   /// Use co-variant return type to return its own dynamic section.
   const AArch64ELFDynamic& dynamic() const;
 
+  uint32_t getRelativeRelocType() const {
+    return llvm::ELF::R_AARCH64_RELATIVE;
+  }
+
   /// emitSectionData - write out the section data into the memory region.
   /// When writers get a LDSection whose kind is LDFileFormat::Target, writers
   /// call back target backend to emit the data.
@@ -661,8 +661,11 @@ Relocator::Result adr_got_page(Relocation& pReloc, AArch64Relocator& pParent) {
 
   // setup got entry value if needed
   AArch64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (got_entry != NULL && AArch64Relocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    std::lock_guard<std::mutex> lock(pParent.getApplyMutex());
+    if (got_entry != NULL && AArch64Relocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
   // setup relocation addend if needed
   Relocation* dyn_rela = pParent.getRelRelMap().lookUp(pReloc);
   if ((dyn_rela != NULL) && (AArch64Relocator::SymVal == dyn_rela->addend())) {
@@ -685,8 +688,11 @@ Relocator::Result ld64_got_lo12(Relocation& pReloc, AArch64Relocator& pParent) {
 
   // setup got entry value if needed
   AArch64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (got_entry != NULL && AArch64Relocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    std::lock_guard<std::mutex> lock(pParent.getApplyMutex());
+    if (got_entry != NULL && AArch64Relocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
 
   // setup relocation addend if needed
   Relocation* dyn_rela = pParent.getRelRelMap().lookUp(pReloc);
@@ -69,6 +69,10 @@ class AArch64Relocator : public Relocator {
 
   Result applyRelocation(Relocation& pRelocation);
 
+  /// isConcurrentApplySafe - GOT entries shared by inputs are filled under
+  /// getApplyMutex(), and there is no per-input state while applying.
+  bool isConcurrentApplySafe() const { return true; }
+
   AArch64GNULDBackend& getTarget() { return m_Target; }
 
   const AArch64GNULDBackend& getTarget() const { return m_Target; }
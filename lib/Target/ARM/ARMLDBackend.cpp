@@ -577,6 +577,11 @@ void ARMGNULDBackend::setUpReachedSectionsForGC(
         // 1. set up the reference according to relocations
         bool add_first = false;
         GarbageCollection::SectionListTy* reached_sects = NULL;
+        // create the relocations of the section from its pending records
+        if (!reloc_sect->getRelocData()->getTable().materialize()) {
+          fatal(diag::fatal_cannot_read_input) << (*input)->path();
+          continue;
+        }
         RelocData::iterator reloc_it, rEnd = reloc_sect->getRelocData()->end();
         for (reloc_it = reloc_sect->getRelocData()->begin(); reloc_it != rEnd;
              ++reloc_it) {
@@ -878,8 +878,11 @@ ARMRelocator::Result got_brel(Relocation& pReloc, ARMRelocator& pParent) {
 
   // setup got entry value if needed
   ARMGOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (got_entry != NULL && ARMRelocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    std::lock_guard<std::mutex> lock(pParent.getApplyMutex());
+    if (got_entry != NULL && ARMRelocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
   return Relocator::OK;
 }
 
@@ -897,8 +900,11 @@ ARMRelocator::Result got_prel(Relocation& pReloc, ARMRelocator& pParent) {
 
   // setup got entry value if needed
   ARMGOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (got_entry != NULL && ARMRelocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    std::lock_guard<std::mutex> lock(pParent.getApplyMutex());
+    if (got_entry != NULL && ARMRelocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
   return Relocator::OK;
 }
 
@@ -63,6 +63,10 @@ class ARMRelocator : public Relocator {
 
   Result applyRelocation(Relocation& pRelocation);
 
+  /// isConcurrentApplySafe - GOT entries shared by inputs are filled under
+  /// getApplyMutex(), and there is no per-input state while applying.
+  bool isConcurrentApplySafe() const { return true; }
+
   ARMGNULDBackend& getTarget() { return m_Target; }
 
   const ARMGNULDBackend& getTarget() const { return m_Target; }
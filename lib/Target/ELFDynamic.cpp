@@ -145,12 +145,22 @@ void ELFDynamic::reserveEntries(const ELFFileFormat& pFormat) {
     reserveOne(llvm::ELF::DT_REL);
     reserveOne(llvm::ELF::DT_RELSZ);
     reserveOne(llvm::ELF::DT_RELENT);
+    if (numOfRelativeRelocs(pFormat.getRelDyn()) != 0)
+      reserveOne(llvm::ELF::DT_RELCOUNT);
   }
 
   if (pFormat.hasRelaDyn()) {
     reserveOne(llvm::ELF::DT_RELA);
     reserveOne(llvm::ELF::DT_RELASZ);
     reserveOne(llvm::ELF::DT_RELAENT);
+    if (numOfRelativeRelocs(pFormat.getRelaDyn()) != 0)
+      reserveOne(llvm::ELF::DT_RELACOUNT);
+  }
+
+  if (pFormat.hasRelrDyn()) {
+    reserveOne(DT_RELR);
+    reserveOne(DT_RELRSZ);
+    reserveOne(DT_RELRENT);
   }
 
   uint64_t dt_flags = 0x0;
@@ -249,12 +259,24 @@ void ELFDynamic::applyEntries(const ELFFileFormat& pFormat) {
     applyOne(llvm::ELF::DT_REL, pFormat.getRelDyn().addr());
     applyOne(llvm::ELF::DT_RELSZ, pFormat.getRelDyn().size());
     applyOne(llvm::ELF::DT_RELENT, m_pEntryFactory->relSize());
+    size_t count = numOfRelativeRelocs(pFormat.getRelDyn());
+    if (count != 0)
+      applyOne(llvm::ELF::DT_RELCOUNT, count);
   }
 
   if (pFormat.hasRelaDyn()) {
     applyOne(llvm::ELF::DT_RELA, pFormat.getRelaDyn().addr());
     applyOne(llvm::ELF::DT_RELASZ, pFormat.getRelaDyn().size());
     applyOne(llvm::ELF::DT_RELAENT, m_pEntryFactory->relaSize());
+    size_t count = numOfRelativeRelocs(pFormat.getRelaDyn());
+    if (count != 0)
+      applyOne(llvm::ELF::DT_RELACOUNT, count);
+  }
+
+  if (pFormat.hasRelrDyn()) {
+    applyOne(DT_RELR, pFormat.getRelrDyn().addr());
+    applyOne(DT_RELRSZ, pFormat.getRelrDyn().size());
+    applyOne(DT_RELRENT, m_Config.targets().bitclass() / 8);
   }
 
   if (m_Backend.hasTextRel()) {
@@ -314,6 +336,15 @@ void ELFDynamic::applyEntries(const ELFFileFormat& pFormat) {
   }
 }
 
+/// numOfRelativeRelocs - the number of relative relocations leading
+/// pSection. The relative relocations are sorted to the front only with
+/// -z combreloc.
+size_t ELFDynamic::numOfRelativeRelocs(const LDSection& pSection) const {
+  if (!m_Config.options().hasCombReloc())
+    return 0;
+  return m_Backend.numOfRelativeRelocs(pSection);
+}
+
 /// symbolSize
 size_t ELFDynamic::symbolSize() const {
   return m_pEntryFactory->symbolSize();
@@ -15,7 +15,9 @@
 #include "mcld/Module.h"
 #include "mcld/ADT/SizeTraits.h"
 #include "mcld/Config/Config.h"
+#include "mcld/Fragment/AlignFragment.h"
 #include "mcld/Fragment/FillFragment.h"
+#include "mcld/Fragment/Relocation.h"
 #include "mcld/LD/BranchIslandFactory.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/EhFrameHdr.h"
@@ -37,12 +39,18 @@
 #include "mcld/Script/OutputSectDesc.h"
 #include "mcld/Script/RpnEvaluator.h"
 #include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/LinkerStats.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/Parallel.h"
 #include "mcld/Target/ELFAttribute.h"
 #include "mcld/Target/ELFDynamic.h"
 #include "mcld/Target/GNUInfo.h"
 
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Casting.h>
 #include <llvm/Support/Host.h>
 
 #include <algorithm>
@@ -69,6 +77,9 @@ static bool isCIdentifier(const std::string& pName) {
           std::string::npos);
 }
 
+/// the number of symbols emitted by one task
+const size_t SymbolBlockSize = 4096;
+
 }  // anonymous namespace
 
 namespace mcld {
@@ -742,12 +753,9 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
       break;
     }
     default: {
-      symEnd = symbols.end();
-      for (symbol = symbols.begin(); symbol != symEnd; ++symbol) {
-        ++symtab;
-        if (hasEntryInStrTab(**symbol))
-          strtab += (*symbol)->nameSize() + 1;
-      }
+      std::vector<size_t> name_offsets;
+      symtab += symbols.end() - symbols.begin();
+      strtab += getNameOffsets(symbols.begin(), symbols.end(), name_offsets);
       symtab_local_cnt = 1 + symbols.numOfFiles() + symbols.numOfLocals() +
                          symbols.numOfLocalDyns();
       break;
@@ -766,12 +774,10 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
     case LinkerConfig::Binary: {
       if (!config().isCodeStatic()) {
         /// Compute the size of .dynsym, .dynstr, and dynsym_local_cnt
-        symEnd = symbols.dynamicEnd();
-        for (symbol = symbols.localDynBegin(); symbol != symEnd; ++symbol) {
-          ++dynsym;
-          if (hasEntryInStrTab(**symbol))
-            dynstr += (*symbol)->nameSize() + 1;
-        }
+        std::vector<size_t> name_offsets;
+        dynsym += symbols.dynamicEnd() - symbols.localDynBegin();
+        dynstr += getNameOffsets(
+            symbols.localDynBegin(), symbols.dynamicEnd(), name_offsets);
         dynsym_local_cnt = 1 + symbols.numOfLocalDyns();
 
         // compute .gnu.hash
@@ -787,7 +793,7 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
           if (hashed_sym_cnt == 0)
             gnuhash = 5 * 4 + config().targets().bitclass() / 8;
           else {
-            size_t nbucket = getHashBucketCount(hashed_sym_cnt, true);
+            size_t nbucket = getGNUHashBucketCount(hashed_sym_cnt);
             gnuhash = (4 + nbucket + hashed_sym_cnt) * 4;
             gnuhash += (1U << getGNUHashMaskbitslog2(hashed_sym_cnt)) / 8;
           }
@@ -865,6 +871,73 @@ void GNULDBackend::sizeNamePools(Module& pModule) {
   }  // end of switch
 }
 
+/// getNameOffsets - compute the string table offsets of the symbol names
+size_t GNULDBackend::getNameOffsets(Module::const_sym_iterator pBegin,
+                                    Module::const_sym_iterator pEnd,
+                                    std::vector<size_t>& pOffsets) const {
+  size_t num_blocks = (pEnd - pBegin + SymbolBlockSize - 1) / SymbolBlockSize;
+  pOffsets.assign(num_blocks + 1, 0);
+
+  // sum up the names of each block
+  parallel::forEachN(config().options().numThreads(), 0, num_blocks,
+                     [this, pBegin, pEnd, &pOffsets](size_t pBlock) {
+    Module::const_sym_iterator symbol = pBegin + pBlock * SymbolBlockSize;
+    Module::const_sym_iterator end = pEnd;
+    if (static_cast<size_t>(pEnd - symbol) > SymbolBlockSize)
+      end = symbol + SymbolBlockSize;
+    size_t size = 0;
+    for (; symbol != end; ++symbol) {
+      if (hasEntryInStrTab(**symbol))
+        size += (*symbol)->nameSize() + 1;
+    }
+    pOffsets[pBlock + 1] = size;
+  });
+
+  // the prefix sum gives the offset of each block
+  for (size_t i = 1; i <= num_blocks; ++i)
+    pOffsets[i] += pOffsets[i - 1];
+  return pOffsets[num_blocks];
+}
+
+/// emitSymbols - emit the symbols and their names in parallel
+size_t GNULDBackend::emitSymbols(Module::const_sym_iterator pBegin,
+                                 Module::const_sym_iterator pEnd,
+                                 MemoryRegion& pSymtab,
+                                 char* pStrtab) {
+  // the first pass finds where the names of each block start, and the
+  // second pass writes the blocks, which do not overlap
+  std::vector<size_t> name_offsets;
+  size_t strtabsize = 1 + getNameOffsets(pBegin, pEnd, name_offsets);
+  size_t num_blocks = name_offsets.size() - 1;
+  bool is_32bits = config().targets().is32Bits();
+
+  parallel::forEachN(config().options().numThreads(), 0, num_blocks,
+                     [this, pBegin, pEnd, &pSymtab, pStrtab, &name_offsets,
+                      is_32bits](size_t pBlock) {
+    size_t symIdx = 1 + pBlock * SymbolBlockSize;
+    size_t stroffset = 1 + name_offsets[pBlock];
+    Module::const_sym_iterator symbol = pBegin + pBlock * SymbolBlockSize;
+    Module::const_sym_iterator end = pEnd;
+    if (static_cast<size_t>(pEnd - symbol) > SymbolBlockSize)
+      end = symbol + SymbolBlockSize;
+    for (; symbol != end; ++symbol) {
+      if (is_32bits) {
+        llvm::ELF::Elf32_Sym* symtab32 =
+            reinterpret_cast<llvm::ELF::Elf32_Sym*>(pSymtab.begin());
+        emitSymbol32(symtab32[symIdx], **symbol, pStrtab, stroffset, symIdx);
+      } else {
+        llvm::ELF::Elf64_Sym* symtab64 =
+            reinterpret_cast<llvm::ELF::Elf64_Sym*>(pSymtab.begin());
+        emitSymbol64(symtab64[symIdx], **symbol, pStrtab, stroffset, symIdx);
+      }
+      ++symIdx;
+      if (hasEntryInStrTab(**symbol))
+        stroffset += (*symbol)->nameSize() + 1;
+    }
+  });
+  return strtabsize;
+}
+
 /// emitSymbol32 - emit an ELF32 symbol
 void GNULDBackend::emitSymbol32(llvm::ELF::Elf32_Sym& pSym,
                                 LDSymbol& pSymbol,
@@ -953,25 +1026,17 @@ void GNULDBackend::emitRegNamePools(const Module& pModule,
     entry->setValue(0);
   }
 
-  size_t symIdx = 1;
-  size_t strtabsize = 1;
-
   const Module::SymbolTable& symbols = pModule.getSymbolTable();
-  Module::const_sym_iterator symbol, symEnd;
+  emitSymbols(symbols.begin(), symbols.end(), symtab_region, strtab);
 
-  symEnd = symbols.end();
-  for (symbol = symbols.begin(); symbol != symEnd; ++symbol) {
-    if (LinkerConfig::Object == config().codeGenType()) {
+  // the symbol indices of the relocatable output
+  if (LinkerConfig::Object == config().codeGenType()) {
+    size_t symIdx = 1;
+    Module::const_sym_iterator symbol, symEnd = symbols.end();
+    for (symbol = symbols.begin(); symbol != symEnd; ++symbol) {
       entry = m_pSymIndexMap->insert(*symbol, sym_exist);
-      entry->setValue(symIdx);
+      entry->setValue(symIdx++);
     }
-    if (config().targets().is32Bits())
-      emitSymbol32(symtab32[symIdx], **symbol, strtab, strtabsize, symIdx);
-    else
-      emitSymbol64(symtab64[symIdx], **symbol, strtab, strtabsize, symIdx);
-    ++symIdx;
-    if (hasEntryInStrTab(**symbol))
-      strtabsize += (*symbol)->nameSize() + 1;
   }
 }
 
@@ -1032,19 +1097,15 @@ void GNULDBackend::emitDynNamePools(Module& pModule,
     emitELFHashTab(symbols, pOutput);
 
   // emit .dynsym, and .dynstr (emit LocalDyn and Dynamic category)
+  strtabsize = emitSymbols(
+      symbols.localDynBegin(), symbols.dynamicEnd(), symtab_region, strtab);
+
+  // maintain output's symbol and index map
   Module::const_sym_iterator symbol, symEnd = symbols.dynamicEnd();
   for (symbol = symbols.localDynBegin(); symbol != symEnd; ++symbol) {
-    if (config().targets().is32Bits())
-      emitSymbol32(symtab32[symIdx], **symbol, strtab, strtabsize, symIdx);
-    else
-      emitSymbol64(symtab64[symIdx], **symbol, strtab, strtabsize, symIdx);
-    // maintain output's symbol and index map
     entry = m_pSymIndexMap->insert(*symbol, sym_exist);
     entry->setValue(symIdx);
-    // sum up counters
     ++symIdx;
-    if (hasEntryInStrTab(**symbol))
-      strtabsize += (*symbol)->nameSize() + 1;
   }
 
   // emit DT_NEED
@@ -1192,7 +1253,7 @@ void GNULDBackend::emitGNUHashTab(Module::SymbolTable& pSymtab,
   uint32_t shift1 = config().targets().is32Bits() ? 5 : 6;
   uint32_t mask = (1u << shift1) - 1;
 
-  nbucket = getHashBucketCount(hashed_sym_cnt, true);
+  nbucket = getGNUHashBucketCount(hashed_sym_cnt);
   symidx = 1 + unhashed_sym_cnt;
   maskwords = 1 << (maskbitslog2 - shift1);
   shift2 = maskbitslog2;
@@ -1201,48 +1262,47 @@ void GNULDBackend::emitGNUHashTab(Module::SymbolTable& pSymtab,
   bucket = reinterpret_cast<uint32_t*>(bitmask + maskbits / 8);
   chain = (bucket + nbucket);
 
-  // build the gnu style hash table
-  typedef std::multimap<uint32_t, std::pair<LDSymbol*, uint32_t> > SymMapType;
-  SymMapType symmap;
-  symEnd = pSymtab.dynamicEnd();
-  for (symbol = pSymtab.localDynBegin() + symidx - 1; symbol != symEnd;
-       ++symbol) {
+  // hash the symbols, and count the symbols of each bucket
+  Module::sym_iterator hashed_begin = pSymtab.localDynBegin() + symidx - 1;
+  std::vector<uint32_t> hashes(hashed_sym_cnt);
+  parallel::forEachN(config().options().numThreads(), 0, hashed_sym_cnt,
+                     [hashed_begin, &hashes](size_t pIdx) {
     hash::StringHash<hash::DJB> hasher;
-    uint32_t djbhash = hasher((*symbol)->name());
-    uint32_t hash = djbhash % nbucket;
-    symmap.insert(std::make_pair(hash, std::make_pair(*symbol, djbhash)));
-  }
+    hashes[pIdx] = hasher((*(hashed_begin + pIdx))->name());
+  });
 
-  // compute bucket, chain, and bitmask
-  std::vector<uint64_t> bitmasks(maskwords);
-  size_t hashedidx = symidx;
+  std::vector<uint32_t> starts(nbucket + 1, 0);
+  for (size_t idx = 0; idx < hashed_sym_cnt; ++idx)
+    ++starts[hashes[idx] % nbucket + 1];
   for (size_t idx = 0; idx < nbucket; ++idx) {
-    size_t count = 0;
-    std::pair<SymMapType::iterator, SymMapType::iterator> ret;
-    ret = symmap.equal_range(idx);
-    for (SymMapType::iterator it = ret.first; it != ret.second;) {
-      // rearrange the hashed symbol ordering
-      *(pSymtab.localDynBegin() + hashedidx - 1) = it->second.first;
-      uint32_t djbhash = it->second.second;
-      uint32_t val = ((djbhash >> shift1) & ((maskbits >> shift1) - 1));
-      bitmasks[val] |= 1u << (djbhash & mask);
-      bitmasks[val] |= 1u << ((djbhash >> shift2) & mask);
-      val = djbhash & ~1u;
-      // advance the iterator and check if we're dealing w/ the last elment
-      if (++it == ret.second) {
-        // last element terminates the chain
-        val |= 1;
-      }
-      chain[hashedidx - symidx] = val;
+    bucket[idx] = (starts[idx + 1] == 0) ? 0 : symidx + starts[idx];
+    starts[idx + 1] += starts[idx];
+  }
 
-      ++hashedidx;
-      ++count;
-    }
+  // place the symbols bucket by bucket. The sort is stable, so the symbols
+  // of a bucket keep their order.
+  std::vector<LDSymbol*> sorted(hashed_sym_cnt);
+  std::vector<uint32_t> sorted_hashes(hashed_sym_cnt);
+  for (size_t idx = 0; idx < hashed_sym_cnt; ++idx) {
+    uint32_t pos = starts[hashes[idx] % nbucket]++;
+    sorted[pos] = *(hashed_begin + idx);
+    sorted_hashes[pos] = hashes[idx];
+  }
+  std::copy(sorted.begin(), sorted.end(), hashed_begin);
 
-    if (count == 0)
-      bucket[idx] = 0;
-    else
-      bucket[idx] = hashedidx - count;
+  // compute chain and bitmask
+  std::vector<uint64_t> bitmasks(maskwords);
+  for (size_t idx = 0; idx < hashed_sym_cnt; ++idx) {
+    uint32_t djbhash = sorted_hashes[idx];
+    uint32_t val = ((djbhash >> shift1) & ((maskbits >> shift1) - 1));
+    bitmasks[val] |= uint64_t(1) << (djbhash & mask);
+    bitmasks[val] |= uint64_t(1) << ((djbhash >> shift2) & mask);
+    val = djbhash & ~1u;
+    // the last symbol of a bucket terminates the chain
+    if (idx + 1 == hashed_sym_cnt ||
+        sorted_hashes[idx + 1] % nbucket != djbhash % nbucket)
+      val |= 1;
+    chain[idx] = val;
   }
 
   // write the bitmasks
@@ -1374,6 +1434,8 @@ unsigned int GNULDBackend::getSectionOrder(const LDSection& pSectHdr) const {
 
     // get the order from target for target specific sections
     case LDFileFormat::Target:
+      if (file_format->hasRelrDyn() && &pSectHdr == &file_format->getRelrDyn())
+        return SHO_RELOCATION;
       return getTargetSectionOrder(pSectHdr);
 
     // handle .interp and .note.* sections
@@ -1609,6 +1671,10 @@ bool GNULDBackend::updateSectionFlags(LDSection& pTo, const LDSection& pFrom) {
   if (0 == (pFrom.flag() & llvm::ELF::SHF_STRINGS))
     flags &= ~llvm::ELF::SHF_STRINGS;
 
+  // the entries of a mergeable output section must have the same size
+  if (pTo.entSize() != pFrom.entSize())
+    flags &= ~(llvm::ELF::SHF_MERGE | llvm::ELF::SHF_STRINGS);
+
   pTo.setFlag(flags);
   return true;
 }
@@ -2447,7 +2513,7 @@ void GNULDBackend::layout(Module& pModule) {
 
   // 2. update output sections in Module
   SectionMap& sectionMap = pModule.getScript().sectionMap();
-  pModule.getSectionTable().clear();
+  pModule.clearSections();
   for (SectionMap::iterator out = sectionMap.begin(), outEnd = sectionMap.end();
        out != outEnd;
        ++out) {
@@ -2456,7 +2522,7 @@ void GNULDBackend::layout(Module& pModule) {
         (*out)->getSection()->kind() == LDFileFormat::StackNote ||
         config().codeGenType() == LinkerConfig::Object) {
       (*out)->getSection()->setIndex(pModule.size());
-      pModule.getSectionTable().push_back((*out)->getSection());
+      pModule.appendSection(*(*out)->getSection());
     }
   }  // for each output section description
 
@@ -2525,7 +2591,7 @@ void GNULDBackend::preLayout(Module& pModule, IRBuilder& pBuilder) {
               (*rs)->name(), (*rs)->kind(), (*rs)->type(), (*rs)->flag());
 
           output_sect->setAlign((*rs)->align());
-          pModule.getSectionTable().push_back(output_sect);
+          pModule.appendSection(*output_sect);
         }
 
         // set output relocation section link
@@ -2573,6 +2639,16 @@ void GNULDBackend::postLayout(Module& pModule, IRBuilder& pBuilder) {
   if (LinkerConfig::Object != config().codeGenType()) {
     // do relaxation
     relax(pModule, pBuilder);
+    // Encode the packed relative relocations at their final places. The
+    // encoding shrinks .relr.dyn and moves the sections after it, so lay them
+    // out again until the size of .relr.dyn settles.
+    if (!m_RelrRelocs.empty()) {
+      bool may_shrink = true;
+      while (encodeRelrDyn(may_shrink)) {
+        setOutputSectionAddress(pModule);
+        may_shrink = false;
+      }
+    }
     // set up the attributes of program headers
     setupProgramHdrs(pModule.getScript());
   }
@@ -2586,6 +2662,11 @@ void GNULDBackend::postProcessing(FileOutputBuffer& pOutput) {
     // emit eh_frame_hdr
     m_pEhFrameHdr->emitOutput<32>(pOutput);
   }
+
+  // the addends of the packed relative relocations should be written after
+  // syncing the relocation results, which may write the same places.
+  if (!m_RelrRelocs.empty())
+    applyRelrAddends(pOutput);
 }
 
 /// getHashBucketCount - calculate hash bucket count.
@@ -2593,7 +2674,8 @@ unsigned GNULDBackend::getHashBucketCount(unsigned pNumOfSymbols,
                                           bool pIsGNUStyle) {
   static const unsigned int buckets[] = {
       1, 3, 17, 37, 67, 97, 131, 197, 263, 521, 1031, 2053, 4099, 8209, 16411,
-      32771, 65537, 131101, 262147
+      32771, 65537, 131101, 262147, 524309, 1048583, 2097169, 4194319,
+      8388617, 16777259
   };
   const unsigned buckets_count = sizeof buckets / sizeof buckets[0];
 
@@ -2610,6 +2692,16 @@ unsigned GNULDBackend::getHashBucketCount(unsigned pNumOfSymbols,
   return result;
 }
 
+/// getGNUHashBucketCount - calculate the bucket count of .gnu.hash
+unsigned GNULDBackend::getGNUHashBucketCount(unsigned pNumOfSymbols) const {
+  unsigned load_factor = config().options().getGNUHashLoadFactor();
+  if (load_factor == 0)
+    return getHashBucketCount(pNumOfSymbols, true);
+
+  unsigned result = (pNumOfSymbols + load_factor - 1) / load_factor;
+  return (result < 1) ? 1 : result;
+}
+
 /// getGNUHashMaskbitslog2 - calculate the number of mask bits in log2
 unsigned GNULDBackend::getGNUHashMaskbitslog2(unsigned pNumOfSymbols) const {
   uint32_t maskbitslog2 = 1;
@@ -2882,6 +2974,191 @@ void GNULDBackend::sortRelocation(LDSection& pSection) {
   }
 }
 
+bool GNULDBackend::isRelativeReloc(const Relocation& pReloc) const {
+  uint32_t type = getRelativeRelocType();
+  return (type != 0x0) && (pReloc.type() == type);
+}
+
+/// numOfRelativeRelocs - the number of relative relocations in the dynamic
+/// relocation section pSection
+size_t GNULDBackend::numOfRelativeRelocs(const LDSection& pSection) const {
+  if (!pSection.hasRelocData())
+    return 0;
+  size_t count = 0;
+  RelocData::const_iterator reloc, rEnd = pSection.getRelocData()->end();
+  for (reloc = pSection.getRelocData()->begin(); reloc != rEnd; ++reloc) {
+    if (isRelativeReloc(*reloc))
+      ++count;
+  }
+  return count;
+}
+
+/// packRelativeRelocs - move the relative relocations of pRelDyn to .relr.dyn
+void GNULDBackend::packRelativeRelocs(LDSection& pRelDyn) {
+  ELFFileFormat* file_format = getOutputFormat();
+  if (!pRelDyn.hasRelocData() || getRelativeRelocType() == 0x0)
+    return;
+
+  // A place can be packed only if it stays word-aligned whatever the layout
+  // is, that is, the fragments between it and the nearest boundary aligned to
+  // a word (an alignment fragment or the start of its section) have a known
+  // size which is a multiple of a word. The fragments of each section are
+  // visited once.
+  const unsigned word_size = config().targets().bitclass() / 8;
+  llvm::DenseSet<const SectionData*> visited;
+  llvm::DenseMap<const Fragment*, bool> aligned;
+
+  RelocData* reloc_data = pRelDyn.getRelocData();
+  RelocData::iterator reloc = reloc_data->begin();
+  while (reloc != reloc_data->end()) {
+    Relocation& relocation = *reloc++;
+    if (!isRelativeReloc(relocation))
+      continue;
+    const FragmentRef& place = relocation.targetRef();
+    if (place.frag() == NULL || (place.offset() % word_size) != 0)
+      continue;
+
+    const SectionData* data = place.frag()->getParent();
+    if (visited.insert(data).second) {
+      bool known = data->getSection().align() >= word_size;
+      uint64_t offset = 0;
+      SectionData::const_iterator frag, fragEnd = data->end();
+      for (frag = data->begin(); frag != fragEnd; ++frag) {
+        if (const AlignFragment* align = llvm::dyn_cast<AlignFragment>(&*frag)) {
+          known = align->getAlignment() >= word_size;
+          offset = 0;
+          continue;
+        }
+        aligned[&*frag] = known && (offset % word_size) == 0;
+        offset += frag->size();
+      }
+    }
+    if (!aligned.lookup(place.frag()))
+      continue;
+
+    reloc_data->remove(relocation);
+    m_RelrRelocs.push_back(&relocation);
+  }
+
+  // Every place takes at most one word. The encoded size is known only after
+  // layout, and postLayout shrinks the section to it.
+  if (!m_RelrRelocs.empty()) {
+    file_format->getRelrDyn().setSize(m_RelrRelocs.size() * word_size);
+    file_format->getRelrDyn().setAlign(word_size);
+  }
+}
+
+/// encodeRelrDyn - encode the places of the packed relative relocations
+///
+/// An even entry is the address of a place, and the next place is the word
+/// after it. An odd entry is a bitmap of the next (bits - 1) words, where the
+/// bit i + 1 is set if the word i is a place. The next place of a bitmap is
+/// the word after the words it covers.
+bool GNULDBackend::encodeRelrDyn(bool pMayShrink) {
+  const uint64_t word_size = config().targets().bitclass() / 8;
+  const uint64_t num_bits = word_size * 8 - 1;
+
+  std::vector<uint64_t> places;
+  places.reserve(m_RelrRelocs.size());
+  std::vector<Relocation*>::const_iterator reloc, rEnd = m_RelrRelocs.end();
+  for (reloc = m_RelrRelocs.begin(); reloc != rEnd; ++reloc) {
+    assert(((*reloc)->place() % word_size) == 0 && "unaligned RELR place");
+    places.push_back((*reloc)->place());
+  }
+  std::sort(places.begin(), places.end());
+  places.erase(std::unique(places.begin(), places.end()), places.end());
+
+  m_RelrEntries.clear();
+  size_t i = 0, size = places.size();
+  while (i < size) {
+    m_RelrEntries.push_back(places[i]);
+    uint64_t base = places[i] + word_size;
+    ++i;
+    while (true) {
+      uint64_t bitmap = 0;
+      for (; i < size; ++i) {
+        uint64_t delta = places[i] - base;
+        if (delta >= num_bits * word_size)
+          break;
+        bitmap |= UINT64_C(1) << (delta / word_size);
+      }
+      if (bitmap == 0)
+        break;
+      m_RelrEntries.push_back((bitmap << 1) | 0x1);
+      base += num_bits * word_size;
+    }
+  }
+
+  LDSection& relr_dyn = getOutputFormat()->getRelrDyn();
+  uint64_t relr_size = m_RelrEntries.size() * word_size;
+  if (!pMayShrink && relr_size < relr_dyn.size()) {
+    // pad with empty bitmaps, so that the size cannot oscillate
+    m_RelrEntries.resize(relr_dyn.size() / word_size, 0x1);
+    relr_size = relr_dyn.size();
+  }
+  if (relr_size == relr_dyn.size())
+    return false;
+  relr_dyn.setSize(relr_size);
+  return true;
+}
+
+/// emitRelrDyn - emit the encoded .relr.dyn
+uint64_t GNULDBackend::emitRelrDyn(MemoryRegion& pRegion) const {
+  uint8_t* buffer = pRegion.begin();
+  std::vector<uint64_t>::const_iterator entry, eEnd = m_RelrEntries.end();
+  if (config().targets().is32Bits()) {
+    for (entry = m_RelrEntries.begin(); entry != eEnd; ++entry) {
+      uint32_t word = *entry;
+      memcpy(buffer, &word, sizeof(word));
+      buffer += sizeof(word);
+    }
+  } else {
+    for (entry = m_RelrEntries.begin(); entry != eEnd; ++entry) {
+      memcpy(buffer, &*entry, sizeof(*entry));
+      buffer += sizeof(*entry);
+    }
+  }
+  return buffer - pRegion.begin();
+}
+
+/// applyRelrAddends - write the addends of the packed relative relocations
+void GNULDBackend::applyRelrAddends(FileOutputBuffer& pOutput) const {
+  const size_t word_size = config().targets().bitclass() / 8;
+  std::vector<Relocation*>::const_iterator reloc, rEnd = m_RelrRelocs.end();
+  for (reloc = m_RelrRelocs.begin(); reloc != rEnd; ++reloc) {
+    const FragmentRef& place = (*reloc)->targetRef();
+    const LDSection& section = place.frag()->getParent()->getSection();
+    if (section.type() == llvm::ELF::SHT_NOBITS)
+      continue;
+    MemoryRegion region =
+        pOutput.request(section.offset() + place.getOutputOffset(), word_size);
+    if (word_size == 4) {
+      uint32_t addend = (*reloc)->addend();
+      memcpy(region.begin(), &addend, sizeof(addend));
+    } else {
+      uint64_t addend = (*reloc)->addend();
+      memcpy(region.begin(), &addend, sizeof(addend));
+    }
+  }
+}
+
+void GNULDBackend::getSectionsChangedByApply(
+    std::vector<LDSection*>& pSections) {
+  ELFFileFormat* file_format = getOutputFormat();
+  if (file_format->hasGOT())
+    pSections.push_back(&file_format->getGOT());
+  if (file_format->hasGOTPLT())
+    pSections.push_back(&file_format->getGOTPLT());
+  if (file_format->hasRelDyn())
+    pSections.push_back(&file_format->getRelDyn());
+  if (file_format->hasRelaDyn())
+    pSections.push_back(&file_format->getRelaDyn());
+  if (file_format->hasRelPlt())
+    pSections.push_back(&file_format->getRelPlt());
+  if (file_format->hasRelaPlt())
+    pSections.push_back(&file_format->getRelaPlt());
+}
+
 unsigned GNULDBackend::stubGroupSize() const {
   const unsigned group_size = config().targets().getStubGroupSize();
   if (group_size == 0) {
@@ -2913,15 +3190,29 @@ bool GNULDBackend::relax(Module& pModule, IRBuilder& pBuilder) {
   if (!mayRelax())
     return true;
 
+  LinkerStats::Timer timer(stats(), "relax");
   getBRIslandFactory()->group(pModule);
 
+  unsigned passes = 0;
   bool finished = true;
   do {
+    // --time-report shows each pass under relax
+    std::string pass_name = "relax.pass." + llvm::utostr(passes + 1);
+    LinkerStats::Timer pass_timer(stats(), pass_name.c_str());
     if (doRelax(pModule, pBuilder, finished)) {
       setOutputSectionAddress(pModule);
     }
+    ++passes;
   } while (!finished);
 
+  // --stats shows the work of the passes
+  if (stats() != NULL) {
+    const StubFactory& stubs = *getStubFactory();
+    stats()->setCounter("relaxation passes", passes);
+    stats()->setCounter("branches examined", stubs.numOfExamined());
+    stats()->setCounter("branches skipped", stubs.numOfSkipped());
+    stats()->setCounter("stubs", stubs.numOfStubs());
+  }
   return true;
 }
 
@@ -2939,14 +3230,20 @@ bool GNULDBackend::DynsymCompare::operator()(const LDSymbol* X,
 
 bool GNULDBackend::RelocCompare::operator()(const Relocation& X,
                                             const Relocation& Y) const {
-  // 1. compare if relocation is relative
+  // 1. the relative relocations come first for DT_RELCOUNT and DT_RELACOUNT
+  bool relativeX = m_Backend.isRelativeReloc(X);
+  bool relativeY = m_Backend.isRelativeReloc(Y);
+  if (relativeX != relativeY)
+    return relativeX;
+
+  // 2. compare if relocation has no symbol
   if (X.symInfo() == NULL) {
     if (Y.symInfo() != NULL)
       return true;
   } else if (Y.symInfo() == NULL) {
     return false;
   } else {
-    // 2. compare the symbol index
+    // 3. compare the symbol index
     size_t symIdxX = m_Backend.getSymbolIdx(X.symInfo()->outSymbol());
     size_t symIdxY = m_Backend.getSymbolIdx(Y.symInfo()->outSymbol());
     if (symIdxX < symIdxY)
@@ -2955,19 +3252,19 @@ bool GNULDBackend::RelocCompare::operator()(const Relocation& X,
       return false;
   }
 
-  // 3. compare the relocation address
+  // 4. compare the relocation address
   if (X.place() < Y.place())
     return true;
   if (X.place() > Y.place())
     return false;
 
-  // 4. compare the relocation type
+  // 5. compare the relocation type
   if (X.type() < Y.type())
     return true;
   if (X.type() > Y.type())
     return false;
 
-  // 5. compare the addend
+  // 6. compare the addend
   if (X.addend() < Y.addend())
     return true;
   if (X.addend() > Y.addend())
@@ -840,8 +840,11 @@ Relocator::Result relocGOT(Relocation& pReloc, HexagonRelocator& pParent) {
   // set got entry value if needed
   HexagonGOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
   assert(got_entry != NULL);
-  if (HexagonRelocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    std::lock_guard<std::mutex> lock(pParent.getApplyMutex());
+    if (HexagonRelocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
 
   Relocator::Address GOT_S = helper_get_GOT_address(*pReloc.symInfo(), pParent);
   Relocator::Address GOT = pParent.getTarget().getGOTSymbolAddr();
@@ -69,6 +69,10 @@ class HexagonRelocator : public Relocator {
 
   Result applyRelocation(Relocation& pRelocation);
 
+  /// isConcurrentApplySafe - GOT entries shared by inputs are filled under
+  /// getApplyMutex(), and there is no per-input state while applying.
+  bool isConcurrentApplySafe() const { return true; }
+
   /// scanRelocation - determine the empty entries are needed or not and create
   /// the empty entries if needed.
   /// For Hexagon, following entries are check to create:
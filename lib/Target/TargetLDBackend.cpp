@@ -13,7 +13,7 @@
 namespace mcld {
 
 TargetLDBackend::TargetLDBackend(const LinkerConfig& pConfig)
-    : m_Config(pConfig) {
+    : m_Config(pConfig), m_pStats(NULL) {
 }
 
 TargetLDBackend::~TargetLDBackend() {
@@ -192,6 +192,9 @@ uint64_t X86GNULDBackend::emitSectionData(const LDSection& pSection,
   } else if (FileFormat->hasGOTPLT() &&
              (&pSection == &(FileFormat->getGOTPLT()))) {
     RegionSize += emitGOTPLTSectionData(pRegion, FileFormat);
+  } else if (FileFormat->hasRelrDyn() &&
+             (&pSection == &(FileFormat->getRelrDyn()))) {
+    RegionSize += emitRelrDyn(pRegion);
   } else {
     fatal(diag::unrecognized_output_sectoin) << pSection.name()
                                              << "mclinker@googlegroups.com";
@@ -599,6 +602,8 @@ llvm::StringRef X86_64GNULDBackend::createFDERegionForPLT() {
 
 void X86_64GNULDBackend::setRelDynSize() {
   ELFFileFormat* file_format = getOutputFormat();
+  if (config().options().packRelativeRelocs())
+    packRelativeRelocs(file_format->getRelaDyn());
   file_format->getRelaDyn().setSize(m_pRelDyn->numOfRelocs() *
                                     getRelaEntrySize());
 }
@@ -171,6 +171,10 @@ class X86_32GNULDBackend : public X86GNULDBackend {
 
   const X86_32GOTPLT& getGOTPLT() const;
 
+  uint32_t getRelativeRelocType() const {
+    return llvm::ELF::R_386_RELATIVE;
+  }
+
  private:
   /// initRelocator - create and initialize Relocator.
   bool initRelocator();
@@ -213,6 +217,10 @@ class X86_64GNULDBackend : public X86GNULDBackend {
 
   const X86_64GOTPLT& getGOTPLT() const;
 
+  uint32_t getRelativeRelocType() const {
+    return llvm::ELF::R_X86_64_RELATIVE;
+  }
+
  private:
   /// initRelocator - create and initialize Relocator.
   bool initRelocator();
@@ -128,6 +128,10 @@
   { &unsupported, 35, "R_X86_64_TLSDESC_CALL",    0  }, \
   { &none,        36, "R_X86_64_TLSDESC",         0  }, \
   { &none,        37, "R_X86_64_IRELATIVE",       0  }, \
-  { &none,        38, "R_X86_64_RELATIVE64",      0  }
+  { &none,        38, "R_X86_64_RELATIVE64",      0  }, \
+  { &unsupported, 39, "R_X86_64_PC32_BND",        32 }, \
+  { &unsupported, 40, "R_X86_64_PLT32_BND",       32 }, \
+  { &gotpcrel,    41, "R_X86_64_GOTPCRELX",       32 }, \
+  { &gotpcrel,    42, "R_X86_64_REX_GOTPCRELX",   32 }
 
 #endif  // TARGET_X86_X86RELOCATIONFUNCTIONS_H_
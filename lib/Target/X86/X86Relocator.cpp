@@ -11,6 +11,7 @@
 
 #include "mcld/IRBuilder.h"
 #include "mcld/LinkerConfig.h"
+#include "mcld/Fragment/RegionFragment.h"
 #include "mcld/LD/ELFFileFormat.h"
 #include "mcld/LD/ELFSegmentFactory.h"
 #include "mcld/LD/ELFSegment.h"
@@ -958,8 +959,11 @@ Relocator::Result got32(Relocation& pReloc, X86_32Relocator& pParent) {
   // the dyn rel is RELATIVE
   X86_32GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
   assert(got_entry != NULL);
-  if (got_entry->getValue() == X86Relocator::SymVal)
-    got_entry->setValue(pReloc.symValue());
+  {
+    std::lock_guard<std::mutex> lock(pParent.getApplyMutex());
+    if (got_entry->getValue() == X86Relocator::SymVal)
+      got_entry->setValue(pReloc.symValue());
+  }
 
   Relocator::Address GOT_S = helper_get_GOT_address(pReloc, pParent);
   Relocator::DWord A = pReloc.target() + pReloc.addend();
@@ -999,9 +1003,11 @@ Relocator::Result tls_gd(Relocation& pReloc, X86_32Relocator& pParent) {
   X86_32GOTEntry* got_entry1 = pParent.getSymGOTMap().lookUpFirstEntry(*rsym);
 
   // set the got_entry2 value to symbol value
-  if (rsym->isLocal())
+  if (rsym->isLocal()) {
+    std::lock_guard<std::mutex> lock(pParent.getApplyMutex());
     pParent.getSymGOTMap().lookUpSecondEntry(*rsym)->setValue(
         pReloc.symValue());
+  }
 
   // perform relocation to the first got entry
   Relocator::DWord A = pReloc.target() + pReloc.addend();
@@ -1237,6 +1243,10 @@ X86_64Relocator::X86_64Relocator(X86_64GNULDBackend& pParent,
 Relocator::Result X86_64Relocator::applyRelocation(Relocation& pRelocation) {
   Relocation::Type type = pRelocation.type();
 
+  // the rewritten opcode is already in place
+  if (type == R_X86_64_RELAX_OPT)
+    return none(pRelocation, *this);
+
   if (type >= sizeof(X86_64ApplyFunctions) / sizeof(X86_64ApplyFunctions[0])) {
     return Unknown;
   }
@@ -1246,10 +1256,14 @@ Relocator::Result X86_64Relocator::applyRelocation(Relocation& pRelocation) {
 }
 
 const char* X86_64Relocator::getName(Relocation::Type pType) const {
+  if (pType == R_X86_64_RELAX_OPT)
+    return "R_X86_64_RELAX_OPT";
   return X86_64ApplyFunctions[pType].name;
 }
 
 Relocator::Size X86_64Relocator::getSize(Relocation::Type pType) const {
+  if (pType == R_X86_64_RELAX_OPT)
+    return 32;
   return X86_64ApplyFunctions[pType].size;
 }
 
@@ -1266,6 +1280,8 @@ bool X86_64Relocator::mayHaveFunctionPointerAccess(
     case llvm::ELF::R_X86_64_GOT32:
     case llvm::ELF::R_X86_64_GOTPCREL64:
     case llvm::ELF::R_X86_64_GOTPCREL:
+    case R_X86_64_GOTPCRELX:
+    case R_X86_64_REX_GOTPCRELX:
     case llvm::ELF::R_X86_64_GOTPLT64: {
       possible_funcptr_reloc = true;
       break;
@@ -1336,6 +1352,14 @@ void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
     case llvm::ELF::R_X86_64_PC8:
       return;
 
+    case R_X86_64_GOTPCRELX:
+    case R_X86_64_REX_GOTPCRELX:
+      // a local symbol needs no GOT entry if the instruction can be relaxed
+      if (mayRelaxGOTPCRELX(pReloc)) {
+        relaxGOTPCRELX(pReloc, pSection);
+        return;
+      }
+    // Fall through
     case llvm::ELF::R_X86_64_GOTPCREL:
       // Symbol needs GOT entry, reserve entry in .got
       // return if we already create GOT for this symbol
@@ -1418,6 +1442,15 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
       }
       return;
 
+    case R_X86_64_GOTPCRELX:
+    case R_X86_64_REX_GOTPCRELX:
+      // a non-preemptible symbol needs no GOT entry if the instruction can be
+      // relaxed
+      if (mayRelaxGOTPCRELX(pReloc)) {
+        relaxGOTPCRELX(pReloc, pSection);
+        return;
+      }
+    // Fall through
     case llvm::ELF::R_X86_64_GOTPCREL:
       // Symbol needs GOT entry, reserve entry in .got
       // return if we already create GOT for this symbol
@@ -1499,6 +1532,82 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
   }  // end switch
 }
 
+bool X86_64Relocator::mayRelaxGOTPCRELX(const Relocation& pReloc) const {
+  // the symbol must be defined in an output section of this module and can
+  // not be preempted at run time
+  const ResolveInfo* rsym = pReloc.symInfo();
+  if (!rsym->isDefine() || rsym->isDyn() ||
+      rsym->type() == ResolveInfo::IndirectFunc ||
+      !rsym->outSymbol()->hasFragRef())
+    return false;
+  if (!rsym->isLocal() && getTarget().isSymbolPreemptible(*rsym))
+    return false;
+
+  // the displacement is the last field of the instruction
+  if (pReloc.addend() != static_cast<Relocation::Address>(-4))
+    return false;
+
+  // read the opcode and the ModR/M byte
+  const RegionFragment* frag =
+      llvm::dyn_cast<RegionFragment>(pReloc.targetRef().frag());
+  uint64_t offset = pReloc.targetRef().offset();
+  unsigned prefix = (pReloc.type() == R_X86_64_REX_GOTPCRELX) ? 3 : 2;
+  if (frag == NULL || offset < prefix ||
+      offset + 4 > frag->getRegion().size())
+    return false;
+  const uint8_t* insn =
+      reinterpret_cast<const uint8_t*>(frag->getRegion().data()) + offset -
+      prefix;
+  uint8_t op = insn[prefix - 2];
+  uint8_t modrm = insn[prefix - 1];
+
+  // mov foo@GOTPCREL(%rip), %reg
+  if (op == 0x8b && (modrm & 0xc7) == 0x05)
+    return (prefix == 2) || ((insn[0] & 0xf0) == 0x40);
+
+  // call *foo@GOTPCREL(%rip), jmp *foo@GOTPCREL(%rip)
+  if (prefix == 2 && op == 0xff && (modrm == 0x15 || modrm == 0x25))
+    return true;
+  return false;
+}
+
+/// relax R_X86_64_[REX_]GOTPCRELX
+///   mov foo@GOTPCREL(%rip), %reg  ->  lea foo(%rip), %reg
+///   call *foo@GOTPCREL(%rip)      ->  addr32 call foo
+///   jmp *foo@GOTPCREL(%rip)       ->  nop; jmp foo
+void X86_64Relocator::relaxGOTPCRELX(Relocation& pReloc, LDSection& pSection) {
+  assert(pReloc.targetRef().frag() != NULL);
+
+  // 1. create the new reloc which rewrites the opcode and the ModR/M byte
+  Relocation* reloc =
+      Relocation::Create(R_X86_64_RELAX_OPT,
+                         *FragmentRef::Create(*pReloc.targetRef().frag(),
+                                              pReloc.targetRef().offset() - 2),
+                         0x0);
+  reloc->setSymInfo(pReloc.symInfo());
+
+  // 2. modify the opcodes to the appropriate ones
+  uint8_t* op = (reinterpret_cast<uint8_t*>(&reloc->target()));
+  if (op[0] == 0x8b) {
+    op[0] = 0x8d;
+  } else if (op[1] == 0x15) {
+    op[0] = 0x67;
+    op[1] = 0xe8;
+  } else {
+    assert(op[1] == 0x25);
+    op[0] = 0x90;
+    op[1] = 0xe9;
+  }
+
+  // 3. insert the new reloc "BEFORE" the original reloc, so that the
+  // displacement written by the original one wins.
+  pSection.getRelocData()->getRelocationList().insert(
+      RelocData::iterator(pReloc), reloc);
+
+  // 4. the displacement is the distance to the symbol now
+  pReloc.setType(llvm::ELF::R_X86_64_PC32);
+}
+
 uint32_t X86_64Relocator::getDebugStringOffset(Relocation& pReloc) const {
   if (pReloc.type() != llvm::ELF::R_X86_64_32)
     error(diag::unsupport_reloc_for_debug_string)
@@ -1611,8 +1720,11 @@ Relocator::Result gotpcrel(Relocation& pReloc, X86_64Relocator& pParent) {
 
   // set symbol value of the got entry if needed
   X86_64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
-  if (X86Relocator::SymVal == got_entry->getValue())
-    got_entry->setValue(pReloc.symValue());
+  {
+    std::lock_guard<std::mutex> lock(pParent.getApplyMutex());
+    if (X86Relocator::SymVal == got_entry->getValue())
+      got_entry->setValue(pReloc.symValue());
+  }
 
   // setup relocation addend if needed
   Relocation* dyn_rel = pParent.getRelRelMap().lookUp(pReloc);
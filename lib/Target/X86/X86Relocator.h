@@ -66,6 +66,10 @@ class X86Relocator : public Relocator {
 
   virtual Result applyRelocation(Relocation& pRelocation) = 0;
 
+  /// isConcurrentApplySafe - GOT entries shared by inputs are filled under
+  /// getApplyMutex(), and there is no per-input state while applying.
+  bool isConcurrentApplySafe() const { return true; }
+
   virtual const char* getName(Relocation::Type pType) const = 0;
 
   const SymPLTMap& getSymPLTMap() const { return m_SymPLTMap; }
@@ -187,6 +191,14 @@ class X86_64Relocator : public X86Relocator {
   typedef KeyEntryMap<ResolveInfo, X86_64GOTEntry> SymGOTPLTMap;
   typedef KeyEntryMap<Relocation, Relocation> RelRelMap;
 
+  enum {
+    // LLVM 3.6 does not know the relaxable GOTPCREL relocations yet
+    R_X86_64_GOTPCRELX = 41,
+    R_X86_64_REX_GOTPCRELX = 42,
+    // mcld internal relocation type, kept out of the psABI range
+    R_X86_64_RELAX_OPT = 0xff
+  };
+
  public:
   X86_64Relocator(X86_64GNULDBackend& pParent, const LinkerConfig& pConfig);
 
@@ -232,6 +244,15 @@ class X86_64Relocator : public X86Relocator {
                        Module& pModule,
                        LDSection& pSection);
 
+  /// mayRelaxGOTPCRELX - return true if the GOT load of pReloc, a
+  /// R_X86_64_[REX_]GOTPCRELX, can be replaced by a PC-relative reference to
+  /// the symbol
+  bool mayRelaxGOTPCRELX(const Relocation& pReloc) const;
+
+  /// relaxGOTPCRELX - rewrite the instruction of pReloc to use the symbol
+  /// directly and convert pReloc to R_X86_64_PC32
+  void relaxGOTPCRELX(Relocation& pReloc, LDSection& pSection);
+
  private:
   X86_64GNULDBackend& m_Target;
   SymGOTMap m_SymGOTMap;
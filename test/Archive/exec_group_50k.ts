@@ -0,0 +1,16 @@
+# Benchmark archive member selection on a group of two archives with 50000
+# members in total. The members form one reference chain that alternates
+# between the archives, so every member is included and each inclusion only
+# adds one new undefined symbol. Run lit with --param benchmark=1 to enable
+# the test and with --time-tests to see the time.
+
+# REQUIRES: benchmark
+
+# RUN: rm -rf %t && python %p/gen_chain_archives.py %t 50000
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start -o %t/out \
+# RUN:   %t/main.o --start-group %t/a.a %t/b.a --end-group
+# RUN: readelf -s %t/out | awk '{print $8}' | FileCheck %s
+
+# CHECK-DAG: f0
+# CHECK-DAG: f25000
+# CHECK-DAG: f49999
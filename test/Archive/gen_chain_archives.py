@@ -0,0 +1,136 @@
+#!/usr/bin/env python
+#
+#                     The MCLinker Project
+#
+# This file is distributed under the University of Illinois Open Source
+# License. See LICENSE.TXT for details.
+#
+# Generate a main object and two x86-64 archives whose members form one long
+# reference chain that crosses between the archives:
+#
+#   main.o:  _start -> f0
+#   a.a:     f0 -> f1, f2 -> f3, ...   (even functions)
+#   b.a:     f1 -> f2, f3 -> f4, ...   (odd functions)
+#
+# Linking main.o with --start-group a.a b.a --end-group pulls in every member,
+# one at a time, alternating between the archives. The members are stored in
+# reverse order so that every newly included member references a symbol that
+# is earlier in the archive symbol table.
+#
+# usage: gen_chain_archives.py <output dir> <number of members>
+
+import os
+import struct
+import sys
+
+SHT_PROGBITS = 1
+SHT_SYMTAB = 2
+SHT_STRTAB = 3
+SHF_ALLOC = 0x2
+SHF_EXECINSTR = 0x4
+STB_GLOBAL = 1
+STT_FUNC = 2
+EM_X86_64 = 62
+
+
+def make_object(defined, undefined):
+  """Return an ELF64 relocatable object defining `defined` in .text and
+  referencing the undefined symbol `undefined` (if any)."""
+  text = b'\xc3'
+  shstrtab = b'\0.text\0.symtab\0.strtab\0.shstrtab\0'
+  names = [defined] + ([undefined] if undefined else [])
+  strtab = b'\0'
+  name_offsets = []
+  for name in names:
+    name_offsets.append(len(strtab))
+    strtab += name.encode() + b'\0'
+
+  # null symbol, the defined function and the undefined reference
+  symtab = b'\0' * 24
+  symtab += struct.pack('<IBBHQQ', name_offsets[0], (STB_GLOBAL << 4) | STT_FUNC,
+                        0, 1, 0, len(text))
+  if undefined:
+    symtab += struct.pack('<IBBHQQ', name_offsets[1], STB_GLOBAL << 4, 0, 0,
+                          0, 0)
+
+  body = b''
+  offsets = {}
+  for name, data in (('text', text), ('symtab', symtab), ('strtab', strtab),
+                     ('shstrtab', shstrtab)):
+    while (64 + len(body)) % 8:
+      body += b'\0'
+    offsets[name] = 64 + len(body)
+    body += data
+  while (64 + len(body)) % 8:
+    body += b'\0'
+  shoff = 64 + len(body)
+
+  ehdr = b'\x7fELF' + bytes(bytearray([2, 1, 1, 0])) + b'\0' * 8
+  ehdr += struct.pack('<HHIQQQIHHHHHH', 1, EM_X86_64, 1, 0, 0, shoff, 0, 64,
+                      0, 0, 64, 5, 4)
+
+  def shdr(name, type, flags, offset, size, link, info, align, entsize):
+    return struct.pack('<IIQQQQIIQQ', name, type, flags, 0, offset, size, link,
+                       info, align, entsize)
+
+  shdrs = b'\0' * 64
+  shdrs += shdr(1, SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, offsets['text'],
+                len(text), 0, 0, 1, 0)
+  shdrs += shdr(7, SHT_SYMTAB, 0, offsets['symtab'], len(symtab), 3, 1, 8, 24)
+  shdrs += shdr(15, SHT_STRTAB, 0, offsets['strtab'], len(strtab), 0, 0, 1, 0)
+  shdrs += shdr(23, SHT_STRTAB, 0, offsets['shstrtab'], len(shstrtab), 0, 0, 1,
+                0)
+  return ehdr + body + shdrs
+
+
+def member_header(name, size):
+  return ('%-16s%-12s%-6s%-6s%-8s%-10s`\n' %
+          (name, '0', '0', '0', '644', size)).encode()
+
+
+def write_archive(path, members):
+  """members is a list of (member name, defined symbol, object data)."""
+  # SVR4 symbol table: count, member offsets, then the symbol names
+  names = b''.join(sym.encode() + b'\0' for _, sym, _ in members)
+  symtab_size = 4 + 4 * len(members) + len(names)
+  offset = 8 + 60 + symtab_size + (symtab_size & 1)
+  offsets = []
+  for name, _, data in members:
+    offsets.append(offset)
+    offset += 60 + len(data) + (len(data) & 1)
+
+  with open(path, 'wb') as out:
+    out.write(b'!<arch>\n')
+    out.write(member_header('/', symtab_size))
+    out.write(struct.pack('>I', len(members)))
+    out.write(b''.join(struct.pack('>I', o) for o in offsets))
+    out.write(names)
+    if symtab_size & 1:
+      out.write(b'\n')
+    for name, _, data in members:
+      out.write(member_header(name + '/', len(data)))
+      out.write(data)
+      if len(data) & 1:
+        out.write(b'\n')
+
+
+def main():
+  out_dir = sys.argv[1]
+  num = int(sys.argv[2])
+  if not os.path.isdir(out_dir):
+    os.makedirs(out_dir)
+
+  with open(os.path.join(out_dir, 'main.o'), 'wb') as out:
+    out.write(make_object('_start', 'f0'))
+
+  archives = ([], [])
+  for i in reversed(range(num)):
+    undefined = 'f%d' % (i + 1) if i + 1 < num else None
+    archives[i % 2].append(('m%d.o' % i, 'f%d' % i,
+                            make_object('f%d' % i, undefined)))
+  write_archive(os.path.join(out_dir, 'a.a'), archives[0])
+  write_archive(os.path.join(out_dir, 'b.a'), archives[1])
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,14 @@
+# Check that --threads does not change the output. The inputs are the
+# objects of test/Symbols/X86/LazyDSO, linked with a shared library and an
+# archive, once on one thread and once on several threads.
+
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared -soname=liblazy.so \
+# RUN:   %p/../Symbols/X86/LazyDSO/lib.o -o %t.so
+# RUN: rm -f %t.a && llvm-ar rcs %t.a %p/../Symbols/X86/LazyDSO/member.o
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start --threads=1 \
+# RUN:   %p/../Symbols/X86/LazyDSO/main.o %t.so \
+# RUN:   %p/../Symbols/X86/LazyDSO/later.o %t.a -o %t.1.exe
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start --threads=4 \
+# RUN:   %p/../Symbols/X86/LazyDSO/main.o %t.so \
+# RUN:   %p/../Symbols/X86/LazyDSO/later.o %t.a -o %t.4.exe
+# RUN: cmp %t.1.exe %t.4.exe
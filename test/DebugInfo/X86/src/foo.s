@@ -0,0 +1,15 @@
+# An object of stream_debug_info.ts, assembled with
+#   llvm-mc -g -fdebug-compilation-dir=. -filetype=obj \
+#     -triple=x86_64-linux-gnu src/foo.s -o obj/foo.o
+# -g adds .debug_info, .debug_abbrev, .debug_line and .debug_aranges.
+  .text
+  .globl foo
+  .type foo,@function
+foo:
+  movl $1, %eax
+  ret
+  .size foo, .-foo
+
+  .section .debug_str,"MS",@progbits,1
+  .asciz "foo"
+  .asciz "shared"
@@ -0,0 +1,17 @@
+# An object of stream_debug_info.ts, assembled with
+#   llvm-mc -g -fdebug-compilation-dir=. -filetype=obj \
+#     -triple=x86_64-linux-gnu src/main.s -o obj/main.o
+# -g adds .debug_info, .debug_abbrev, .debug_line and .debug_aranges.
+  .text
+  .globl _start
+  .type _start,@function
+_start:
+  call foo
+  call member
+  movl $60, %eax
+  syscall
+  .size _start, .-_start
+
+  .section .debug_str,"MS",@progbits,1
+  .asciz "main"
+  .asciz "shared"
@@ -0,0 +1,15 @@
+# An object of stream_debug_info.ts, assembled with
+#   llvm-mc -g -fdebug-compilation-dir=. -filetype=obj \
+#     -triple=x86_64-linux-gnu src/member.s -o obj/member.o
+# -g adds .debug_info, .debug_abbrev, .debug_line and .debug_aranges.
+  .text
+  .globl member
+  .type member,@function
+member:
+  movl $2, %eax
+  ret
+  .size member, .-member
+
+  .section .debug_str,"MS",@progbits,1
+  .asciz "member"
+  .asciz "shared"
@@ -0,0 +1,18 @@
+# Check that --stream-debug-info writes the same output as copying the debug
+# sections with the other sections. The sources of the objects are in src/.
+# member.o is linked from an archive, so its debug sections are read through
+# the mapping of the archive.
+
+# RUN: rm -f %t.a && llvm-ar rcs %t.a %p/obj/member.o
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start \
+# RUN:   %p/obj/main.o %p/obj/foo.o %t.a -o %t.exe
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start --stream-debug-info \
+# RUN:   %p/obj/main.o %p/obj/foo.o %t.a -o %t.stream.exe
+# RUN: readelf -S %t.stream.exe | FileCheck %s
+# RUN: cmp %t.exe %t.stream.exe
+
+# CHECK-DAG: .debug_info
+# CHECK-DAG: .debug_abbrev
+# CHECK-DAG: .debug_aranges
+# CHECK-DAG: .debug_line
+# CHECK-DAG: .debug_str
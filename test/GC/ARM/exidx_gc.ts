@@ -0,0 +1,19 @@
+# Check that --gc-sections keeps the sections which .ARM.exidx refers to.
+# The source of exidx_gc.o is src/exidx_gc.s. The exception index of _start
+# refers to its .ARM.extab entry, which refers to my_personality. Nothing
+# else refers to them. The function unused and its index are collected, and
+# so is __aeabi_unwind_cpp_pr0, which only the index of unused refers to.
+
+# RUN: %MCLinker -mtriple=armv7-none-linux-gnueabi -e _start \
+# RUN:   --gc-sections %p/exidx_gc.o -o %t.exe
+# RUN: readelf -S %t.exe | FileCheck %s -check-prefix=SECT
+# RUN: readelf -s %t.exe | FileCheck %s -check-prefix=SYM
+
+# SECT: .ARM.extab
+# SECT: .ARM.exidx
+
+# SYM-NOT: unused
+# SYM-NOT: __aeabi_unwind_cpp_pr0
+# SYM: my_personality
+# SYM-NOT: unused
+# SYM-NOT: __aeabi_unwind_cpp_pr0
@@ -0,0 +1,37 @@
+@ The object of exidx_gc.ts, assembled with
+@   llvm-mc -filetype=obj -triple=armv7-none-linux-gnueabi \
+@     src/exidx_gc.s -o exidx_gc.o
+  .syntax unified
+  .arm
+
+  .section .text._start,"ax",%progbits
+  .globl _start
+  .type _start, %function
+_start:
+  .fnstart
+  .personality my_personality
+  bx lr
+  .handlerdata
+  .word 0
+  .text
+  .fnend
+
+  .section .text.unused,"ax",%progbits
+  .globl unused
+  .type unused, %function
+unused:
+  .fnstart
+  bx lr
+  .fnend
+
+  .section .text.my_personality,"ax",%progbits
+  .globl my_personality
+  .type my_personality, %function
+my_personality:
+  bx lr
+
+  .section .text.__aeabi_unwind_cpp_pr0,"ax",%progbits
+  .globl __aeabi_unwind_cpp_pr0
+  .type __aeabi_unwind_cpp_pr0, %function
+__aeabi_unwind_cpp_pr0:
+  bx lr
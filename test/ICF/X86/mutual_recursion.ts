@@ -0,0 +1,23 @@
+# Check that --icf=all folds identical functions that call each other. The
+# source of mutual_recursion.o is src/mutual_recursion.s.
+
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start --icf=all \
+# RUN:   %p/mutual_recursion.o -o %t.exe
+# RUN: llvm-nm %t.exe | FileCheck %s
+
+# CHECK: [[A:[0-9a-f]+]] T a1
+# CHECK: [[A]] T a2
+# CHECK: [[B:[0-9a-f]+]] T b1
+# CHECK: [[B]] T b2
+# CHECK: [[P:[0-9a-f]+]] T ping
+# CHECK: [[P]] T pong
+
+# a and b have different bodies, so they are not folded together.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start --icf=all \
+# RUN:   --print-icf-sections --verbose=0 %p/mutual_recursion.o \
+# RUN:   -o %t.exe 2>&1 | FileCheck %s --check-prefix=SECTIONS
+
+# SECTIONS: ICF converged after
+# SECTIONS-NOT: `.text.a{{[12]}}' of `{{.*}}' into `.text.b{{[12]}}'
+# SECTIONS-NOT: `.text.b{{[12]}}' of `{{.*}}' into `.text.a{{[12]}}'
+# SECTIONS-NOT: `.text._start'
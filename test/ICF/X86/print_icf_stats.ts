@@ -0,0 +1,12 @@
+# Check that --print-icf-stats prints the number of folded sections and the
+# time spent in each step. Like the other ICF debug output, it is shown at
+# --verbose=0 and above. The source of mutual_recursion.o is
+# src/mutual_recursion.s.
+
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start --icf=all \
+# RUN:   --print-icf-stats --verbose=0 %p/mutual_recursion.o \
+# RUN:   -o %t.exe 2>&1 | FileCheck %s
+
+# CHECK: ICF folded `3' of `{{[0-9]+}}' candidate section(s) in `{{[0-9]+}}' iteration(s).
+# CHECK: ICF time: candidates {{[0-9.]+}} ms, contents {{[0-9.]+}} ms, classes {{[0-9.]+}} ms, folding {{[0-9.]+}} ms.
+
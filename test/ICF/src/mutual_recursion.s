@@ -0,0 +1,71 @@
+# The object of mutual_recursion.ts and print_icf_stats.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-linux-gnu \
+#     src/mutual_recursion.s -o X86/mutual_recursion.o
+#
+# ping and pong call each other and are otherwise identical. a1 and a2, and
+# b1 and b2, are two copies of the same pair of mutually recursive functions.
+# None of them can be folded by looking at one function alone.
+  .section .text._start,"ax",@progbits
+  .globl _start
+  .type _start,@function
+_start:
+  call ping
+  call a1
+  call a2
+  movl $60, %eax
+  syscall
+  .size _start, .-_start
+
+  .section .text.ping,"ax",@progbits
+  .globl ping
+  .type ping,@function
+ping:
+  call pong
+  movl $1, %eax
+  ret
+  .size ping, .-ping
+
+  .section .text.pong,"ax",@progbits
+  .globl pong
+  .type pong,@function
+pong:
+  call ping
+  movl $1, %eax
+  ret
+  .size pong, .-pong
+
+  .section .text.a1,"ax",@progbits
+  .globl a1
+  .type a1,@function
+a1:
+  call b1
+  movl $2, %eax
+  ret
+  .size a1, .-a1
+
+  .section .text.b1,"ax",@progbits
+  .globl b1
+  .type b1,@function
+b1:
+  call a1
+  movl $3, %eax
+  ret
+  .size b1, .-b1
+
+  .section .text.a2,"ax",@progbits
+  .globl a2
+  .type a2,@function
+a2:
+  call b2
+  movl $2, %eax
+  ret
+  .size a2, .-a2
+
+  .section .text.b2,"ax",@progbits
+  .globl b2
+  .type b2,@function
+b2:
+  call a2
+  movl $3, %eax
+  ret
+  .size b2, .-b2
@@ -0,0 +1,40 @@
+# Check that --merge-sections folds the identical strings and constants of
+# the SHF_MERGE sections, and that the relocations into them are fixed up.
+# The sources of a.o and b.o are in src/. a.o refers to its strings and
+# constant through global symbols, b.o through section symbols with addends.
+
+# Without the option, every input keeps its own copy.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start \
+# RUN:   %p/a.o %p/b.o -o %t.nomerge.exe
+# RUN: readelf -p .rodata %t.nomerge.exe | FileCheck %s -check-prefix=NOMERGE
+
+# NOMERGE: ] hello
+# NOMERGE-NEXT: ] xworld
+# NOMERGE-NEXT: ] only_in_a
+# NOMERGE: ] hello
+# NOMERGE-NEXT: ] world
+
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start --merge-sections \
+# RUN:   %p/a.o %p/b.o -o %t.exe
+# RUN: readelf -p .rodata %t.exe | FileCheck %s -check-prefix=STR
+# RUN: llvm-nm %t.exe | FileCheck %s -check-prefix=SYM
+# RUN: readelf -x .data %t.exe | FileCheck %s -check-prefix=DATA
+
+# STR: ] hello
+# STR-NEXT: ] xworld
+# STR-NEXT: ] only_in_a
+# STR-NEXT: ] world
+# STR-NOT: ] hello
+
+# The symbols of both copies point to the kept one.
+# SYM: [[CST:[0-9a-f]+]] {{[A-Za-z]}} cst_a
+# SYM-NEXT: [[CST]] {{[A-Za-z]}} cst_b
+# SYM: [[HELLO:[0-9a-f]+]] {{[A-Za-z]}} str_hello_a
+# SYM-NEXT: [[HELLO]] {{[A-Za-z]}} str_hello_b
+
+# .data holds ptrs_a and then ptrs_b, three pointers each: hello, world and
+# the constant. The pointers of b.o equal those of a.o, except for "world",
+# which is not shared without --tail-merge-strings.
+# DATA: 0x{{[0-9a-f]+}} [[HELLO_LO:[0-9a-f]+]] [[HELLO_HI:[0-9a-f]+]] {{[0-9a-f]+}} {{[0-9a-f]+}}
+# DATA-NEXT: 0x{{[0-9a-f]+}} [[CST_LO:[0-9a-f]+]] [[CST_HI:[0-9a-f]+]] [[HELLO_LO]] [[HELLO_HI]]
+# DATA-NEXT: 0x{{[0-9a-f]+}} {{[0-9a-f]+}} {{[0-9a-f]+}} [[CST_LO]] [[CST_HI]]
@@ -0,0 +1,35 @@
+# An object of merge_sections.ts and tail_merge_strings.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/a.s -o a.o
+  .section .rodata.str1.1,"aMS",@progbits,1
+  .globl str_hello_a
+str_hello_a:
+  .asciz "hello"
+  .globl str_xworld_a
+str_xworld_a:
+  .ascii "x"
+  .globl str_world_a
+str_world_a:
+  .asciz "world"
+
+  .section .rodata.cst8,"aM",@progbits,8
+  .globl cst_a
+cst_a:
+  .quad 0x1122334455667788
+
+  .text
+  .globl _start
+  .type _start, @function
+_start:
+  leaq .Lstr(%rip), %rax
+  ret
+
+  .section .rodata.str1.1,"aMS",@progbits,1
+.Lstr:
+  .asciz "only_in_a"
+
+  .data
+  .globl ptrs_a
+ptrs_a:
+  .quad str_hello_a
+  .quad str_world_a
+  .quad cst_a
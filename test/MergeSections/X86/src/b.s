@@ -0,0 +1,24 @@
+# An object of merge_sections.ts and tail_merge_strings.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/b.s -o b.o
+  .section .rodata.str1.1,"aMS",@progbits,1
+  .globl str_hello_b
+str_hello_b:
+.Lhello:
+  .asciz "hello"
+  .globl str_world_b
+str_world_b:
+.Lworld:
+  .asciz "world"
+
+  .section .rodata.cst8,"aM",@progbits,8
+  .globl cst_b
+cst_b:
+.Lcst:
+  .quad 0x1122334455667788
+
+  .data
+  .globl ptrs_b
+ptrs_b:
+  .quad .Lhello
+  .quad .Lworld
+  .quad .Lcst
@@ -0,0 +1,34 @@
+# Check that --tail-merge-strings places a string which is the tail of
+# another one inside it, and that the relocations into the shared tail are
+# fixed up. The sources of a.o and b.o are in src/. "world" of b.o is the
+# tail of "xworld" of a.o, which also defines str_world_a at that tail.
+
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start --merge-sections \
+# RUN:   --tail-merge-strings %p/a.o %p/b.o -o %t.exe
+# RUN: readelf -p .rodata %t.exe | FileCheck %s -check-prefix=STR
+# RUN: readelf -p .rodata %t.exe | FileCheck %s -check-prefix=ONCE
+# RUN: llvm-nm %t.exe | FileCheck %s -check-prefix=SYM
+# RUN: readelf -x .data %t.exe | FileCheck %s -check-prefix=DATA
+
+# STR-DAG: ] hello
+# STR-DAG: ] xworld
+# STR-DAG: ] only_in_a
+
+# "world" gets no space of its own, and "hello" is kept once.
+# ONCE-NOT: ] world
+# ONCE: ] hello
+# ONCE-NOT: ] world
+# ONCE-NOT: ] hello
+
+# SYM: [[CST:[0-9a-f]+]] {{[A-Za-z]}} cst_a
+# SYM-NEXT: [[CST]] {{[A-Za-z]}} cst_b
+# SYM: [[HELLO:[0-9a-f]+]] {{[A-Za-z]}} str_hello_a
+# SYM-NEXT: [[HELLO]] {{[A-Za-z]}} str_hello_b
+# SYM-NEXT: [[WORLD:[0-9a-f]+]] {{[A-Za-z]}} str_world_a
+# SYM-NEXT: [[WORLD]] {{[A-Za-z]}} str_world_b
+
+# .data holds ptrs_a and then ptrs_b, three pointers each: hello, world and
+# the constant. All the pointers of b.o equal those of a.o.
+# DATA: 0x{{[0-9a-f]+}} [[HELLO_LO:[0-9a-f]+]] [[HELLO_HI:[0-9a-f]+]] [[WORLD_LO:[0-9a-f]+]] [[WORLD_HI:[0-9a-f]+]]
+# DATA-NEXT: 0x{{[0-9a-f]+}} [[CST_LO:[0-9a-f]+]] [[CST_HI:[0-9a-f]+]] [[HELLO_LO]] [[HELLO_HI]]
+# DATA-NEXT: 0x{{[0-9a-f]+}} [[WORLD_LO]] [[WORLD_HI]] [[CST_LO]] [[CST_HI]]
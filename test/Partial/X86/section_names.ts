@@ -0,0 +1,16 @@
+# Check that a relocatable link keeps the names of the input sections. The
+# section map of -r links only has the empty description, so no section is
+# mapped to an output section of the default map. The source of
+# section_names.o is src/section_names.s.
+
+# RUN: %MCLinker -r -mtriple=x86_64-linux-gnu \
+# RUN:   %p/obj/section_names.o -o %t.o
+# RUN: readelf -S %t.o | FileCheck %s
+
+# CHECK: .text.hot.foo
+# CHECK: .text.bar
+# CHECK: .rela.text.bar
+# CHECK: .data.rel.ro.baz
+# CHECK: .rela.data.rel.ro.baz
+# CHECK: .rodata.1
+# CHECK: .mysect
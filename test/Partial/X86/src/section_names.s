@@ -0,0 +1,24 @@
+# The object of section_names.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-linux-gnu \
+#     src/section_names.s -o obj/section_names.o
+  .section .text.hot.foo,"ax",@progbits
+  .globl foo
+foo:
+  ret
+
+  .section .text.bar,"ax",@progbits
+  .globl bar
+bar:
+  call foo
+  ret
+
+  .section .data.rel.ro.baz,"aw",@progbits
+  .globl baz
+baz:
+  .quad foo
+
+  .section .rodata.1,"a",@progbits
+  .byte 1
+
+  .section .mysect,"a",@progbits
+  .byte 2
@@ -0,0 +1,19 @@
+# Check that --direct-relocation writes the same output as applying the
+# relocations before writing. The source of direct.o is src/direct.s. The
+# output has the GOT and the dynamic relocation sections, which are written
+# after the relocations are applied, and .eh_frame_hdr, which is built from
+# the relocated .eh_frame.
+
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared --eh-frame-hdr \
+# RUN:   %p/direct.o -o %t.so
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared --eh-frame-hdr \
+# RUN:   --direct-relocation %p/direct.o -o %t.direct.so
+# RUN: readelf -S %t.direct.so | FileCheck %s
+# RUN: cmp %t.so %t.direct.so
+
+# CHECK: .rela.dyn
+# CHECK: .rela.plt
+# CHECK: .eh_frame_hdr
+# CHECK: .eh_frame
+# CHECK: .got
+# CHECK: .got.plt
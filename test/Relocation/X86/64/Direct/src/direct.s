@@ -0,0 +1,40 @@
+# The object of direct_relocation.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/direct.s \
+#     -o direct.o
+# The functions call through the PLT, load through the GOT and have unwind
+# information, so the output has .got, .got.plt, .rela.dyn, .rela.plt,
+# .eh_frame and .eh_frame_hdr.
+  .text
+  .globl caller
+  .type caller, @function
+caller:
+  .cfi_startproc
+  pushq %rbp
+  .cfi_def_cfa_offset 16
+  call ext_fn@PLT
+  movq ext_var@GOTPCREL(%rip), %rax
+  movq local_var@GOTPCREL(%rip), %rcx
+  popq %rbp
+  .cfi_def_cfa_offset 8
+  ret
+  .cfi_endproc
+  .size caller, .-caller
+
+  .globl other
+  .type other, @function
+other:
+  .cfi_startproc
+  call caller@PLT
+  leaq table(%rip), %rax
+  ret
+  .cfi_endproc
+  .size other, .-other
+
+  .data
+  .p2align 3
+  .globl local_var
+local_var:
+  .quad 1
+table:
+  .quad caller
+  .quad ext_var
@@ -0,0 +1,43 @@
+# Check the relaxation of R_X86_64_GOTPCRELX and R_X86_64_REX_GOTPCRELX.
+# The source of gotpcrelx.o is src/gotpcrelx.s.
+
+# In an executable, the GOT loads of the defined symbols become direct
+# references:
+#   mov foo@GOTPCREL(%rip), %reg  ->  lea foo(%rip), %reg
+#   call *foo@GOTPCREL(%rip)      ->  addr32 call foo
+#   jmp *foo@GOTPCREL(%rip)       ->  nop; jmp foo
+# The loads of the undefined weak symbol are kept.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start \
+# RUN:   %p/gotpcrelx.o -o %t.exe
+# RUN: llvm-objdump -d %t.exe | FileCheck %s -check-prefix=EXE
+
+# EXE: <_start>:
+# EXE-NEXT: 48 8d 05
+# EXE-NEXT: 48 8d 0d
+# EXE-NEXT: 8d 05
+# EXE-NEXT: 67 e8
+# EXE-NEXT: 90 e9
+# EXE-NEXT: 48 8b 15
+# EXE-NEXT: ff 15
+# EXE: <foo>:
+
+# In a shared object, foo may be preempted and keeps its GOT loads. The
+# hidden symbol hid is still relaxed.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared \
+# RUN:   %p/gotpcrelx.o -o %t.so
+# RUN: llvm-objdump -d %t.so | FileCheck %s -check-prefix=DSO
+# RUN: readelf -r %t.so | FileCheck %s -check-prefix=DSOREL
+
+# DSO: <_start>:
+# DSO-NEXT: 48 8b 05
+# DSO-NEXT: 48 8d 0d
+# DSO-NEXT: 8b 05
+# DSO-NEXT: ff 15
+# DSO-NEXT: 90 e9
+# DSO-NEXT: 48 8b 15
+# DSO-NEXT: ff 15
+# DSO: <foo>:
+
+# DSOREL-DAG: R_X86_64_GLOB_DAT {{.*}} foo + 0
+# DSOREL-DAG: R_X86_64_GLOB_DAT {{.*}} und + 0
+# DSOREL-NOT: hid
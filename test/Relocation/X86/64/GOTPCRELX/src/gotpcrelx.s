@@ -0,0 +1,30 @@
+# The object of gotpcrelx.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu -relax-relocations \
+#     src/gotpcrelx.s -o gotpcrelx.o
+  .text
+  .globl _start
+  .type _start, @function
+_start:
+  # R_X86_64_REX_GOTPCRELX
+  movq foo@GOTPCREL(%rip), %rax
+  movq hid@GOTPCREL(%rip), %rcx
+  # R_X86_64_GOTPCRELX
+  movl foo@GOTPCREL(%rip), %eax
+  call *foo@GOTPCREL(%rip)
+  jmp *hid@GOTPCREL(%rip)
+  # undefined symbols are never relaxed
+  movq und@GOTPCREL(%rip), %rdx
+  call *und@GOTPCREL(%rip)
+
+  .globl foo
+  .type foo, @function
+foo:
+  ret
+
+  .globl hid
+  .hidden hid
+  .type hid, @function
+hid:
+  ret
+
+  .weak und
@@ -0,0 +1,47 @@
+# Check -z pack-relative-relocs, which packs the relative relocations into
+# .relr.dyn. The source of relr.o is src/relr.s.
+
+# Without the option, the relative relocations come first in .rela.dyn and
+# DT_RELACOUNT counts them.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared \
+# RUN:   %p/relr.o -o %t.so
+# RUN: readelf -d %t.so | FileCheck %s -check-prefix=DYN
+# RUN: readelf -r %t.so | FileCheck %s -check-prefix=REL
+
+# DYN: (RELACOUNT) 33
+# DYN-NOT: RELR
+
+# REL: contains 34 entries
+# REL-NEXT: Offset
+# REL-NEXT: R_X86_64_RELATIVE
+# REL: R_X86_64_64 {{.*}} ext + 0
+
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared \
+# RUN:   -z pack-relative-relocs %p/relr.o -o %t.relr.so
+# RUN: readelf -d %t.relr.so | FileCheck %s -check-prefix=RELRDYN
+# RUN: readelf -r %t.relr.so | FileCheck %s -check-prefix=RELRREL
+# RUN: readelf -x .relr.dyn -x .data %t.relr.so \
+# RUN:   | FileCheck %s -check-prefix=RELR
+
+# RELRDYN-DAG: (RELR) 0x
+# RELRDYN-DAG: (RELRSZ) 24 (bytes)
+# RELRDYN-DAG: (RELRENT) 8 (bytes)
+# RELRDYN-NOT: RELACOUNT
+
+# RELRREL: '.rela.dyn' at offset {{.*}} contains 1 entry
+# RELRREL-NOT: R_X86_64_RELATIVE
+# RELRREL: R_X86_64_64 {{.*}} ext + 0
+# RELRREL-NOT: R_X86_64_RELATIVE
+
+# .relr.dyn holds the address of ptrs, a bitmap of the next 31 words and the
+# address of the last relative relocation. Every relative relocation of ptrs
+# refers to ptrs itself, and the addend written to its place is the address
+# of ptrs after .relr.dyn has shrunk.
+# RELR: Hex dump of section '.relr.dyn':
+# RELR-NEXT: 0x{{[0-9a-f]+}} [[PTRS_LO:[0-9a-f]+]] [[PTRS_HI:[0-9a-f]+]] ffffffff 00000000
+# RELR-NEXT: 0x{{[0-9a-f]+}} {{[0-9a-f]+}} {{[0-9a-f]+}}
+# RELR: Hex dump of section '.data':
+# RELR-NEXT: 0x{{[0-9a-f]+}} [[PTRS_LO]] [[PTRS_HI]] [[PTRS_LO]] [[PTRS_HI]]
+
+# Packing makes the output smaller.
+# RUN: test `wc -c < %t.relr.so` -lt `wc -c < %t.so`
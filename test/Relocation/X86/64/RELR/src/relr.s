@@ -0,0 +1,16 @@
+# The object of relr.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/relr.s -o relr.o
+  .data
+  .p2align 3
+  .globl ptrs
+  .hidden ptrs
+ptrs:
+  # 32 adjacent relative relocations, which pack into an address and a bitmap
+  .rept 32
+  .quad ptrs
+  .endr
+  .zero 1024
+  # out of the reach of the bitmap, which takes another address
+  .quad ptrs
+  # not a relative relocation
+  .quad ext
@@ -0,0 +1,96 @@
+# Check that --lazy-dso-symbols links the same output as reading the shared
+# libraries in full. The sources of the objects are in src/. The library
+# liblazy.so comes before later.o, whose common symbol and definition it
+# also defines, and before an archive whose member it satisfies.
+
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared -soname=liblazy.so \
+# RUN:   --hash-style=gnu %p/lib.o -o %t.gnu.so
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared -soname=liblazy.so \
+# RUN:   --hash-style=sysv %p/lib.o -o %t.sysv.so
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared -soname=libunused.so \
+# RUN:   %p/unused.o -o %t.unused.so
+# RUN: rm -f %t.a && llvm-ar rcs %t.a %p/member.o
+
+# The libraries are read in full.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start %p/main.o \
+# RUN:   --as-needed %t.gnu.so %t.unused.so --no-as-needed %p/later.o %t.a \
+# RUN:   -o %t.full.exe
+# RUN: readelf -d %t.full.exe | grep NEEDED > %t.full.needed
+# RUN: llvm-nm -D %t.full.exe > %t.full.dynsym
+# RUN: llvm-nm %t.full.exe > %t.full.symtab
+# RUN: FileCheck %s -check-prefix=NEEDED < %t.full.needed
+# RUN: FileCheck %s -check-prefix=DYNSYM < %t.full.dynsym
+# RUN: FileCheck %s -check-prefix=SYMTAB < %t.full.symtab
+
+# NEEDED: [liblazy.so]
+# NEEDED-NOT: [libunused.so]
+
+# The symbols of the executable which the library refers to or defines are
+# exported. The alias data is copied with data_alias.
+# DYNSYM: both_fn
+# DYNSYM: common_sym
+# DYNSYM: [[DATA:[0-9a-f]+]] {{[A-Za-z]}} data
+# DYNSYM-NEXT: [[DATA]] {{[A-Za-z]}} data_alias
+# DYNSYM: func
+# DYNSYM-NOT: lib_only
+# DYNSYM: main_fn
+# DYNSYM-NOT: main_only
+
+# SYMTAB-NOT: member_only
+
+# The library with .gnu.hash is read lazily.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start %p/main.o \
+# RUN:   --as-needed %t.gnu.so %t.unused.so --no-as-needed %p/later.o %t.a \
+# RUN:   --lazy-dso-symbols -o %t.gnu.exe
+# RUN: readelf -d %t.gnu.exe | grep NEEDED > %t.gnu.needed
+# RUN: llvm-nm -D %t.gnu.exe > %t.gnu.dynsym
+# RUN: llvm-nm %t.gnu.exe > %t.gnu.symtab
+# RUN: diff %t.full.needed %t.gnu.needed
+# RUN: diff %t.full.dynsym %t.gnu.dynsym
+# RUN: diff %t.full.symtab %t.gnu.symtab
+
+# The library with .hash only is read lazily.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start %p/main.o \
+# RUN:   --as-needed %t.sysv.so %t.unused.so --no-as-needed %p/later.o %t.a \
+# RUN:   --lazy-dso-symbols -o %t.sysv.exe
+# RUN: readelf -d %t.sysv.exe | grep NEEDED > %t.sysv.needed
+# RUN: llvm-nm -D %t.sysv.exe > %t.sysv.dynsym
+# RUN: llvm-nm %t.sysv.exe > %t.sysv.symtab
+# RUN: diff %t.full.needed %t.sysv.needed
+# RUN: diff %t.full.dynsym %t.sysv.dynsym
+# RUN: diff %t.full.symtab %t.sysv.symtab
+
+# With --export-dynamic, every global symbol of the executable is exported.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start %p/main.o \
+# RUN:   --as-needed %t.gnu.so %t.unused.so --no-as-needed %p/later.o %t.a \
+# RUN:   --export-dynamic -o %t.full.e.exe
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start %p/main.o \
+# RUN:   --as-needed %t.gnu.so %t.unused.so --no-as-needed %p/later.o %t.a \
+# RUN:   --export-dynamic --lazy-dso-symbols -o %t.gnu.e.exe
+# RUN: llvm-nm -D %t.full.e.exe > %t.full.e.dynsym
+# RUN: llvm-nm -D %t.gnu.e.exe > %t.gnu.e.dynsym
+# RUN: FileCheck %s -check-prefix=EXPORT < %t.full.e.dynsym
+# RUN: diff %t.full.e.dynsym %t.gnu.e.dynsym
+
+# EXPORT: main_only
+
+# Both libdup1.so and libdup2.so define dup_fn, which only dupref.o after
+# them refers to. The definition of libdup1.so wins, and libdup2.so, which
+# brings no new symbol, is not needed.
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared -soname=libdup1.so \
+# RUN:   %p/dup1.o -o %t.dup1.so
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared -soname=libdup2.so \
+# RUN:   %p/dup2.o -o %t.dup2.so
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start %p/main.o \
+# RUN:   --as-needed %t.gnu.so %t.dup1.so %t.dup2.so --no-as-needed \
+# RUN:   %p/later.o %p/dupref.o %t.a -o %t.full.dup.exe
+# RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -e _start %p/main.o \
+# RUN:   --as-needed %t.gnu.so %t.dup1.so %t.dup2.so --no-as-needed \
+# RUN:   %p/later.o %p/dupref.o %t.a --lazy-dso-symbols -o %t.gnu.dup.exe
+# RUN: readelf -d %t.full.dup.exe | grep NEEDED > %t.full.dup.needed
+# RUN: readelf -d %t.gnu.dup.exe | grep NEEDED > %t.gnu.dup.needed
+# RUN: FileCheck %s -check-prefix=DUP < %t.full.dup.needed
+# RUN: diff %t.full.dup.needed %t.gnu.dup.needed
+
+# DUP: [libdup1.so]
+# DUP-NOT: [libdup2.so]
@@ -0,0 +1,8 @@
+# An object of lazy_dso_symbols.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/dup1.s -o dup1.o
+# Linked into libdup1.so. Both libdup1.so and libdup2.so define dup_fn.
+  .text
+  .globl dup_fn
+  .type dup_fn, @function
+dup_fn:
+  ret
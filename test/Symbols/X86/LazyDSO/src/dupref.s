@@ -0,0 +1,10 @@
+# An object of lazy_dso_symbols.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/dupref.s -o dupref.o
+# Comes after libdup1.so and libdup2.so on the command line, and is the only
+# input which refers to dup_fn.
+  .text
+  .globl dupref_fn
+  .type dupref_fn, @function
+dupref_fn:
+  call dup_fn@PLT
+  ret
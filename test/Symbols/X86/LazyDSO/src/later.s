@@ -0,0 +1,11 @@
+# An object of lazy_dso_symbols.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/later.s -o later.o
+# Comes after liblazy.so on the command line.
+  .text
+  .globl both_fn
+  .type both_fn, @function
+both_fn:
+  call arch_fn
+  ret
+
+  .comm common_sym, 8, 8
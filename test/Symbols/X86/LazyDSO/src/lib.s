@@ -0,0 +1,47 @@
+# An object of lazy_dso_symbols.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/lib.s -o lib.o
+# Linked into liblazy.so, once with .gnu.hash and once with .hash only.
+  .text
+  .globl func
+  .type func, @function
+func:
+  # refers to the executable, which exports main_fn then
+  call main_fn@PLT
+  ret
+
+  # also defined by later.o, which comes after the library
+  .globl both_fn
+  .type both_fn, @function
+both_fn:
+  ret
+
+  # also defined by the archive member, which is not pulled then
+  .globl arch_fn
+  .type arch_fn, @function
+arch_fn:
+  ret
+
+  # never referenced
+  .globl lib_only
+  .type lib_only, @function
+lib_only:
+  ret
+
+  .data
+  # a weak object and its alias, which are copied together
+  .weak data
+  .type data, @object
+  .size data, 8
+  .globl data_alias
+  .type data_alias, @object
+  .size data_alias, 8
+data:
+data_alias:
+  .quad 1
+
+  # a common symbol of later.o
+  .globl common_sym
+  .type common_sym, @object
+  .size common_sym, 4
+common_sym:
+  .long 2
@@ -0,0 +1,21 @@
+# An object of lazy_dso_symbols.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/main.s -o main.o
+  .text
+  .globl _start
+  .type _start, @function
+_start:
+  call func
+  # copies data_alias, and its alias data with it
+  movq data_alias(%rip), %rax
+  ret
+
+  .globl main_fn
+  .type main_fn, @function
+main_fn:
+  ret
+
+  # exported only with --export-dynamic
+  .globl main_only
+  .type main_only, @function
+main_only:
+  ret
@@ -0,0 +1,13 @@
+# An object of lazy_dso_symbols.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/member.s -o member.o
+# The member of an archive after liblazy.so, which defines arch_fn first.
+  .text
+  .globl arch_fn
+  .type arch_fn, @function
+arch_fn:
+  ret
+
+  .globl member_only
+  .type member_only, @function
+member_only:
+  ret
@@ -0,0 +1,9 @@
+# An object of lazy_dso_symbols.ts, assembled with
+#   llvm-mc -filetype=obj -triple=x86_64-pc-linux-gnu src/unused.s -o unused.o
+# Linked into libunused.so, which brings no new symbol and is not needed
+# with --as-needed.
+  .text
+  .globl func
+  .type func, @function
+func:
+  ret
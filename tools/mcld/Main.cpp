@@ -19,6 +19,7 @@
 #include <mcld/MC/ZOption.h>
 #include <mcld/Support/raw_ostream.h>
 #include <mcld/Support/MsgHandling.h>
+#include <mcld/Support/Parallel.h>
 #include <mcld/Support/Path.h>
 #include <mcld/Support/SystemUtils.h>
 #include <mcld/Support/TargetRegistry.h>
@@ -277,6 +278,27 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
   // --trace
   config_.options().setTrace(args.hasArg(kOpt_Trace));
 
+  // --time-report
+  config_.options().setTimeReport(args.hasArg(kOpt_TimeReport));
+
+  // --stats
+  config_.options().setStats(args.hasArg(kOpt_Stats));
+
+  // --stats-format=[text,json]
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_StatsFormat)) {
+    mcld::GeneralOptions::StatsFormat format =
+        llvm::StringSwitch<mcld::GeneralOptions::StatsFormat>(arg->getValue())
+            .Case("text", mcld::GeneralOptions::StatsFormat::Text)
+            .Case("json", mcld::GeneralOptions::StatsFormat::JSON)
+            .Default(mcld::GeneralOptions::StatsFormat::Unknown);
+    if (format == mcld::GeneralOptions::StatsFormat::Unknown) {
+      mcld::errs() << "Invalid value for" << arg->getOption().getPrefixedName()
+                   << ": " << arg->getValue() << "\n";
+      return false;
+    }
+    config_.options().setStatsFormat(format);
+  }
+
   // --verbose=level
   if (llvm::opt::Arg* arg = args.getLastArg(kOpt_Verbose)) {
     llvm::StringRef value = arg->getValue();
@@ -436,6 +458,10 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
             .Case("lazy", mcld::ZOption(mcld::ZOption::Lazy))
             .Case("now", mcld::ZOption(mcld::ZOption::Now))
             .Case("origin", mcld::ZOption(mcld::ZOption::Origin))
+            .Case("pack-relative-relocs",
+                  mcld::ZOption(mcld::ZOption::PackRelativeRelocs))
+            .Case("nopack-relative-relocs",
+                  mcld::ZOption(mcld::ZOption::NoPackRelativeRelocs))
             .Default(mcld::ZOption());
 
     if (z_opt.kind() == mcld::ZOption::Unknown) {
@@ -563,6 +589,18 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
     }
   }
 
+  // --gnu-hash-load-factor=N
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_GNUHashLoadFactor)) {
+    llvm::StringRef value = arg->getValue();
+    unsigned factor;
+    if (value.getAsInteger(0, factor)) {
+      mcld::errs() << "Invalid value for" << arg->getOption().getPrefixedName()
+                   << ": " << arg->getValue() << "\n";
+      return false;
+    }
+    config_.options().setGNUHashLoadFactor(factor);
+  }
+
   // --[no]-export-dynamic
   if (llvm::opt::Arg* arg = args.getLastArg(kOpt_ExportDynamic,
                                               kOpt_NoExportDynamic)) {
@@ -816,6 +854,79 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
     }
   }
 
+  // --[no-]print-icf-stats
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_PrintICFStats,
+                                              kOpt_NoPrintICFStats)) {
+    if (arg->getOption().matches(kOpt_PrintICFStats)) {
+      config_.options().setPrintICFStats(true);
+    } else {
+      config_.options().setPrintICFStats(false);
+    }
+  }
+
+  // --threads=N
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_Threads)) {
+    llvm::StringRef value = arg->getValue();
+    int num;
+    if (value.getAsInteger(0, num) || (num < 0)) {
+      mcld::errs() << "Invalid value for" << arg->getOption().getPrefixedName()
+                   << ": " << arg->getValue() << "\n";
+      return false;
+    }
+    if (num == 0)
+      num = mcld::parallel::getHardwareConcurrency();
+    config_.options().setNumThreads(num);
+  }
+
+  // --[no-]direct-relocation
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_DirectRelocation,
+                                              kOpt_NoDirectRelocation)) {
+    if (arg->getOption().matches(kOpt_DirectRelocation)) {
+      config_.options().setDirectRelocation(true);
+    } else {
+      config_.options().setDirectRelocation(false);
+    }
+  }
+
+  // --[no-]merge-sections
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_MergeSections,
+                                              kOpt_NoMergeSections)) {
+    if (arg->getOption().matches(kOpt_MergeSections)) {
+      config_.options().setMergeSections(true);
+    } else {
+      config_.options().setMergeSections(false);
+    }
+  }
+
+  // --[no-]tail-merge-strings
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_TailMergeStrings,
+                                              kOpt_NoTailMergeStrings)) {
+    if (arg->getOption().matches(kOpt_TailMergeStrings)) {
+      config_.options().setMergeSections(true);
+      config_.options().setTailMergeStrings(true);
+    } else {
+      config_.options().setTailMergeStrings(false);
+    }
+  }
+
+  // --[no-]stream-debug-info
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_StreamDebugInfo,
+                                              kOpt_NoStreamDebugInfo)) {
+    if (arg->getOption().matches(kOpt_StreamDebugInfo))
+      config_.options().setStreamDebugInfo(true);
+    else
+      config_.options().setStreamDebugInfo(false);
+  }
+
+  // --[no-]lazy-dso-symbols
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_LazyDSOSymbols,
+                                              kOpt_NoLazyDSOSymbols)) {
+    if (arg->getOption().matches(kOpt_LazyDSOSymbols))
+      config_.options().setLazyDSOSymbols(true);
+    else
+      config_.options().setLazyDSOSymbols(false);
+  }
+
   //===--------------------------------------------------------------------===//
   // Positional
   //===--------------------------------------------------------------------===//
@@ -0,0 +1,212 @@
+//===- FlatHashTableTest.cpp ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "FlatHashTableTest.h"
+#include "mcld/ADT/FlatHashTable.h"
+#include "mcld/ADT/HashTable.h"
+#include "mcld/ADT/StringHash.h"
+#include "mcld/LD/ResolveInfo.h"
+#include <llvm/ADT/StringRef.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+FlatHashTableTest::FlatHashTableTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+FlatHashTableTest::~FlatHashTableTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void FlatHashTableTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void FlatHashTableTest::TearDown() {
+}
+
+//==========================================================================//
+// Testcases
+//
+typedef FlatHashTable<ResolveInfo, hash::StringHash<hash::WY> > FlatTableTy;
+typedef HashTable<ResolveInfo, hash::StringHash<hash::DJB> > OldTableTy;
+
+// mangled names share long prefixes, just like the symbols of a real link.
+static void makeNames(std::vector<std::string>& pNames,
+                      unsigned pNum,
+                      const char* pPrefix) {
+  char buf[128];
+  pNames.reserve(pNum);
+  for (unsigned i = 0; i < pNum; ++i) {
+    std::snprintf(buf, sizeof(buf), "_ZN4mcld%s%uEPKcRNS_11ResolveInfoE",
+                  pPrefix, i);
+    pNames.push_back(buf);
+  }
+}
+
+TEST_F(FlatHashTableTest, constructor) {
+  FlatTableTy table(16);
+  EXPECT_TRUE(16 == table.numOfBuckets());
+  EXPECT_TRUE(table.empty());
+  EXPECT_TRUE(0 == table.numOfEntries());
+  EXPECT_TRUE(table.begin() == table.end());
+
+  // the number of buckets is a power of two, and at least one group.
+  FlatTableTy small(3);
+  EXPECT_TRUE(16 == small.numOfBuckets());
+  FlatTableTy large(1000);
+  EXPECT_TRUE(1024 == large.numOfBuckets());
+}
+
+TEST_F(FlatHashTableTest, insert_and_find) {
+  FlatTableTy table(16);
+
+  bool exist;
+  ResolveInfo* info = table.insert("foo", exist);
+  EXPECT_FALSE(exist);
+  EXPECT_STREQ("foo", info->name());
+
+  ResolveInfo* again = table.insert("foo", exist);
+  EXPECT_TRUE(exist);
+  EXPECT_TRUE(info == again);
+  EXPECT_TRUE(1 == table.numOfEntries());
+
+  EXPECT_TRUE(info == table.find("foo").getEntry());
+  EXPECT_TRUE(table.find("bar") == table.end());
+  EXPECT_TRUE(NULL == table.find("bar").getEntry());
+  EXPECT_TRUE(1 == table.count("foo"));
+  EXPECT_TRUE(0 == table.count("fo"));
+}
+
+TEST_F(FlatHashTableTest, grow) {
+  std::vector<std::string> names;
+  makeNames(names, 10000, "grow");
+
+  FlatTableTy table(16);
+  std::vector<ResolveInfo*> infos;
+  bool exist;
+  for (unsigned i = 0; i < names.size(); ++i) {
+    infos.push_back(table.insert(names[i], exist));
+    EXPECT_FALSE(exist);
+  }
+  EXPECT_TRUE(names.size() == table.numOfEntries());
+  EXPECT_TRUE(table.numOfEntries() * 8 <= table.numOfBuckets() * 7);
+
+  // entries do not move when the table grows
+  for (unsigned i = 0; i < names.size(); ++i)
+    EXPECT_TRUE(infos[i] == table.find(names[i]).getEntry());
+
+  unsigned count = 0;
+  FlatTableTy::iterator entry, eEnd = table.end();
+  for (entry = table.begin(); entry != eEnd; ++entry)
+    ++count;
+  EXPECT_TRUE(names.size() == count);
+}
+
+TEST_F(FlatHashTableTest, rehash) {
+  FlatTableTy table(16);
+  table.rehash(1000);
+  EXPECT_TRUE(1000 * 8 <= table.numOfBuckets() * 7);
+
+  size_t buckets = table.numOfBuckets();
+  bool exist;
+  std::vector<std::string> names;
+  makeNames(names, 1000, "rehash");
+  for (unsigned i = 0; i < names.size(); ++i)
+    table.insert(names[i], exist);
+  EXPECT_TRUE(buckets == table.numOfBuckets());
+}
+
+//==========================================================================//
+// Microbenchmarks
+//
+// Not correctness tests. They print how long NamePool-like workloads take
+// with the old HashTable<ResolveInfo, DJB> and with FlatHashTable<ResolveInfo,
+// WY>: inserting every name, looking up every inserted name, and looking up
+// names that are not in the table. They are disabled, run them with
+// --gtest_also_run_disabled_tests.
+//
+typedef std::chrono::steady_clock Clock;
+
+static double elapsed(Clock::time_point pStart) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - pStart)
+      .count();
+}
+
+template <typename TableTy>
+static void benchTable(const char* pName,
+                       const std::vector<std::string>& pHits,
+                       const std::vector<std::string>& pMisses) {
+  TableTy table(1024);
+  bool exist;
+
+  Clock::time_point start = Clock::now();
+  for (unsigned i = 0; i < pHits.size(); ++i)
+    table.insert(pHits[i], exist);
+  double insert_ms = elapsed(start);
+
+  unsigned found = 0;
+  start = Clock::now();
+  for (unsigned i = 0; i < pHits.size(); ++i)
+    found += (table.find(pHits[i]) != table.end());
+  double hit_ms = elapsed(start);
+
+  start = Clock::now();
+  for (unsigned i = 0; i < pMisses.size(); ++i)
+    found += (table.find(pMisses[i]) != table.end());
+  double miss_ms = elapsed(start);
+
+  EXPECT_TRUE(pHits.size() == found);
+  std::printf("%-14s %8zu names: insert %8.2f ms, hit %8.2f ms, "
+              "miss %8.2f ms\n",
+              pName, pHits.size(), insert_ms, hit_ms, miss_ms);
+}
+
+template <uint32_t TYPE>
+static void benchHash(const char* pName,
+                      const std::vector<std::string>& pNames) {
+  hash::StringHash<TYPE> hasher;
+  uint32_t sink = 0;
+  Clock::time_point start = Clock::now();
+  for (unsigned round = 0; round < 10; ++round) {
+    for (unsigned i = 0; i < pNames.size(); ++i)
+      sink += hasher(pNames[i]);
+  }
+  std::printf("%-14s %8zu names x 10: %8.2f ms (%08x)\n",
+              pName, pNames.size(), elapsed(start), sink);
+}
+
+TEST_F(FlatHashTableTest, DISABLED_bench_hash) {
+  std::vector<std::string> names;
+  makeNames(names, 200000, "hash");
+  benchHash<hash::DJB>("DJB", names);
+  benchHash<hash::WY>("WY", names);
+}
+
+TEST_F(FlatHashTableTest, DISABLED_bench_10k) {
+  std::vector<std::string> hits, misses;
+  makeNames(hits, 10000, "hit");
+  makeNames(misses, 10000, "miss");
+  benchTable<OldTableTy>("HashTable", hits, misses);
+  benchTable<FlatTableTy>("FlatHashTable", hits, misses);
+}
+
+TEST_F(FlatHashTableTest, DISABLED_bench_1m) {
+  std::vector<std::string> hits, misses;
+  makeNames(hits, 1000000, "hit");
+  makeNames(misses, 1000000, "miss");
+  benchTable<OldTableTy>("HashTable", hits, misses);
+  benchTable<FlatTableTy>("FlatHashTable", hits, misses);
+}
@@ -0,0 +1,39 @@
+//===- FlatHashTableTest.h ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef MCLD_FLAT_HASH_TABLE_TEST_H
+#define MCLD_FLAT_HASH_TABLE_TEST_H
+
+#include <gtest.h>
+
+namespace mcldtest {
+
+/** \class FlatHashTableTest
+ *  \brief Testcase for FlatHashTable
+ *
+ *  \see FlatHashTable
+ */
+class FlatHashTableTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  FlatHashTableTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~FlatHashTableTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+}  // namespace of mcldtest
+
+#endif
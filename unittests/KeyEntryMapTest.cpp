@@ -0,0 +1,182 @@
+//===- KeyEntryMapTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "KeyEntryMapTest.h"
+#include "mcld/Target/KeyEntryMap.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+KeyEntryMapTest::KeyEntryMapTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+KeyEntryMapTest::~KeyEntryMapTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void KeyEntryMapTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void KeyEntryMapTest::TearDown() {
+}
+
+//==========================================================================//
+// Testcases
+//
+namespace {
+
+struct Symbol {
+  unsigned id;
+};
+
+struct GOTEntry {
+  unsigned id;
+};
+
+}  // anonymous namespace
+
+typedef KeyEntryMap<Symbol, GOTEntry> SymGOTMap;
+
+TEST_F(KeyEntryMapTest, record_and_lookUp) {
+  Symbol syms[3] = {{0}, {1}, {2}};
+  GOTEntry entries[3] = {{0}, {1}, {2}};
+
+  SymGOTMap map;
+  EXPECT_TRUE(map.empty());
+  map.record(syms[2], entries[2]);
+  map.record(syms[0], entries[0]);
+
+  EXPECT_TRUE(2 == map.size());
+  EXPECT_TRUE(&entries[2] == map.lookUp(syms[2]));
+  EXPECT_TRUE(&entries[0] == map.lookUp(syms[0]));
+  EXPECT_TRUE(NULL == map.lookUp(syms[1]));
+
+  const SymGOTMap& const_map = map;
+  EXPECT_TRUE(&entries[0] == const_map.lookUp(syms[0]));
+  EXPECT_TRUE(NULL == const_map.lookUp(syms[1]));
+}
+
+TEST_F(KeyEntryMapTest, first_mapping_wins) {
+  Symbol sym = {0};
+  GOTEntry first = {1}, second = {2};
+
+  SymGOTMap map;
+  map.record(sym, first);
+  map.record(sym, second);
+  EXPECT_TRUE(2 == map.size());
+  EXPECT_TRUE(&first == map.lookUp(sym));
+}
+
+TEST_F(KeyEntryMapTest, pairs) {
+  Symbol syms[2] = {{0}, {1}};
+  GOTEntry entries[4] = {{0}, {1}, {2}, {3}};
+
+  SymGOTMap map;
+  map.record(syms[0], entries[0], entries[1]);
+  map.record(syms[1], entries[2], entries[3]);
+  EXPECT_TRUE(&entries[0] == map.lookUpFirstEntry(syms[0]));
+  EXPECT_TRUE(&entries[1] == map.lookUpSecondEntry(syms[0]));
+  EXPECT_TRUE(&entries[2] == map.lookUpFirstEntry(syms[1]));
+  EXPECT_TRUE(&entries[3] == map.lookUpSecondEntry(syms[1]));
+
+  Symbol other = {2};
+  EXPECT_TRUE(NULL == map.lookUpFirstEntry(other));
+  EXPECT_TRUE(NULL == map.lookUpSecondEntry(other));
+}
+
+TEST_F(KeyEntryMapTest, insertion_order) {
+  std::vector<Symbol> syms(100);
+  std::vector<GOTEntry> entries(100);
+  SymGOTMap map;
+  // record in the reverse order of the addresses of the keys
+  for (unsigned i = 0; i < syms.size(); ++i) {
+    unsigned idx = syms.size() - 1 - i;
+    syms[idx].id = idx;
+    entries[idx].id = idx;
+    map.record(syms[idx], entries[idx]);
+  }
+
+  unsigned idx = syms.size();
+  SymGOTMap::const_iterator mapping, mEnd = map.end();
+  for (mapping = map.begin(); mapping != mEnd; ++mapping) {
+    --idx;
+    EXPECT_TRUE(&syms[idx] == mapping->key);
+    EXPECT_TRUE(&entries[idx] == mapping->entry.entry_ptr);
+  }
+  EXPECT_TRUE(0 == idx);
+}
+
+TEST_F(KeyEntryMapTest, multiple_entries) {
+  Symbol syms[2] = {{0}, {1}};
+  GOTEntry entries[4] = {{0}, {1}, {2}, {3}};
+
+  SymGOTMap map;
+  map.record(syms[0], entries[0]);
+  map.record(syms[1], entries[1]);
+  map.record(syms[0], entries[2]);
+  map.record(syms[1], entries[3]);
+  EXPECT_TRUE(4 == map.size());
+  EXPECT_TRUE(&entries[0] == map.lookUp(syms[0]));
+  EXPECT_TRUE(&entries[1] == map.lookUp(syms[1]));
+
+  // every mapping is kept in the recorded order
+  unsigned idx = 0;
+  SymGOTMap::const_iterator mapping, mEnd = map.end();
+  for (mapping = map.begin(); mapping != mEnd; ++mapping, ++idx) {
+    EXPECT_TRUE(&syms[idx % 2] == mapping->key);
+    EXPECT_TRUE(&entries[idx] == mapping->entry.entry_ptr);
+  }
+  EXPECT_TRUE(4 == idx);
+}
+
+//==========================================================================//
+// Microbenchmark
+//
+// Not a correctness test. It prints how long it takes to record 100k GOT
+// entries and to look each of them up once for every relocation, as
+// helper_get_GOT_address does when a large shared object is linked. It is
+// disabled, run it with --gtest_also_run_disabled_tests.
+//
+TEST_F(KeyEntryMapTest, DISABLED_bench_100k_got) {
+  typedef std::chrono::steady_clock Clock;
+  const unsigned num_entries = 100000;
+  const unsigned relocs_per_entry = 4;
+
+  std::vector<Symbol> syms(num_entries);
+  std::vector<GOTEntry> entries(num_entries);
+
+  Clock::time_point start = Clock::now();
+  SymGOTMap map;
+  map.reserve(num_entries);
+  for (unsigned i = 0; i < num_entries; ++i)
+    map.record(syms[i], entries[i]);
+  double record_ms =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  unsigned found = 0;
+  start = Clock::now();
+  for (unsigned round = 0; round < relocs_per_entry; ++round) {
+    for (unsigned i = 0; i < num_entries; ++i)
+      found += (map.lookUp(syms[(i * 7919u) % num_entries]) != NULL);
+  }
+  double lookup_ms =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  EXPECT_TRUE(num_entries * relocs_per_entry == found);
+  std::printf("KeyEntryMap %u GOT entries: record %8.2f ms, "
+              "%u look-ups %8.2f ms\n",
+              num_entries, record_ms, num_entries * relocs_per_entry,
+              lookup_ms);
+}
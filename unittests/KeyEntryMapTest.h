@@ -0,0 +1,39 @@
+//===- KeyEntryMapTest.h ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef MCLD_KEY_ENTRY_MAP_TEST_H
+#define MCLD_KEY_ENTRY_MAP_TEST_H
+
+#include <gtest.h>
+
+namespace mcldtest {
+
+/** \class KeyEntryMapTest
+ *  \brief Testcase and microbenchmark for KeyEntryMap
+ *
+ *  \see KeyEntryMap
+ */
+class KeyEntryMapTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  KeyEntryMapTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~KeyEntryMapTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,130 @@
+//===- SectionMatcherTest.cpp ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "SectionMatcherTest.h"
+#include "mcld/Object/SectionMap.h"
+#include "mcld/Object/SectionMatcher.h"
+#include "mcld/Script/StringList.h"
+#include "mcld/Script/WildcardPattern.h"
+
+#include <llvm/Support/Casting.h>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+SectionMatcherTest::SectionMatcherTest() : m_pMap(NULL) {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SectionMatcherTest::~SectionMatcherTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void SectionMatcherTest::SetUp() {
+  m_pMap = new SectionMap();
+  m_pMap->insert(".text.unlikely", ".text.unlikely");
+  m_pMap->insert(".text.hot*", ".text.hot");
+  m_pMap->insert(".text*", ".text");
+  m_pMap->insert(".data.rel.ro", ".data.rel.ro");
+  m_pMap->insert(".data*", ".data");
+  m_pMap->insert(".rodata.[0-9]*", ".rodata.num");
+  m_pMap->insert(".rodata.?", ".rodata.one");
+  m_pMap->insert(".rodata*", ".rodata");
+}
+
+// TearDown() will be called immediately after each test.
+void SectionMatcherTest::TearDown() {
+  delete m_pMap;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+static const char* output(const SectionMap::mapping& pMapping) {
+  if (pMapping.first == NULL)
+    return "";
+  return pMapping.first->name().c_str();
+}
+
+// the first description whose sections match pName, tried one by one
+static SectionMap::mapping linearFind(SectionMap& pMap,
+                                      const std::string& pName) {
+  SectionMap::iterator out, outEnd = pMap.end();
+  for (out = pMap.begin(); out != outEnd; ++out) {
+    SectionMap::Output::iterator in, inEnd = (*out)->end();
+    for (in = (*out)->begin(); in != inEnd; ++in) {
+      const StringList& sections = (*in)->spec().sections();
+      StringList::const_iterator sect, sectEnd = sections.end();
+      for (sect = sections.begin(); sect != sectEnd; ++sect) {
+        if (SectionMap::matched(llvm::cast<WildcardPattern>(**sect), pName))
+          return std::make_pair(*out, *in);
+      }
+    }
+  }
+  return std::make_pair(static_cast<SectionMap::Output*>(NULL),
+                        static_cast<SectionMap::Input*>(NULL));
+}
+
+TEST_F(SectionMatcherTest, exact_and_prefix) {
+  SectionMatcher matcher(*m_pMap);
+  EXPECT_STREQ(".text.unlikely", output(matcher.find("a.o", ".text.unlikely")));
+  EXPECT_STREQ(".text.hot", output(matcher.find("a.o", ".text.hot.foo")));
+  EXPECT_STREQ(".text", output(matcher.find("a.o", ".text.foo")));
+  EXPECT_STREQ(".text", output(matcher.find("a.o", ".text")));
+  EXPECT_STREQ(".data.rel.ro", output(matcher.find("a.o", ".data.rel.ro")));
+  EXPECT_STREQ(".data", output(matcher.find("a.o", ".data.rel.ro.x")));
+  EXPECT_STREQ("", output(matcher.find("a.o", ".bss")));
+}
+
+TEST_F(SectionMatcherTest, first_match_wins) {
+  SectionMatcher matcher(*m_pMap);
+  // the prefix pattern `.text*' is after `.text.hot*'
+  EXPECT_STREQ(".text.hot", output(matcher.find("a.o", ".text.hot")));
+  // `.rodata.[0-9]*' is a literal prefix, as in SectionMap::matched
+  EXPECT_STREQ(".rodata.one", output(matcher.find("a.o", ".rodata.1")));
+  EXPECT_STREQ(".rodata.num", output(matcher.find("a.o", ".rodata.[0-9]")));
+  EXPECT_STREQ(".rodata", output(matcher.find("a.o", ".rodata.12")));
+}
+
+TEST_F(SectionMatcherTest, cached_lookup) {
+  SectionMatcher matcher(*m_pMap);
+  SectionMap::mapping first = matcher.find("a.o", ".text.foo");
+  SectionMap::mapping second = matcher.find("b.o", ".text.foo");
+  SectionMap::mapping third = matcher.find("a.o", ".text.foo");
+  EXPECT_TRUE(first == second);
+  EXPECT_TRUE(first == third);
+}
+
+TEST_F(SectionMatcherTest, same_as_linear_search) {
+  const char* names[] = {".text", ".text.hot", ".text.hotter", ".textual",
+                         ".data", ".data.rel.ro", ".data.rel", ".rodata.x",
+                         ".rodata.xy", ".rodata", ".comment", ""};
+  SectionMatcher matcher(*m_pMap);
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+    SectionMap::mapping expected = linearFind(*m_pMap, names[i]);
+    EXPECT_TRUE(expected == matcher.find("a.o", names[i]));
+  }
+}
+
+TEST_F(SectionMatcherTest, empty_pattern) {
+  // the map of -r and linker script links has an empty description
+  SectionMap map;
+  map.insert("", "");
+  map.insert(".text*", ".text");
+  SectionMatcher matcher(map);
+  EXPECT_STREQ(".text", output(matcher.find("a.o", ".text.foo")));
+  EXPECT_TRUE(linearFind(map, "") == matcher.find("a.o", ""));
+  EXPECT_TRUE(linearFind(map, ".data") == matcher.find("a.o", ".data"));
+}
+
+TEST_F(SectionMatcherTest, insert_invalidates) {
+  EXPECT_STREQ("", output(m_pMap->find("a.o", ".bss")));
+  m_pMap->insert(".bss", ".bss");
+  EXPECT_STREQ(".bss", output(m_pMap->find("a.o", ".bss")));
+}
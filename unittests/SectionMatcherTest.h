@@ -0,0 +1,45 @@
+//===- SectionMatcherTest.h -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SECTION_MATCHER_TEST_H
+#define MCLD_SECTION_MATCHER_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+class SectionMap;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class SectionMatcherTest
+ *  \brief Testcase for SectionMatcher
+ *
+ *  \see SectionMatcher
+ */
+class SectionMatcherTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  SectionMatcherTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~SectionMatcherTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::SectionMap* m_pMap;
+};
+
+}  // namespace of mcldtest
+
+#endif